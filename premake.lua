@@ -33,7 +33,7 @@ project "square-run"
         kind "ConsoleApp"
         
         libdirs { "libs/irrklang/bin", "libs/freetype/bin/debug", "libs/glfw/bin/debug" }
-        defines { "_DEBUG" }
+        defines { "_DEBUG", "_COUNT_ALLOCATIONS" }
         symbols "On"
 
     filter "configurations:release"
@@ -54,3 +54,44 @@ project "square-run"
             "copy ..\\libs\\irrklang\\bin\\ikpMP3.dll ..\\bin\\release\\ikpMP3.dll" }
 
 ------------------------------------------------------------------------------------------------------------------------------------------------
+
+project "square-run-bench"
+    location "square-run"
+    kind "ConsoleApp"
+    staticruntime "on"
+    language "C++"
+    cppdialect "C++17"
+
+    targetname "square-run-bench"
+    targetdir "bin/%{cfg.buildcfg}/"
+    objdir "objs/%{prj.name}/%{cfg.buildcfg}/"
+
+    includedirs { "square-run/src", "square-run/bench", "libs/glm", "libs/json/include", "libs/irrklang/include" }
+
+    -- The benchmarks only pull in the engine sources they measure, so no window, OpenGL context or audio device is needed
+    -- The voice pool plays on a sound engine of the benchmark's own, so only irrKlang's headers are used
+    files { "square-run/bench/**.h", "square-run/bench/**.cpp", "square-run/src/core/collision_detection.cpp", 
+        "square-run/src/core/collider_batch.cpp", "square-run/src/core/aabb_tree.cpp", 
+        "square-run/src/core/sweep_and_prune.cpp", "square-run/src/core/collision_world.cpp", 
+        "square-run/src/util/allocation_counter.cpp", "square-run/src/util/simd.cpp", "square-run/src/core/particle_system.cpp", 
+        "square-run/src/core/chunk_streamer.cpp", "square-run/src/graphics/orthogonal_camera.cpp", 
+        "square-run/src/core/voice_pool.cpp", "square-run/src/util/linear_allocator.cpp" }
+
+    -- The allocations made by every benchmark are counted, which replaces the global operator new
+    defines "_COUNT_ALLOCATIONS"
+
+    filter "system:windows"
+        defines "_PLATFORM_WINDOWS"
+
+    filter "system:macosx"
+        defines "_PLATFORM_MACOSX"
+
+    filter "configurations:debug"
+        defines { "_DEBUG" }
+        symbols "On"
+
+    filter "configurations:release"
+        defines { "NDEBUG" }
+        optimize "Speed"
+
+------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,12 @@
+#include <util/directory_system.h>
+
+// The engine's requisites directory is the game's install directory in release builds, which the benchmarks don't need to be ran
+// from, so the benchmarks load everything relative to the working directory.
+
+namespace Util
+{
+	std::string GetGameRequisitesDirectory()
+	{
+		return std::string();
+	}
+}
@@ -0,0 +1,32 @@
+#include <util/logging_system.h>
+
+#include <iostream>
+#include <cstdlib>
+
+// The engine's log system depends on the window clock and the game's data directory, neither of which the benchmarks have, so the 
+// benchmarks have their own which only outputs to the console.
+
+LogSystem::LogSystem() {}
+
+void LogSystem::OutputLog(const std::string_view& msg, Severity severity) const
+{
+	switch (severity)
+	{
+	case Severity::INFO:
+		std::cout << "Info: " << msg << std::endl;
+		break;
+	case Severity::WARNING:
+		std::cout << "Warning: " << msg << std::endl;
+		break;
+	case Severity::FATAL:
+		std::cout << "Error: " << msg << std::endl;
+		std::exit(-1);
+		break;
+	}
+}
+
+LogSystem& LogSystem::GetInstance()
+{
+	static LogSystem instance;
+	return instance;
+}
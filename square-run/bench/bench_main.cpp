@@ -0,0 +1,54 @@
+#include <benchmarks.h>
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+namespace BenchGlobals
+{
+	constexpr char defaultOutputPath[] = "bench_results.json";
+	constexpr double defaultThreshold = 10.0; // In percent
+}
+
+int main(int argc, char** argv)
+{
+	// Usage: square-run-bench [--filter <text>] [--output <results.json>] [--compare <baseline.json>] [--threshold <percent>]
+	std::string filter, outputPath = BenchGlobals::defaultOutputPath, baselinePath;
+	double threshold = BenchGlobals::defaultThreshold;
+
+	for (int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		const std::string argument = argv[argIndex];
+		const bool hasValue = argIndex + 1 < argc;
+
+		if (argument == "--filter" && hasValue)
+			filter = argv[++argIndex];
+		else if (argument == "--output" && hasValue)
+			outputPath = argv[++argIndex];
+		else if (argument == "--compare" && hasValue)
+			baselinePath = argv[++argIndex];
+		else if (argument == "--threshold" && hasValue)
+			threshold = std::strtod(argv[++argIndex], nullptr);
+		else
+			std::cout << "Ignoring unknown option: " << argument << "\n";
+	}
+
+	BenchmarkSuite suite(filter);
+	std::cout << "Running benchmarks\n";
+
+	RunColliderBatchBenchmark(suite);
+	RunCollisionBenchmark(suite);
+	RunParticleBenchmark(suite);
+	RunChunkStreamingBenchmark(suite);
+	RunVoicePoolBenchmark(suite);
+
+	suite.OutputResults();
+	suite.WriteResults(outputPath);
+
+	// The exit code is non-zero if a benchmark produced wrong results or regressed, so it can gate a build script
+	bool passed = suite.AreResultsValid();
+	if (!baselinePath.empty())
+		passed &= suite.CompareResults(baselinePath, threshold / 100.0);
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+#include <benchmark_suite.h>
+
+#include <util/allocation_counter.h>
+#include <nlohmann/json.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+namespace BenchmarkSuiteGlobals
+{
+	constexpr int numRuns = 3;
+}
+
+BenchmarkSuite::BenchmarkSuite(const std::string_view& filter) :
+	filter(filter), throughputUnit("pairs")
+{}
+
+bool BenchmarkSuite::IsEnabled(const std::string_view& name) const
+{
+	return this->filter.empty() || name.find(this->filter) != std::string_view::npos;
+}
+
+void BenchmarkSuite::SetThroughputUnit(const std::string_view& unit)
+{
+	this->throughputUnit = unit;
+}
+
+BenchmarkResult& BenchmarkSuite::Measure(const std::string_view& name, size_t numOps, double itemsPerOp, 
+	const std::function<void()>& func, const std::function<void()>& setupFunc)
+{
+	BenchmarkResult result;
+	result.name = name;
+	result.unit = this->throughputUnit;
+
+	double fastestSeconds = 0.0;
+	for (int runIndex = 0; runIndex < BenchmarkSuiteGlobals::numRuns; runIndex++)
+	{
+		if (setupFunc)
+			setupFunc();
+
+		const uint64_t startAllocations = Util::GetAllocationCount();
+		const auto startTime = std::chrono::steady_clock::now();
+
+		func();
+
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		const uint64_t allocations = Util::GetAllocationCount() - startAllocations;
+
+		if (runIndex == 0 || seconds < fastestSeconds)
+		{
+			fastestSeconds = seconds;
+			result.allocations = allocations;
+		}
+	}
+
+	const double numOpsRan = (double)std::max<size_t>(numOps, 1);
+	result.nsPerOp = fastestSeconds * 1e9 / numOpsRan;
+	result.itemsPerSecond = fastestSeconds > 0.0 ? (itemsPerOp * numOpsRan) / fastestSeconds : 0.0;
+
+	std::cout << "  " << result.name << "\n";
+	this->results.emplace_back(std::move(result));
+	return this->results.back();
+}
+
+void BenchmarkSuite::OutputResults() const
+{
+	std::cout << "\n" << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(16) << "ns/op" << std::setw(24) << 
+		"throughput" << std::setw(14) << "allocations" << "\n";
+
+	for (const BenchmarkResult& result : this->results)
+	{
+		// The throughput is shown per millisecond, as that's the scale of a frame
+		std::ostringstream throughput;
+		throughput << std::fixed << std::setprecision(1) << (result.itemsPerSecond / 1e3) << " " << result.unit << "/ms";
+
+		std::cout << std::left << std::setw(48) << result.name << std::right << std::fixed << std::setprecision(1) << 
+			std::setw(16) << result.nsPerOp << std::setw(24) << throughput.str() << std::setw(14) << result.allocations << 
+			(result.valid ? "" : "  (RESULTS DIFFER FROM REFERENCE)") << "\n";
+	}
+}
+
+void BenchmarkSuite::WriteResults(const std::string_view& filePath) const
+{
+	nlohmann::json jsonObject = { { "benchmarks", nlohmann::json::array() } };
+	for (const BenchmarkResult& result : this->results)
+	{
+		jsonObject["benchmarks"].push_back(
+			{ 
+				{ "name", result.name },
+				{ "nsPerOp", result.nsPerOp },
+				{ result.unit + "PerSecond", result.itemsPerSecond },
+				{ "allocations", result.allocations },
+				{ "valid", result.valid }
+			});
+	}
+
+	std::ofstream resultsFile = std::ofstream(std::string(filePath), std::ios::trunc);
+	if (resultsFile.fail())
+	{
+		std::cout << "Failed to write the benchmark results to: " << filePath << "\n";
+		return;
+	}
+
+	resultsFile << std::setw(4) << jsonObject;
+	std::cout << "Wrote the benchmark results to: " << filePath << "\n";
+}
+
+bool BenchmarkSuite::CompareResults(const std::string_view& baselinePath, double threshold) const
+{
+	std::ifstream baselineFile = std::ifstream(std::string(baselinePath));
+	if (baselineFile.fail())
+	{
+		std::cout << "Failed to open the benchmark baseline: " << baselinePath << "\n";
+		return false;
+	}
+
+	const nlohmann::json baselineObject = nlohmann::json::parse(baselineFile, nullptr, false);
+	if (baselineObject.is_discarded() || !baselineObject.contains("benchmarks"))
+	{
+		std::cout << "The benchmark baseline is invalid: " << baselinePath << "\n";
+		return false;
+	}
+
+	std::unordered_map<std::string, BenchmarkResult> baselineResults;
+	for (const nlohmann::json& resultObject : baselineObject["benchmarks"])
+	{
+		BenchmarkResult baselineResult;
+		baselineResult.name = resultObject.value("name", std::string());
+		baselineResult.nsPerOp = resultObject.value("nsPerOp", 0.0);
+		baselineResult.allocations = resultObject.value("allocations", (uint64_t)0);
+		baselineResults[baselineResult.name] = baselineResult;
+	}
+
+	std::cout << "\nComparing against the baseline: " << baselinePath << " (threshold " << std::fixed << std::setprecision(1) << 
+		(threshold * 100.0) << "%)\n";
+
+	size_t numRegressions = 0;
+	for (const BenchmarkResult& result : this->results)
+	{
+		auto baselineIterator = baselineResults.find(result.name);
+		if (baselineIterator == baselineResults.end())
+		{
+			std::cout << "  NEW         " << result.name << "\n";
+			continue;
+		}
+
+		const BenchmarkResult& baselineResult = baselineIterator->second;
+		const double change = baselineResult.nsPerOp > 0.0 ? (result.nsPerOp / baselineResult.nsPerOp) - 1.0 : 0.0;
+
+		const bool slower = change > threshold;
+		const bool allocatesMore = result.allocations > baselineResult.allocations;
+		numRegressions += slower || allocatesMore || !result.valid;
+
+		const char* verdict = slower || allocatesMore || !result.valid ? "REGRESSION  " : change < -threshold ? "IMPROVEMENT " : 
+			"OK          ";
+
+		std::cout << "  " << verdict << result.name << ": " << std::showpos << (change * 100.0) << std::noshowpos << "% ns/op";
+		if (allocatesMore)
+			std::cout << ", allocations " << baselineResult.allocations << " -> " << result.allocations;
+		if (!result.valid)
+			std::cout << ", results differ from the reference";
+
+		std::cout << "\n";
+	}
+
+	std::cout << numRegressions << " regression(s) found\n";
+	return numRegressions == 0;
+}
+
+bool BenchmarkSuite::AreResultsValid() const
+{
+	return std::all_of(this->results.begin(), this->results.end(), [](const BenchmarkResult& result) { return result.valid; });
+}
@@ -0,0 +1,58 @@
+#ifndef BENCHMARK_SUITE_H
+#define BENCHMARK_SUITE_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+struct BenchmarkResult
+{
+	std::string name;
+	double nsPerOp = 0.0;
+	double itemsPerSecond = 0.0; // The items processed per second, e.g. the collider pairs resolved including the ones culled
+	std::string unit = "pairs"; // What the items counted are
+	uint64_t allocations = 0; // The number of heap allocations made during the fastest run
+	bool valid = true; // FALSE if the results of the benchmark didn't match the reference implementation
+};
+
+class BenchmarkSuite
+{
+private:
+	std::string filter, throughputUnit;
+	std::vector<BenchmarkResult> results;
+public:
+	// Only the benchmarks whose names contain the filter given are ran, every benchmark is ran if the filter is empty.
+	BenchmarkSuite(const std::string_view& filter = std::string_view());
+	~BenchmarkSuite() = default;
+
+	// Returns TRUE if the benchmark of the name given passes the filter, else FALSE is returned.
+	bool IsEnabled(const std::string_view& name) const;
+
+	// Sets what the items counted by the benchmarks measured from now on are, e.g. "pairs" or "particles".
+	void SetThroughputUnit(const std::string_view& unit);
+
+	// Times the function given, which performs the number of operations given where each operation covers the number of items 
+	// given. The function is ran a few times and the fastest run is recorded, the setup function (if given) is called before 
+	// every run without being timed or having its allocations counted.
+	// Returns the recorded result, so the caller can mark it invalid if its results don't match the reference implementation.
+	BenchmarkResult& Measure(const std::string_view& name, size_t numOps, double itemsPerOp, const std::function<void()>& func, 
+		const std::function<void()>& setupFunc = nullptr);
+
+	// Outputs the recorded results to the console.
+	void OutputResults() const;
+
+	// Writes the recorded results to the JSON file at the path given.
+	void WriteResults(const std::string_view& filePath) const;
+
+	// Compares the recorded results against the baseline results in the JSON file at the path given, outputting every benchmark 
+	// which became slower by more than the threshold given (a fraction e.g. 0.1 is 10%) or started allocating more.
+	// Returns TRUE if there were no regressions, else FALSE is returned.
+	bool CompareResults(const std::string_view& baselinePath, double threshold) const;
+
+	// Returns TRUE if every recorded benchmark matched its reference implementation, else FALSE is returned.
+	bool AreResultsValid() const;
+};
+
+#endif
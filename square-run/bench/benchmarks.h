@@ -0,0 +1,22 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <benchmark_suite.h>
+
+// Benchmarks the collider batch kernels against the scalar RectangleCollider::IsColliding path.
+extern void RunColliderBatchBenchmark(BenchmarkSuite& suite);
+
+// Benchmarks testing every pair with RectangleCollider::IsColliding against every broadphase, over random and endless runner scenes 
+// of several sizes.
+extern void RunCollisionBenchmark(BenchmarkSuite& suite);
+
+// Benchmarks the particle emitter kernels, stepping full emitters of several capacities.
+extern void RunParticleBenchmark(BenchmarkSuite& suite);
+
+// Benchmarks streaming runner chunks in around a scrolling camera, and outputs the chunk generation and hand over timings.
+extern void RunChunkStreamingBenchmark(BenchmarkSuite& suite);
+
+// Benchmarks triggering sound effects at every priority on a full voice pool, stealing voices as sounds finish.
+extern void RunVoicePoolBenchmark(BenchmarkSuite& suite);
+
+#endif
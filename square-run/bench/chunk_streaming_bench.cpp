@@ -0,0 +1,92 @@
+#include <benchmarks.h>
+
+#include <core/chunk_streamer.h>
+#include <memory>
+#include <string>
+
+namespace ChunkStreamingBenchGlobals
+{
+	constexpr size_t numSteps = 5000;
+	constexpr float timeStep = 0.001f;
+	constexpr float scrollSpeeds[] = { 2000.0f, 20000.0f }; // The second is far faster than the game ever scrolls, to stress the workers
+	constexpr uint64_t seed = 1337;
+}
+
+// Returns TRUE if every active chunk of the streamer given matches the chunk generated for its index on the calling thread.
+static bool AreChunksDeterministic(const ChunkStreamer& streamer, const ChunkStreamerDesc& desc)
+{
+	LevelChunk referenceChunk;
+	for (const LevelChunk* chunk : streamer.GetActiveChunks())
+	{
+		referenceChunk.index = chunk->index;
+		referenceChunk.startX = chunk->startX;
+		referenceChunk.width = chunk->width;
+		referenceChunk.colliders.clear();
+		referenceChunk.rects.clear();
+
+		std::mt19937 randomEngine(ChunkStreamer::GetChunkSeed(desc.seed, chunk->index));
+		ChunkStreamer::GenerateRunnerChunk(referenceChunk, randomEngine);
+
+		if (referenceChunk.colliders.size() != chunk->colliders.size())
+			return false;
+
+		for (size_t colliderIndex = 0; colliderIndex < chunk->colliders.size(); colliderIndex++)
+		{
+			if (referenceChunk.colliders[colliderIndex].GetPosition() != chunk->colliders[colliderIndex].GetPosition() ||
+				referenceChunk.colliders[colliderIndex].GetSize() != chunk->colliders[colliderIndex].GetSize())
+			{
+				return false;
+			}
+		}
+	}
+
+	return !streamer.GetActiveChunks().empty();
+}
+
+void RunChunkStreamingBenchmark(BenchmarkSuite& suite)
+{
+	suite.SetThroughputUnit("steps");
+
+	for (const float& scrollSpeed : ChunkStreamingBenchGlobals::scrollSpeeds)
+	{
+		const std::string name = "chunkStreaming/" + std::to_string((int)scrollSpeed);
+		if (!suite.IsEnabled(name))
+			continue;
+
+		ChunkStreamerDesc desc;
+		desc.seed = ChunkStreamingBenchGlobals::seed;
+
+		// The streamer is recreated before every run with the first chunks in place, as the game would before showing the level.
+		// One operation is a main loop step, which scrolls the camera and updates the streamer.
+		// The collision world is declared first, as it has to outlive the streamer
+		std::unique_ptr<CollisionWorld> world;
+		std::unique_ptr<ChunkStreamer> streamer;
+		OrthogonalCamera camera;
+
+		auto setupStreamer = [&]()
+		{
+			streamer.reset();
+			world = std::make_unique<CollisionWorld>(128.0f);
+			camera = OrthogonalCamera({ 0, 0 }, { 1920, 1080 });
+
+			streamer = std::make_unique<ChunkStreamer>(desc);
+			streamer->SetCollisionWorld(world.get());
+			streamer->WaitForPending(camera);
+		};
+
+		BenchmarkResult& result = suite.Measure(name, ChunkStreamingBenchGlobals::numSteps, 1.0, [&]()
+		{
+			for (size_t stepIndex = 0; stepIndex < ChunkStreamingBenchGlobals::numSteps; stepIndex++)
+			{
+				camera.SetPosition(camera.GetPosition() + glm::vec2(scrollSpeed * ChunkStreamingBenchGlobals::timeStep, 0.0f));
+				streamer->Update(camera);
+			}
+		}, setupStreamer);
+
+		// The steps are ran back to back rather than a millisecond apart, so the workers can fall behind the camera (which shows up as
+		// stalls), let them catch up before checking the chunks
+		streamer->OutputStats();
+		streamer->WaitForPending(camera);
+		result.valid = AreChunksDeterministic(*streamer, desc);
+	}
+}
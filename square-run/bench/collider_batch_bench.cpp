@@ -0,0 +1,108 @@
+#include <benchmarks.h>
+
+#include <core/collider_batch.h>
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace ColliderBatchBenchGlobals
+{
+	constexpr size_t batchSizes[] = { 1000, 10000, 100000 };
+	constexpr size_t totalTestsPerRun = 20000000; // The number of collider pairs tested per kernel, regardless of the batch size
+	constexpr float worldSize = 4096.0f;
+}
+
+void RunColliderBatchBenchmark(BenchmarkSuite& suite)
+{
+	suite.SetThroughputUnit("pairs");
+	std::mt19937 randomEngine(1337);
+	std::uniform_real_distribution<float> positionDistribution(0.0f, ColliderBatchBenchGlobals::worldSize);
+	std::uniform_real_distribution<float> sizeDistribution(8.0f, 128.0f);
+
+	auto generateCollider = [&]() 
+	{
+		return RectangleCollider({ positionDistribution(randomEngine), positionDistribution(randomEngine) }, 
+			{ sizeDistribution(randomEngine), sizeDistribution(randomEngine) });
+	};
+
+	const SimdLevel supportedLevel = ColliderBatch::GetSupportedSimdLevel();
+
+	for (const size_t& batchSize : ColliderBatchBenchGlobals::batchSizes)
+	{
+		std::vector<RectangleCollider> colliders;
+		ColliderBatch batch;
+		batch.Reserve(batchSize);
+
+		for (size_t colliderIndex = 0; colliderIndex < batchSize; colliderIndex++)
+		{
+			colliders.emplace_back(generateCollider());
+			batch.Add(colliders.back());
+		}
+
+		const size_t numQueries = std::max<size_t>(ColliderBatchBenchGlobals::totalTestsPerRun / batchSize, 1);
+		std::vector<RectangleCollider> queries;
+		for (size_t queryIndex = 0; queryIndex < numQueries; queryIndex++)
+			queries.emplace_back(generateCollider());
+
+		// The scalar path the kernels replace, testing every collider one by one.
+		// One operation is testing a query against the whole batch.
+		const std::string namePostfix = "/" + std::to_string(batchSize);
+		std::vector<CollidingSide> expectedSides(batchSize * std::min<size_t>(numQueries, 4));
+		size_t scalarOverlaps = 0;
+
+		auto testScalar = [&]()
+		{
+			scalarOverlaps = 0;
+			for (size_t queryIndex = 0; queryIndex < numQueries; queryIndex++)
+			{
+				for (size_t colliderIndex = 0; colliderIndex < batchSize; colliderIndex++)
+				{
+					const CollidingSide side = colliders[colliderIndex].IsColliding(queries[queryIndex]);
+					scalarOverlaps += side != CollidingSide::NONE;
+
+					if (queryIndex < 4)
+						expectedSides[(queryIndex * batchSize) + colliderIndex] = side;
+				}
+			}
+		};
+
+		// The scalar path is the reference for the kernels, so it's still ran when filtered out
+		if (suite.IsEnabled("batchQuery/isColliding" + namePostfix))
+			suite.Measure("batchQuery/isColliding" + namePostfix, numQueries, (double)batchSize, testScalar);
+		else
+			testScalar();
+
+		// Run every kernel supported, checking that the results match the scalar path
+		for (const SimdLevel& simdLevel : { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2 })
+		{
+			const std::string kernelName = simdLevel == SimdLevel::AVX2 ? "avx2" : simdLevel == SimdLevel::SSE2 ? "sse2" : "scalar";
+			if ((simdLevel == SimdLevel::AVX2 && supportedLevel != SimdLevel::AVX2) || 
+				!suite.IsEnabled("batchQuery/" + kernelName + namePostfix))
+			{
+				continue;
+			}
+
+			std::vector<uint64_t> overlapMask;
+			std::vector<CollidingSide> sides;
+			size_t batchOverlaps = 0;
+			bool matchesScalar = true;
+
+			// The output buffers are sized by the first test, so do it untimed to keep the allocations out of the results
+			batch.TestCollider(queries.front(), overlapMask, sides, simdLevel);
+
+			BenchmarkResult& result = suite.Measure("batchQuery/" + kernelName + namePostfix, numQueries, (double)batchSize, [&]()
+			{
+				batchOverlaps = 0;
+				for (size_t queryIndex = 0; queryIndex < numQueries; queryIndex++)
+				{
+					batchOverlaps += batch.TestCollider(queries[queryIndex], overlapMask, sides, simdLevel);
+
+					if (queryIndex < 4)
+						matchesScalar &= std::equal(sides.begin(), sides.end(), expectedSides.begin() + (queryIndex * batchSize));
+				}
+			});
+
+			result.valid = matchesScalar && batchOverlaps == scalarOverlaps;
+		}
+	}
+}
@@ -0,0 +1,190 @@
+#include <benchmarks.h>
+#include <collision_scenes.h>
+
+#include <core/collider_batch.h>
+#include <core/collision_world.h>
+#include <core/aabb_tree.h>
+#include <core/sweep_and_prune.h>
+#include <algorithm>
+#include <memory>
+
+namespace CollisionBenchGlobals
+{
+	constexpr size_t sceneSizes[] = { 1000, 4000, 16000 };
+	constexpr unsigned int sceneSeed = 1337;
+	constexpr size_t numSteps = 100; // The number of scene steps timed per broadphase run
+	constexpr double bruteForcePairsPerRun = 50e6; // The testing every pair benchmarks run for at least this many pairs
+	constexpr float worldCellSize = 128.0f;
+}
+
+// Runs the collision benchmarks over the scene given.
+static void RunSceneBenchmarks(BenchmarkSuite& suite, const CollisionScene& initialScene)
+{
+	const size_t numColliders = initialScene.colliders.size();
+	const double scenePairs = (double)numColliders * (numColliders - 1) / 2.0;
+	const std::string namePostfix = "/" + initialScene.name + "/" + std::to_string(numColliders);
+
+	// The reference touching pair count, after the broadphases have stepped the scene
+	CollisionScene steppedScene = initialScene;
+	for (size_t stepIndex = 0; stepIndex < CollisionBenchGlobals::numSteps; stepIndex++)
+		steppedScene.Step();
+
+	const size_t expectedTouchingPairs = steppedScene.CountTouchingPairs();
+
+	// Testing every pair of colliders with RectangleCollider::IsColliding, which is what every broadphase is compared against
+	if (suite.IsEnabled("isColliding" + namePostfix))
+	{
+		const size_t numRepeats = std::max<size_t>((size_t)(CollisionBenchGlobals::bruteForcePairsPerRun / scenePairs), 1);
+		size_t numTouchingPairs = 0;
+
+		BenchmarkResult& result = suite.Measure("isColliding" + namePostfix, numRepeats, scenePairs, [&]()
+		{
+			for (size_t repeatIndex = 0; repeatIndex < numRepeats; repeatIndex++)
+				numTouchingPairs = steppedScene.CountTouchingPairs();
+		});
+
+		result.valid = numTouchingPairs == expectedTouchingPairs;
+	}
+
+	// Testing every collider against the whole scene with the SIMD collider batch
+	if (suite.IsEnabled("colliderBatch" + namePostfix))
+	{
+		ColliderBatch batch;
+		batch.Reserve(numColliders);
+		for (const RectangleCollider& collider : steppedScene.colliders)
+			batch.Add(collider);
+
+		const size_t numRepeats = std::max<size_t>((size_t)(CollisionBenchGlobals::bruteForcePairsPerRun / scenePairs), 1);
+		std::vector<uint64_t> overlapMask;
+		std::vector<CollidingSide> sides;
+		size_t numTouchingPairs = 0;
+
+		BenchmarkResult& result = suite.Measure("colliderBatch" + namePostfix, numRepeats, scenePairs, [&]()
+		{
+			for (size_t repeatIndex = 0; repeatIndex < numRepeats; repeatIndex++)
+			{
+				// Every pair is found from both sides, and every collider also overlaps itself
+				size_t numOverlaps = 0;
+				for (const RectangleCollider& collider : steppedScene.colliders)
+					numOverlaps += batch.TestCollider(collider, overlapMask, sides);
+
+				numTouchingPairs = (numOverlaps - numColliders) / 2;
+			}
+		}, [&]()
+		{
+			// The output buffers are sized by the first test, so do it untimed to keep the allocations out of the results
+			batch.TestCollider(steppedScene.colliders.front(), overlapMask, sides);
+		});
+
+		result.valid = numTouchingPairs == expectedTouchingPairs;
+	}
+
+	// The broadphases are timed stepping the scene, as that's how they're used (and what their incremental updates rely on), 
+	// building them is left untimed
+	if (suite.IsEnabled("collisionWorld" + namePostfix))
+	{
+		CollisionScene scene;
+		CollisionWorld world(CollisionBenchGlobals::worldCellSize);
+		std::vector<ColliderHandle> handles;
+		size_t numTouchingPairs = 0;
+
+		BenchmarkResult& result = suite.Measure("collisionWorld" + namePostfix, CollisionBenchGlobals::numSteps, scenePairs, [&]()
+		{
+			for (size_t stepIndex = 0; stepIndex < CollisionBenchGlobals::numSteps; stepIndex++)
+			{
+				scene.Step();
+				for (size_t colliderIndex = 0; colliderIndex < numColliders; colliderIndex++)
+					world.Update(handles[colliderIndex], scene.colliders[colliderIndex]);
+
+				numTouchingPairs = world.QueryPairs().size();
+			}
+		}, [&]()
+		{
+			scene = initialScene;
+			world.Clear();
+			handles.clear();
+			for (const RectangleCollider& collider : scene.colliders)
+				handles.emplace_back(world.Insert(collider));
+		});
+
+		result.valid = numTouchingPairs == expectedTouchingPairs;
+	}
+
+	if (suite.IsEnabled("aabbTree" + namePostfix))
+	{
+		CollisionScene scene;
+		std::unique_ptr<AABBTree> tree;
+		std::vector<int32_t> proxies;
+		size_t numTouchingPairs = 0;
+
+		BenchmarkResult& result = suite.Measure("aabbTree" + namePostfix, CollisionBenchGlobals::numSteps, scenePairs, [&]()
+		{
+			for (size_t stepIndex = 0; stepIndex < CollisionBenchGlobals::numSteps; stepIndex++)
+			{
+				scene.Step();
+				for (size_t colliderIndex = 0; colliderIndex < numColliders; colliderIndex++)
+					tree->MoveProxy(proxies[colliderIndex], scene.colliders[colliderIndex]);
+
+				// Every pair is found from both sides, so only count it from the collider with the lower handle
+				numTouchingPairs = 0;
+				for (ColliderHandle handle = 0; handle < (ColliderHandle)numColliders; handle++)
+				{
+					for (const ColliderOverlap& overlap : tree->QueryOverlaps(scene.colliders[handle]))
+						numTouchingPairs += overlap.handle > handle;
+				}
+			}
+		}, [&]()
+		{
+			scene = initialScene;
+			tree = std::make_unique<AABBTree>();
+			proxies.clear();
+			for (ColliderHandle handle = 0; handle < (ColliderHandle)numColliders; handle++)
+				proxies.emplace_back(tree->CreateProxy(scene.colliders[handle], handle));
+		});
+
+		result.valid = numTouchingPairs == expectedTouchingPairs;
+	}
+
+	if (suite.IsEnabled("sweepAndPrune" + namePostfix))
+	{
+		CollisionScene scene;
+		std::unique_ptr<SweepAndPrune> sweepAndPrune;
+		std::vector<ColliderHandle> handles;
+		size_t numTouchingPairs = 0;
+
+		BenchmarkResult& result = suite.Measure("sweepAndPrune" + namePostfix, CollisionBenchGlobals::numSteps, scenePairs, [&]()
+		{
+			for (size_t stepIndex = 0; stepIndex < CollisionBenchGlobals::numSteps; stepIndex++)
+			{
+				scene.Step();
+				for (size_t colliderIndex = 0; colliderIndex < numColliders; colliderIndex++)
+					sweepAndPrune->Update(handles[colliderIndex], scene.colliders[colliderIndex]);
+
+				sweepAndPrune->UpdatePairs();
+			}
+
+			numTouchingPairs = sweepAndPrune->GetNumTouchingPairs();
+		}, [&]()
+		{
+			scene = initialScene;
+			sweepAndPrune = std::make_unique<SweepAndPrune>();
+			handles.clear();
+			for (const RectangleCollider& collider : scene.colliders)
+				handles.emplace_back(sweepAndPrune->Insert(collider));
+
+			sweepAndPrune->UpdatePairs();
+		});
+
+		result.valid = numTouchingPairs == expectedTouchingPairs;
+	}
+}
+
+void RunCollisionBenchmark(BenchmarkSuite& suite)
+{
+	suite.SetThroughputUnit("pairs");
+	for (const size_t& sceneSize : CollisionBenchGlobals::sceneSizes)
+	{
+		RunSceneBenchmarks(suite, GenerateRandomScene(sceneSize, CollisionBenchGlobals::sceneSeed));
+		RunSceneBenchmarks(suite, GenerateRunnerScene(sceneSize, CollisionBenchGlobals::sceneSeed));
+	}
+}
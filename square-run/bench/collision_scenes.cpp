@@ -0,0 +1,120 @@
+#include <collision_scenes.h>
+
+#include <random>
+
+namespace CollisionSceneGlobals
+{
+	constexpr float sceneHeight = 1080.0f;
+	constexpr float randomDensity = 0.1f; // The fraction of the random scene area covered by colliders (ignoring overlaps)
+
+	constexpr float tileSize = 64.0f;
+	constexpr float groundLevel = 960.0f;
+	constexpr float scrollSpeed = 0.5f;
+	constexpr size_t numPlayers = 4;
+}
+
+void CollisionScene::Step()
+{
+	for (size_t colliderIndex = 0; colliderIndex < this->colliders.size(); colliderIndex++)
+	{
+		glm::vec2 position = this->colliders[colliderIndex].GetPosition() + this->velocities[colliderIndex];
+		if (position.x < 0.0f)
+			position.x += this->length;
+		else if (position.x > this->length)
+			position.x -= this->length;
+
+		this->colliders[colliderIndex].SetPosition(position);
+	}
+}
+
+size_t CollisionScene::CountTouchingPairs() const
+{
+	size_t numTouchingPairs = 0;
+	for (size_t firstIndex = 0; firstIndex < this->colliders.size(); firstIndex++)
+	{
+		for (size_t secondIndex = firstIndex + 1; secondIndex < this->colliders.size(); secondIndex++)
+			numTouchingPairs += this->colliders[firstIndex].IsColliding(this->colliders[secondIndex]) != CollidingSide::NONE;
+	}
+
+	return numTouchingPairs;
+}
+
+CollisionScene GenerateRandomScene(size_t numColliders, unsigned int seed)
+{
+	std::mt19937 randomEngine(seed);
+	std::uniform_real_distribution<float> sizeDistribution(8.0f, 96.0f);
+	std::uniform_real_distribution<float> velocityDistribution(-2.0f, 2.0f);
+
+	// Scale the scene with the number of colliders, so the density stays the same at every size
+	CollisionScene scene;
+	scene.name = "random";
+	scene.length = (numColliders * 52.0f * 52.0f) / (CollisionSceneGlobals::randomDensity * CollisionSceneGlobals::sceneHeight);
+
+	std::uniform_real_distribution<float> positionXDistribution(0.0f, scene.length);
+	std::uniform_real_distribution<float> positionYDistribution(0.0f, CollisionSceneGlobals::sceneHeight);
+
+	for (size_t colliderIndex = 0; colliderIndex < numColliders; colliderIndex++)
+	{
+		scene.colliders.emplace_back(glm::vec2(positionXDistribution(randomEngine), positionYDistribution(randomEngine)), 
+			glm::vec2(sizeDistribution(randomEngine), sizeDistribution(randomEngine)));
+		scene.velocities.emplace_back(velocityDistribution(randomEngine), velocityDistribution(randomEngine));
+	}
+
+	return scene;
+}
+
+CollisionScene GenerateRunnerScene(size_t numColliders, unsigned int seed)
+{
+	std::mt19937 randomEngine(seed);
+	std::uniform_int_distribution<int> tileDistribution(0, 3);
+	std::uniform_real_distribution<float> playerDistribution(-0.5f, 1.5f);
+
+	// Half of the colliders make up the ground, the rest are obstacles, platforms and players
+	const size_t numGroundTiles = numColliders / 2;
+	const float tileSize = CollisionSceneGlobals::tileSize;
+
+	CollisionScene scene;
+	scene.name = "runner";
+	scene.length = numGroundTiles * tileSize;
+
+	const glm::vec2 scrollVelocity = { -CollisionSceneGlobals::scrollSpeed, 0.0f };
+	for (size_t tileIndex = 0; tileIndex < numGroundTiles; tileIndex++)
+	{
+		scene.colliders.emplace_back(glm::vec2((tileIndex + 0.5f) * tileSize, CollisionSceneGlobals::groundLevel + (tileSize / 2.0f)), 
+			glm::vec2(tileSize));
+		scene.velocities.emplace_back(scrollVelocity);
+	}
+
+	// The players run in place (relative to the screen) while jittering back and forth, so they keep crossing the obstacles
+	for (size_t playerIndex = 0; playerIndex < CollisionSceneGlobals::numPlayers && scene.colliders.size() < numColliders; 
+		playerIndex++)
+	{
+		scene.colliders.emplace_back(glm::vec2((playerIndex + 1) * scene.length / (CollisionSceneGlobals::numPlayers + 1), 
+			CollisionSceneGlobals::groundLevel - (tileSize / 2.0f)), glm::vec2(tileSize));
+		scene.velocities.emplace_back(playerDistribution(randomEngine), 0.0f);
+	}
+
+	size_t obstacleIndex = 0;
+	while (scene.colliders.size() < numColliders)
+	{
+		const float positionX = ((obstacleIndex * 2) % numGroundTiles + 0.5f) * tileSize;
+		const size_t stackHeight = (obstacleIndex / numGroundTiles) + 1;
+
+		// Obstacles rest on the ground (stacked if there are more obstacles than fit), platforms float above them
+		if (tileDistribution(randomEngine) != 0)
+		{
+			scene.colliders.emplace_back(glm::vec2(positionX, CollisionSceneGlobals::groundLevel - ((stackHeight - 0.5f) * tileSize)), 
+				glm::vec2(tileSize));
+		}
+		else
+		{
+			scene.colliders.emplace_back(glm::vec2(positionX, CollisionSceneGlobals::groundLevel - ((stackHeight + 3.0f) * tileSize)),
+				glm::vec2(tileSize * 3.0f, tileSize / 4.0f));
+		}
+
+		scene.velocities.emplace_back(scrollVelocity);
+		obstacleIndex++;
+	}
+
+	return scene;
+}
@@ -0,0 +1,30 @@
+#ifndef COLLISION_SCENES_H
+#define COLLISION_SCENES_H
+
+#include <core/collision_detection.h>
+#include <vector>
+#include <string>
+
+// A scene of colliders moving at constant velocities, the scenes wrap around horizontally so they can be stepped indefinitely.
+struct CollisionScene
+{
+	std::string name;
+	std::vector<RectangleCollider> colliders;
+	std::vector<glm::vec2> velocities; // In units per step
+	float length = 0.0f;
+
+	// Moves every collider by its velocity, wrapping the colliders leaving either end of the scene around to the other.
+	void Step();
+
+	// Returns the number of touching collider pairs, found by testing every pair of colliders.
+	size_t CountTouchingPairs() const;
+};
+
+// Returns a scene of randomly sized colliders scattered uniformly, every collider moving in a random direction.
+extern CollisionScene GenerateRandomScene(size_t numColliders, unsigned int seed);
+
+// Returns a scene laid out like an endless runner level: a row of ground tiles with obstacles resting on them, floating platforms 
+// and a handful of players, everything except the players scrolling left.
+extern CollisionScene GenerateRunnerScene(size_t numColliders, unsigned int seed);
+
+#endif
@@ -0,0 +1,90 @@
+#include <benchmarks.h>
+
+#include <core/particle_system.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace ParticleBenchGlobals
+{
+	constexpr size_t capacities[] = { 10000, 50000 };
+	constexpr size_t numSteps = 1000;
+	constexpr float timeStep = 0.001f;
+	constexpr float tolerance = 1e-3f;
+}
+
+// Returns the settings of the emitters benchmarked, the emit rate is high enough that the emitter stays full as particles die.
+static ParticleEmitterDesc GetBenchmarkEmitterDesc(size_t capacity)
+{
+	ParticleEmitterDesc desc;
+	desc.capacity = capacity;
+	desc.minLifetime = 0.2f;
+	desc.maxLifetime = 1.0f;
+	desc.emitRate = (float)capacity * 4.0f;
+	desc.spawnRadius = 200.0f;
+	desc.acceleration = { 0.0f, 500.0f };
+	desc.seed = 1337;
+	return desc;
+}
+
+void RunParticleBenchmark(BenchmarkSuite& suite)
+{
+	suite.SetThroughputUnit("particles");
+	const SimdLevel supportedLevel = Util::GetSupportedSimdLevel();
+
+	for (const size_t& capacity : ParticleBenchGlobals::capacities)
+	{
+		const std::string namePostfix = "/" + std::to_string(capacity);
+
+		// The emitter is recreated and filled before every run, so every kernel integrates exactly the same particles.
+		// One operation is a simulation step, which integrates every particle of the full emitter.
+		ParticleEmitterPtr emitter;
+		auto setupEmitter = [&]()
+		{
+			emitter = Memory::CreateParticleEmitter(GetBenchmarkEmitterDesc(capacity));
+			for (size_t stepIndex = 0; stepIndex < ParticleBenchGlobals::numSteps; stepIndex++)
+				emitter->Update(ParticleBenchGlobals::timeStep, SimdLevel::SCALAR);
+		};
+
+		auto runSteps = [&](SimdLevel simdLevel)
+		{
+			for (size_t stepIndex = 0; stepIndex < ParticleBenchGlobals::numSteps; stepIndex++)
+				emitter->Update(ParticleBenchGlobals::timeStep, simdLevel);
+		};
+
+		// The scalar kernel is the reference for the others, so record the particles it ends up with
+		setupEmitter();
+		runSteps(SimdLevel::SCALAR);
+
+		const ParticleEmitterPtr referenceEmitter = emitter;
+
+		for (const SimdLevel& simdLevel : { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2 })
+		{
+			const std::string kernelName = simdLevel == SimdLevel::AVX2 ? "avx2" : simdLevel == SimdLevel::SSE2 ? "sse2" : "scalar";
+			if ((simdLevel == SimdLevel::AVX2 && supportedLevel != SimdLevel::AVX2) || 
+				!suite.IsEnabled("particles/" + kernelName + namePostfix))
+			{
+				continue;
+			}
+
+			BenchmarkResult& result = suite.Measure("particles/" + kernelName + namePostfix, ParticleBenchGlobals::numSteps, 
+				(double)capacity, [&]() { runSteps(simdLevel); }, setupEmitter);
+
+			// Check the particles of the last run match the reference, allowing for the compiler contracting the scalar kernel
+			bool matchesReference = emitter->GetNumParticles() == referenceEmitter->GetNumParticles();
+			for (size_t channelIndex = 0; channelIndex < (size_t)ParticleChannel::COUNT && matchesReference; channelIndex++)
+			{
+				const float* values = emitter->GetChannel((ParticleChannel)channelIndex);
+				const float* referenceValues = referenceEmitter->GetChannel((ParticleChannel)channelIndex);
+
+				for (size_t index = 0; index < emitter->GetNumParticles() && matchesReference; index++)
+				{
+					matchesReference = std::abs(values[index] - referenceValues[index]) <= 
+						ParticleBenchGlobals::tolerance * std::max(std::abs(referenceValues[index]), 1.0f);
+				}
+			}
+
+			result.valid = matchesReference;
+		}
+	}
+}
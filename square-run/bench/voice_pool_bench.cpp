@@ -0,0 +1,281 @@
+#include <benchmarks.h>
+
+#include <core/voice_pool.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <string>
+
+namespace VoicePoolBenchGlobals
+{
+	constexpr size_t numTriggers = 100000;
+	constexpr size_t triggersPerStep = 8; // The triggers made per main loop step, one playing sound finishes every step
+	constexpr uint32_t effectMaxInstances = 4;
+	constexpr size_t effectsPerPriority = 2;
+	constexpr size_t numEffects = effectsPerPriority * VoicePoolGlobals::numPriorities;
+	constexpr uint32_t seed = 1337;
+}
+
+// The benchmarks have no audio device, and the sounds of irrKlang's null device finish in real time, so the voice pool plays its
+// sound effects on a sound engine of its own. The engine recycles its sounds, so only the voice pool's own allocations are counted.
+class BenchSound : public irrklang::ISound
+{
+	friend class BenchSoundEngine;
+private:
+	irrklang::ISoundStopEventReceiver* stopReceiver = nullptr;
+	void* stopUserData = nullptr;
+	irrklang::ISoundSource* source = nullptr;
+	bool inUse = false, playing = false, paused = false;
+	float volume = 1.0f;
+	std::vector<BenchSound*>* freeSounds = nullptr;
+public:
+	// The sounds are owned by the engine, so they're never deleted through their references
+	void grab() override {}
+	bool drop() override { return false; }
+
+	irrklang::ISoundSource* getSoundSource() override { return this->source; }
+	void setIsPaused(bool paused = true) override { this->paused = paused; }
+	bool getIsPaused() override { return this->paused; }
+	irrklang::ik_f32 getVolume() override { return this->volume; }
+	void setVolume(irrklang::ik_f32 volume) override { this->volume = volume; }
+	bool isFinished() override { return !this->playing; }
+
+	void stop() override
+	{
+		if (!this->inUse)
+			return;
+
+		this->inUse = this->playing = false;
+		this->freeSounds->push_back(this);
+	}
+
+	void setSoundStopEventReceiver(irrklang::ISoundStopEventReceiver* receiver, void* userData = 0) override
+	{
+		this->stopReceiver = receiver;
+		this->stopUserData = userData;
+	}
+
+	void setPan(irrklang::ik_f32 pan) override {}
+	irrklang::ik_f32 getPan() override { return 0.0f; }
+	bool isLooped() override { return false; }
+	void setIsLooped(bool looped) override {}
+	void setMinDistance(irrklang::ik_f32 min) override {}
+	irrklang::ik_f32 getMinDistance() override { return 0.0f; }
+	void setMaxDistance(irrklang::ik_f32 max) override {}
+	irrklang::ik_f32 getMaxDistance() override { return 0.0f; }
+	void setPosition(irrklang::vec3df position) override {}
+	irrklang::vec3df getPosition() override { return {}; }
+	void setVelocity(irrklang::vec3df vel) override {}
+	irrklang::vec3df getVelocity() override { return {}; }
+	irrklang::ik_u32 getPlayPosition() override { return 0; }
+	bool setPlayPosition(irrklang::ik_u32 pos) override { return false; }
+	bool setPlaybackSpeed(irrklang::ik_f32 speed = 1.0f) override { return false; }
+	irrklang::ik_f32 getPlaybackSpeed() override { return 1.0f; }
+	irrklang::ik_u32 getPlayLength() override { return 0; }
+	irrklang::ISoundEffectControl* getSoundEffectControl() override { return nullptr; }
+};
+
+class BenchSoundSource : public irrklang::ISoundSource
+{
+public:
+	void grab() override {}
+	bool drop() override { return false; }
+
+	const irrklang::ik_c8* getName() override { return "bench"; }
+	void setStreamMode(irrklang::E_STREAM_MODE mode) override {}
+	irrklang::E_STREAM_MODE getStreamMode() override { return irrklang::ESM_NO_STREAMING; }
+	irrklang::ik_u32 getPlayLength() override { return 0; }
+	irrklang::SAudioStreamFormat getAudioFormat() override { return {}; }
+	bool getIsSeekingSupported() override { return false; }
+	void setDefaultVolume(irrklang::ik_f32 volume = 1.0f) override {}
+	irrklang::ik_f32 getDefaultVolume() override { return 1.0f; }
+	void setDefaultMinDistance(irrklang::ik_f32 minDistance) override {}
+	irrklang::ik_f32 getDefaultMinDistance() override { return 0.0f; }
+	void setDefaultMaxDistance(irrklang::ik_f32 maxDistance) override {}
+	irrklang::ik_f32 getDefaultMaxDistance() override { return 0.0f; }
+	void forceReloadAtNextUse() override {}
+	void setForcedStreamingThreshold(irrklang::ik_s32 thresholdBytes) override {}
+	irrklang::ik_s32 getForcedStreamingThreshold() override { return 0; }
+	void* getSampleData() override { return nullptr; }
+};
+
+class BenchSoundEngine : public irrklang::ISoundEngine
+{
+private:
+	std::vector<BenchSound> sounds;
+	std::vector<BenchSound*> freeSounds;
+	std::array<BenchSoundSource, VoicePoolBenchGlobals::numEffects> sources;
+	size_t numSourcesAdded = 0, finishCursor = 0;
+	irrklang::SInternalAudioInterface internalInterface = {};
+public:
+	// The voice pool never has more sounds playing than it has voices, and a voice's sound is stopped before the voice is reused
+	BenchSoundEngine(size_t numSounds) :
+		sounds(numSounds)
+	{
+		this->freeSounds.reserve(numSounds);
+		for (BenchSound& sound : this->sounds)
+		{
+			sound.freeSounds = &this->freeSounds;
+			this->freeSounds.push_back(&sound);
+		}
+	}
+
+	// Finishes the next sound which is still playing, sending its stop event like irrKlang would.
+	void FinishNextSound()
+	{
+		for (size_t soundOffset = 0; soundOffset < this->sounds.size(); soundOffset++)
+		{
+			BenchSound& sound = this->sounds[(this->finishCursor + soundOffset) % this->sounds.size()];
+			if (sound.playing && !sound.paused)
+			{
+				this->finishCursor = (this->finishCursor + soundOffset + 1) % this->sounds.size();
+				sound.playing = false;
+				if (sound.stopReceiver)
+					sound.stopReceiver->OnSoundStopped(&sound, irrklang::ESEC_SOUND_FINISHED_PLAYING, sound.stopUserData);
+
+				return;
+			}
+		}
+	}
+
+	// Returns the number of sounds handed out which weren't stopped yet, and the most of them playing the same source.
+	void CountSoundsInUse(size_t& numInUse, size_t& maxOfSource) const
+	{
+		std::array<size_t, VoicePoolBenchGlobals::numEffects> sourceCounts = {};
+		numInUse = 0;
+
+		for (const BenchSound& sound : this->sounds)
+		{
+			if (sound.inUse)
+			{
+				numInUse++;
+				sourceCounts[static_cast<const BenchSoundSource*>(sound.source) - this->sources.data()]++;
+			}
+		}
+
+		maxOfSource = 0;
+		for (const size_t& sourceCount : sourceCounts)
+			maxOfSource = std::max(maxOfSource, sourceCount);
+	}
+
+	irrklang::ISoundSource* addSoundSourceFromFile(const irrklang::ik_c8* fileName, 
+		irrklang::E_STREAM_MODE mode = irrklang::ESM_AUTO_DETECT, bool preload = false) override
+	{
+		return this->numSourcesAdded < this->sources.size() ? &this->sources[this->numSourcesAdded++] : nullptr;
+	}
+
+	irrklang::ISound* play2D(irrklang::ISoundSource* source, bool playLooped = false, bool startPaused = false, bool track = false,
+		bool enableSoundEffects = false) override
+	{
+		if (this->freeSounds.empty())
+			return nullptr;
+
+		BenchSound* sound = this->freeSounds.back();
+		this->freeSounds.pop_back();
+
+		sound->source = source;
+		sound->inUse = sound->playing = true;
+		sound->paused = startPaused;
+		sound->stopReceiver = nullptr;
+		return sound;
+	}
+
+	const char* getDriverName() override { return "bench"; }
+	irrklang::ISound* play2D(const char* soundFileName, bool playLooped = false, bool startPaused = false, bool track = false,
+		irrklang::E_STREAM_MODE streamMode = irrklang::ESM_AUTO_DETECT, bool enableSoundEffects = false) override { return nullptr; }
+	irrklang::ISound* play3D(const char* soundFileName, irrklang::vec3df pos, bool playLooped = false, bool startPaused = false,
+		bool track = false, irrklang::E_STREAM_MODE streamMode = irrklang::ESM_AUTO_DETECT, bool enableSoundEffects = false) override
+		{ return nullptr; }
+	irrklang::ISound* play3D(irrklang::ISoundSource* source, irrklang::vec3df pos, bool playLooped = false, bool startPaused = false,
+		bool track = false, bool enableSoundEffects = false) override { return nullptr; }
+	void stopAllSounds() override {}
+	void setAllSoundsPaused(bool bPaused = true) override {}
+	irrklang::ISoundSource* getSoundSource(const irrklang::ik_c8* soundName, bool addIfNotFound = true) override { return nullptr; }
+	irrklang::ISoundSource* getSoundSource(irrklang::ik_s32 index) override { return nullptr; }
+	irrklang::ik_s32 getSoundSourceCount() override { return 0; }
+	irrklang::ISoundSource* addSoundSourceFromMemory(void* memory, irrklang::ik_s32 sizeInBytes, const irrklang::ik_c8* soundName,
+		bool copyMemory = true) override { return nullptr; }
+	irrklang::ISoundSource* addSoundSourceFromPCMData(void* memory, irrklang::ik_s32 sizeInBytes, const irrklang::ik_c8* soundName,
+		irrklang::SAudioStreamFormat format, bool copyMemory = true) override { return nullptr; }
+	irrklang::ISoundSource* addSoundSourceAlias(irrklang::ISoundSource* baseSource, const irrklang::ik_c8* soundName) override
+		{ return nullptr; }
+	void removeSoundSource(irrklang::ISoundSource* source) override {}
+	void removeSoundSource(const irrklang::ik_c8* name) override {}
+	void removeAllSoundSources() override {}
+	void setSoundVolume(irrklang::ik_f32 volume) override {}
+	irrklang::ik_f32 getSoundVolume() override { return 1.0f; }
+	void setListenerPosition(const irrklang::vec3df& pos, const irrklang::vec3df& lookdir,
+		const irrklang::vec3df& velPerSecond = irrklang::vec3df(0, 0, 0), const irrklang::vec3df& upVector = irrklang::vec3df(0, 1, 0))
+		override {}
+	void update() override {}
+	bool isCurrentlyPlaying(const char* soundName) override { return false; }
+	bool isCurrentlyPlaying(irrklang::ISoundSource* source) override { return false; }
+	void stopAllSoundsOfSoundSource(irrklang::ISoundSource* source) override {}
+	void registerAudioStreamLoader(irrklang::IAudioStreamLoader* loader) override {}
+	bool isMultiThreaded() const override { return false; }
+	void addFileFactory(irrklang::IFileFactory* fileFactory) override {}
+	void setDefault3DSoundMinDistance(irrklang::ik_f32 minDistance) override {}
+	irrklang::ik_f32 getDefault3DSoundMinDistance() override { return 0.0f; }
+	void setDefault3DSoundMaxDistance(irrklang::ik_f32 maxDistance) override {}
+	irrklang::ik_f32 getDefault3DSoundMaxDistance() override { return 0.0f; }
+	void setRolloffFactor(irrklang::ik_f32 rolloff) override {}
+	void setDopplerEffectParameters(irrklang::ik_f32 dopplerFactor = 1.0f, irrklang::ik_f32 distanceFactor = 1.0f) override {}
+	bool loadPlugins(const irrklang::ik_c8* path) override { return false; }
+	const irrklang::SInternalAudioInterface& getInternalAudioInterface() override { return this->internalInterface; }
+	bool setMixedDataOutputReceiver(irrklang::ISoundMixedOutputReceiver* receiver) override { return false; }
+};
+
+void RunVoicePoolBenchmark(BenchmarkSuite& suite)
+{
+	suite.SetThroughputUnit("triggers");
+
+	const std::string name = "voicePool/" + std::to_string(VoicePoolGlobals::numVoices);
+	if (!suite.IsEnabled(name))
+		return;
+
+	// The effects are spread evenly over the priorities, and triggered in a fixed random order so every run steals the same voices
+	std::vector<uint32_t> triggerOrder(VoicePoolBenchGlobals::numTriggers);
+	uint32_t randomState = VoicePoolBenchGlobals::seed;
+	for (uint32_t& effectIndex : triggerOrder)
+	{
+		randomState = (randomState * 1664525u) + 1013904223u;
+		effectIndex = (randomState >> 16) % VoicePoolBenchGlobals::numEffects;
+	}
+
+	// The engine is declared first, as it has to outlive the voice pool
+	BenchSoundEngine engine(VoicePoolGlobals::numVoices);
+	VoicePool pool(&engine);
+
+	std::array<SoundEffectHandle, VoicePoolBenchGlobals::numEffects> effects;
+	for (size_t effectIndex = 0; effectIndex < effects.size(); effectIndex++)
+	{
+		const SoundPriority priority = (SoundPriority)(effectIndex / VoicePoolBenchGlobals::effectsPerPriority);
+		effects[effectIndex] = pool.RegisterEffect("bench.wav", VoicePoolBenchGlobals::effectMaxInstances, priority);
+	}
+
+	// One operation is a trigger, and the stopped voices are reclaimed every step like the audio system does
+	BenchmarkResult& result = suite.Measure(name, VoicePoolBenchGlobals::numTriggers, 1.0, [&]()
+	{
+		for (size_t triggerIndex = 0; triggerIndex < VoicePoolBenchGlobals::numTriggers; triggerIndex++)
+		{
+			pool.Trigger(effects[triggerOrder[triggerIndex]]);
+
+			if ((triggerIndex + 1) % VoicePoolBenchGlobals::triggersPerStep == 0)
+			{
+				engine.FinishNextSound();
+				pool.ReclaimStoppedVoices();
+			}
+		}
+	}, [&]() { pool.StopAll(); });
+
+	// Every sound the pool hasn't stopped has to be on one of its voices, within the instance limit of its sound effect
+	size_t numInUse = 0, maxOfSource = 0;
+	pool.ReclaimStoppedVoices();
+	engine.CountSoundsInUse(numInUse, maxOfSource);
+
+	result.valid = numInUse == pool.GetNumActiveVoices() && numInUse <= VoicePoolGlobals::numVoices &&
+		maxOfSource <= VoicePoolBenchGlobals::effectMaxInstances && pool.GetNumStolenVoices() > 0;
+
+	for (SoundEffectHandle& effect : effects)
+		pool.UnregisterEffect(effect);
+}
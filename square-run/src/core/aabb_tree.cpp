@@ -0,0 +1,425 @@
+#include <core/aabb_tree.h>
+
+#include <algorithm>
+#include <cmath>
+
+AABBTree::AABBTree(float fatMargin) :
+	rootNode(AABBTreeGlobals::nullNode), freeList(AABBTreeGlobals::nullNode), numLeaves(0), fatMargin(fatMargin)
+{}
+
+int32_t AABBTree::AllocateNode()
+{
+	// Grow the node pool if there are no free nodes left, the new nodes are all linked into the free list
+	if (this->freeList == AABBTreeGlobals::nullNode)
+	{
+		const int32_t oldCapacity = (int32_t)this->nodes.size();
+		const int32_t newCapacity = std::max(oldCapacity * 2, 16);
+		this->nodes.resize(newCapacity);
+
+		for (int32_t nodeIndex = oldCapacity; nodeIndex < newCapacity; nodeIndex++)
+		{
+			this->nodes[nodeIndex].parent = nodeIndex + 1 < newCapacity ? nodeIndex + 1 : AABBTreeGlobals::nullNode;
+			this->nodes[nodeIndex].height = -1;
+		}
+
+		this->freeList = oldCapacity;
+	}
+
+	const int32_t nodeIndex = this->freeList;
+	TreeNode& node = this->nodes[nodeIndex];
+	this->freeList = node.parent;
+
+	node.parent = node.firstChild = node.secondChild = AABBTreeGlobals::nullNode;
+	node.height = 0;
+	node.userData = CollisionWorldGlobals::invalidHandle;
+
+	return nodeIndex;
+}
+
+void AABBTree::FreeNode(int32_t nodeIndex)
+{
+	this->nodes[nodeIndex].parent = this->freeList;
+	this->nodes[nodeIndex].height = -1;
+	this->freeList = nodeIndex;
+}
+
+void AABBTree::InsertLeaf(int32_t leafIndex)
+{
+	if (this->rootNode == AABBTreeGlobals::nullNode)
+	{
+		this->rootNode = leafIndex;
+		this->nodes[leafIndex].parent = AABBTreeGlobals::nullNode;
+		return;
+	}
+
+	// Descend the tree to find the best sibling for the leaf, by comparing the cost (growth in perimeter) of pairing the leaf with the 
+	// current node against the lowest cost that descending into either of its children could have
+	const BoundingBox leafBox = this->nodes[leafIndex].fatBox;
+	int32_t siblingIndex = this->rootNode;
+
+	while (this->nodes[siblingIndex].height > 0)
+	{
+		const TreeNode& node = this->nodes[siblingIndex];
+
+		const float combinedPerimeter = AABBTree::GetPerimeter(AABBTree::CombineBoxes(node.fatBox, leafBox));
+		const float pairingCost = 2.0f * combinedPerimeter;
+		const float inheritedCost = 2.0f * (combinedPerimeter - AABBTree::GetPerimeter(node.fatBox));
+
+		auto getDescendingCost = [&](int32_t childIndex)
+		{
+			const TreeNode& child = this->nodes[childIndex];
+			const float childCombinedPerimeter = AABBTree::GetPerimeter(AABBTree::CombineBoxes(child.fatBox, leafBox));
+
+			return child.height == 0 ? childCombinedPerimeter + inheritedCost : 
+				(childCombinedPerimeter - AABBTree::GetPerimeter(child.fatBox)) + inheritedCost;
+		};
+
+		const float firstChildCost = getDescendingCost(node.firstChild);
+		const float secondChildCost = getDescendingCost(node.secondChild);
+
+		if (pairingCost < firstChildCost && pairingCost < secondChildCost)
+			break;
+
+		siblingIndex = firstChildCost < secondChildCost ? node.firstChild : node.secondChild;
+	}
+
+	// Create a new parent node for the sibling and the leaf
+	const int32_t oldParentIndex = this->nodes[siblingIndex].parent;
+	const int32_t newParentIndex = this->AllocateNode();
+
+	TreeNode& newParent = this->nodes[newParentIndex];
+	newParent.parent = oldParentIndex;
+	newParent.fatBox = AABBTree::CombineBoxes(leafBox, this->nodes[siblingIndex].fatBox);
+	newParent.height = this->nodes[siblingIndex].height + 1;
+	newParent.firstChild = siblingIndex;
+	newParent.secondChild = leafIndex;
+
+	if (oldParentIndex != AABBTreeGlobals::nullNode)
+	{
+		TreeNode& oldParent = this->nodes[oldParentIndex];
+		(oldParent.firstChild == siblingIndex ? oldParent.firstChild : oldParent.secondChild) = newParentIndex;
+	}
+	else
+		this->rootNode = newParentIndex;
+
+	this->nodes[siblingIndex].parent = newParentIndex;
+	this->nodes[leafIndex].parent = newParentIndex;
+
+	this->RefitAncestors(this->nodes[leafIndex].parent);
+}
+
+void AABBTree::RemoveLeaf(int32_t leafIndex)
+{
+	if (leafIndex == this->rootNode)
+	{
+		this->rootNode = AABBTreeGlobals::nullNode;
+		return;
+	}
+
+	// The parent of the leaf is removed too, with the sibling of the leaf taking its place
+	const int32_t parentIndex = this->nodes[leafIndex].parent;
+	const int32_t grandParentIndex = this->nodes[parentIndex].parent;
+	const int32_t siblingIndex = this->nodes[parentIndex].firstChild == leafIndex ? this->nodes[parentIndex].secondChild : 
+		this->nodes[parentIndex].firstChild;
+
+	this->nodes[siblingIndex].parent = grandParentIndex;
+	this->FreeNode(parentIndex);
+
+	if (grandParentIndex != AABBTreeGlobals::nullNode)
+	{
+		TreeNode& grandParent = this->nodes[grandParentIndex];
+		(grandParent.firstChild == parentIndex ? grandParent.firstChild : grandParent.secondChild) = siblingIndex;
+
+		this->RefitAncestors(grandParentIndex);
+	}
+	else
+		this->rootNode = siblingIndex;
+}
+
+void AABBTree::RefitAncestors(int32_t nodeIndex)
+{
+	while (nodeIndex != AABBTreeGlobals::nullNode)
+	{
+		nodeIndex = this->Balance(nodeIndex);
+
+		TreeNode& node = this->nodes[nodeIndex];
+		const TreeNode& firstChild = this->nodes[node.firstChild];
+		const TreeNode& secondChild = this->nodes[node.secondChild];
+
+		node.height = 1 + std::max(firstChild.height, secondChild.height);
+		node.fatBox = AABBTree::CombineBoxes(firstChild.fatBox, secondChild.fatBox);
+
+		nodeIndex = node.parent;
+	}
+}
+
+int32_t AABBTree::Balance(int32_t nodeIndex)
+{
+	TreeNode& node = this->nodes[nodeIndex];
+	if (node.height < 2)
+		return nodeIndex;
+
+	const int32_t firstIndex = node.firstChild, secondIndex = node.secondChild;
+	TreeNode& first = this->nodes[firstIndex];
+	TreeNode& second = this->nodes[secondIndex];
+
+	const int balance = second.height - first.height;
+	if (balance >= -1 && balance <= 1)
+		return nodeIndex;
+
+	// Rotate the taller child up into the place of the node, the node then takes the place of the shorter grandchild under the taller 
+	// child, and the taller grandchild stays under the taller child
+	const bool secondIsTaller = balance > 1;
+	const int32_t tallIndex = secondIsTaller ? secondIndex : firstIndex;
+	const int32_t shortIndex = secondIsTaller ? firstIndex : secondIndex;
+	TreeNode& tall = this->nodes[tallIndex];
+	const TreeNode& shortChild = this->nodes[shortIndex];
+
+	const int32_t tallGrandchildIndex = this->nodes[tall.firstChild].height > this->nodes[tall.secondChild].height ? 
+		tall.firstChild : tall.secondChild;
+	const int32_t shortGrandchildIndex = tallGrandchildIndex == tall.firstChild ? tall.secondChild : tall.firstChild;
+	TreeNode& tallGrandchild = this->nodes[tallGrandchildIndex];
+	TreeNode& shortGrandchild = this->nodes[shortGrandchildIndex];
+
+	// Swap the taller child with the node
+	tall.firstChild = nodeIndex;
+	tall.secondChild = tallGrandchildIndex;
+	tall.parent = node.parent;
+	node.parent = tallIndex;
+
+	if (tall.parent != AABBTreeGlobals::nullNode)
+	{
+		TreeNode& parent = this->nodes[tall.parent];
+		(parent.firstChild == nodeIndex ? parent.firstChild : parent.secondChild) = tallIndex;
+	}
+	else
+		this->rootNode = tallIndex;
+
+	// The node keeps its shorter child, and adopts the shorter grandchild in place of the taller child
+	(secondIsTaller ? node.secondChild : node.firstChild) = shortGrandchildIndex;
+	shortGrandchild.parent = nodeIndex;
+	tallGrandchild.parent = tallIndex;
+
+	node.fatBox = AABBTree::CombineBoxes(shortChild.fatBox, shortGrandchild.fatBox);
+	node.height = 1 + std::max(shortChild.height, shortGrandchild.height);
+	tall.fatBox = AABBTree::CombineBoxes(node.fatBox, tallGrandchild.fatBox);
+	tall.height = 1 + std::max(node.height, tallGrandchild.height);
+
+	return tallIndex;
+}
+
+AABBTree::BoundingBox AABBTree::CombineBoxes(const BoundingBox& first, const BoundingBox& second)
+{
+	return { glm::min(first.min, second.min), glm::max(first.max, second.max) };
+}
+
+float AABBTree::GetPerimeter(const BoundingBox& box)
+{
+	return 2.0f * ((box.max.x - box.min.x) + (box.max.y - box.min.y));
+}
+
+bool AABBTree::AreOverlapping(const BoundingBox& first, const BoundingBox& second)
+{
+	return first.min.x <= second.max.x && first.max.x >= second.min.x && first.min.y <= second.max.y && first.max.y >= second.min.y;
+}
+
+AABBTree::BoundingBox AABBTree::GetColliderBox(const RectangleCollider& collider)
+{
+	return { { collider.GetLeftSidePosition(), collider.GetTopSidePosition() }, 
+		{ collider.GetRightSidePosition(), collider.GetBottomSidePosition() } };
+}
+
+RectangleCollider AABBTree::GetBoxCollider(const BoundingBox& box)
+{
+	return RectangleCollider((box.min + box.max) / 2.0f, box.max - box.min);
+}
+
+int32_t AABBTree::CreateProxy(const RectangleCollider& collider, ColliderHandle userData)
+{
+	const int32_t leafIndex = this->AllocateNode();
+	TreeNode& leaf = this->nodes[leafIndex];
+	leaf.colliderBox = AABBTree::GetColliderBox(collider);
+	leaf.fatBox = { leaf.colliderBox.min - glm::vec2(this->fatMargin), leaf.colliderBox.max + glm::vec2(this->fatMargin) };
+	leaf.userData = userData;
+
+	this->InsertLeaf(leafIndex);
+	this->numLeaves++;
+
+	return leafIndex;
+}
+
+void AABBTree::DestroyProxy(int32_t proxy)
+{
+	this->RemoveLeaf(proxy);
+	this->FreeNode(proxy);
+	this->numLeaves--;
+}
+
+bool AABBTree::MoveProxy(int32_t proxy, const RectangleCollider& collider)
+{
+	TreeNode& leaf = this->nodes[proxy];
+	leaf.colliderBox = AABBTree::GetColliderBox(collider);
+
+	// As long as the collider stays within its fattened box, the tree doesn't need to change
+	if (leaf.fatBox.min.x <= leaf.colliderBox.min.x && leaf.fatBox.min.y <= leaf.colliderBox.min.y &&
+		leaf.fatBox.max.x >= leaf.colliderBox.max.x && leaf.fatBox.max.y >= leaf.colliderBox.max.y)
+	{
+		return false;
+	}
+
+	this->RemoveLeaf(proxy);
+	leaf.fatBox = { leaf.colliderBox.min - glm::vec2(this->fatMargin), leaf.colliderBox.max + glm::vec2(this->fatMargin) };
+	this->InsertLeaf(proxy);
+
+	return true;
+}
+
+void AABBTree::InsertCollider(ColliderHandle handle, const RectangleCollider& collider)
+{
+	if (handle >= this->handleProxies.size())
+		this->handleProxies.resize((size_t)handle + 1, AABBTreeGlobals::nullNode);
+
+	if (this->handleProxies[handle] != AABBTreeGlobals::nullNode)
+		this->DestroyProxy(this->handleProxies[handle]);
+
+	this->handleProxies[handle] = this->CreateProxy(collider, handle);
+}
+
+bool AABBTree::UpdateCollider(ColliderHandle handle, const RectangleCollider& collider)
+{
+	const int32_t proxy = this->GetProxy(handle);
+	return proxy != AABBTreeGlobals::nullNode && this->MoveProxy(proxy, collider);
+}
+
+void AABBTree::RemoveCollider(ColliderHandle handle)
+{
+	const int32_t proxy = this->GetProxy(handle);
+	if (proxy == AABBTreeGlobals::nullNode)
+		return;
+
+	this->DestroyProxy(proxy);
+	this->handleProxies[handle] = AABBTreeGlobals::nullNode;
+}
+
+int32_t AABBTree::GetProxy(ColliderHandle handle) const
+{
+	return handle < this->handleProxies.size() ? this->handleProxies[handle] : AABBTreeGlobals::nullNode;
+}
+
+const std::vector<ColliderOverlap>& AABBTree::QueryOverlaps(const RectangleCollider& box)
+{
+	this->overlapResults.clear();
+	if (this->rootNode == AABBTreeGlobals::nullNode)
+		return this->overlapResults;
+
+	const BoundingBox queryBox = AABBTree::GetColliderBox(box);
+	this->traversalStack.clear();
+	this->traversalStack.emplace_back(this->rootNode);
+
+	while (!this->traversalStack.empty())
+	{
+		const TreeNode& node = this->nodes[this->traversalStack.back()];
+		this->traversalStack.pop_back();
+
+		if (!AABBTree::AreOverlapping(node.fatBox, queryBox))
+			continue;
+
+		if (node.height == 0)
+		{
+			// The narrow phase is ran against the actual collider box, not the fattened one
+			const CollidingSide side = AABBTree::GetBoxCollider(node.colliderBox).IsColliding(box);
+			if (side != CollidingSide::NONE)
+				this->overlapResults.push_back({ node.userData, side });
+		}
+		else
+		{
+			this->traversalStack.emplace_back(node.firstChild);
+			this->traversalStack.emplace_back(node.secondChild);
+		}
+	}
+
+	return this->overlapResults;
+}
+
+const std::vector<RaycastHit>& AABBTree::QueryRay(const glm::vec2& origin, const glm::vec2& direction, float maxDistance)
+{
+	this->raycastResults.clear();
+
+	const float directionLength = glm::length(direction);
+	if (this->rootNode == AABBTreeGlobals::nullNode || directionLength <= 0.0f || maxDistance <= 0.0f)
+		return this->raycastResults;
+
+	const glm::vec2 rayDirection = direction / directionLength;
+	this->traversalStack.clear();
+	this->traversalStack.emplace_back(this->rootNode);
+
+	while (!this->traversalStack.empty())
+	{
+		const TreeNode& node = this->nodes[this->traversalStack.back()];
+		this->traversalStack.pop_back();
+
+		// Only descend into the nodes the ray passes through, the fattened boxes are grown slightly so that rays grazing their edges 
+		// still descend into them
+		const BoundingBox& testedBox = node.height == 0 ? node.colliderBox : node.fatBox;
+		const RectangleCollider testedCollider = AABBTree::GetBoxCollider(
+			node.height == 0 ? testedBox : BoundingBox{ testedBox.min - glm::vec2(0.001f), testedBox.max + glm::vec2(0.001f) });
+
+		float hitDistance = 0.0f;
+		CollidingSide hitSide = CollidingSide::NONE;
+		if (!testedCollider.Raycast(origin, rayDirection, maxDistance, hitDistance, hitSide))
+			continue;
+
+		if (node.height == 0)
+			this->raycastResults.push_back({ node.userData, hitDistance, origin + (rayDirection * hitDistance), hitSide });
+		else
+		{
+			this->traversalStack.emplace_back(node.firstChild);
+			this->traversalStack.emplace_back(node.secondChild);
+		}
+	}
+
+	std::sort(this->raycastResults.begin(), this->raycastResults.end(),
+		[](const RaycastHit& first, const RaycastHit& second) { return first.distance < second.distance; });
+
+	return this->raycastResults;
+}
+
+const ColliderHandle& AABBTree::GetUserData(int32_t proxy) const
+{
+	return this->nodes[proxy].userData;
+}
+
+AABBTreeMetrics AABBTree::GetMetrics() const
+{
+	AABBTreeMetrics metrics;
+	metrics.numLeaves = this->numLeaves;
+	if (this->rootNode == AABBTreeGlobals::nullNode)
+		return metrics;
+
+	metrics.height = this->nodes[this->rootNode].height;
+
+	float totalPerimeter = 0.0f;
+	for (const TreeNode& node : this->nodes)
+	{
+		if (node.height < 0)
+			continue;
+
+		metrics.numNodes++;
+		if (node.height > 0)
+		{
+			totalPerimeter += AABBTree::GetPerimeter(node.fatBox);
+			metrics.maxBalance = std::max(metrics.maxBalance, 
+				std::abs(this->nodes[node.secondChild].height - this->nodes[node.firstChild].height));
+		}
+	}
+
+	const float rootPerimeter = AABBTree::GetPerimeter(this->nodes[this->rootNode].fatBox);
+	metrics.costSAH = rootPerimeter > 0.0f ? totalPerimeter / rootPerimeter : 0.0f;
+
+	return metrics;
+}
+
+const size_t& AABBTree::GetNumLeaves() const
+{
+	return this->numLeaves;
+}
@@ -0,0 +1,136 @@
+#ifndef AABB_TREE_H
+#define AABB_TREE_H
+
+#include <core/collision_detection.h>
+#include <core/collision_world.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace AABBTreeGlobals
+{
+	constexpr int32_t nullNode = -1;
+}
+
+// Measurements of how well the AABB tree is balanced.
+struct AABBTreeMetrics
+{
+	int height = 0; // The number of levels below the root node
+	int maxBalance = 0; // The largest height difference between the two children of any node
+	size_t numLeaves = 0, numNodes = 0;
+	float costSAH = 0.0f; // The sum of the perimeters of the internal nodes relative to the perimeter of the root node
+};
+
+// A dynamic bounding volume tree, the leaves hold the fattened boxes of the colliders inserted and every internal node holds the box 
+// bounding its two children. Queries only descend into the nodes their box touches, so colliders of very different sizes are handled 
+// well. The tree is kept balanced with rotations as leaves are inserted and removed.
+class AABBTree
+{
+private:
+	struct BoundingBox
+	{
+		glm::vec2 min, max;
+	};
+
+	struct TreeNode
+	{
+		BoundingBox fatBox; // The box used by the tree, for leaves this is the collider box grown by the fat margin
+		BoundingBox colliderBox; // Only used by leaves
+		int32_t parent; // When the node is in the free list, this is the next free node instead
+		int32_t firstChild, secondChild;
+		int height; // Leaves are at height 0, and free nodes are at height -1
+		ColliderHandle userData;
+	};
+private:
+	std::vector<TreeNode> nodes;
+	int32_t rootNode, freeList;
+	size_t numLeaves;
+	float fatMargin;
+
+	std::vector<int32_t> handleProxies; // The proxy of every collider inserted by handle, indexed by the handle
+
+	std::vector<int32_t> traversalStack;
+	std::vector<ColliderOverlap> overlapResults;
+	std::vector<RaycastHit> raycastResults;
+private:
+	// Returns the index of a node taken from the free list, the node pool is grown if the free list is empty.
+	int32_t AllocateNode();
+
+	// Returns the node at the index given to the free list.
+	void FreeNode(int32_t nodeIndex);
+
+	// Inserts the leaf node given into the tree, next to the node where it adds the least to the perimeter of the tree.
+	void InsertLeaf(int32_t leafIndex);
+
+	// Removes the leaf node given from the tree, the node itself isn't freed.
+	void RemoveLeaf(int32_t leafIndex);
+
+	// Rotates the subtree at the node given if it's imbalanced.
+	// Returns the index of the node now at the top of the subtree.
+	int32_t Balance(int32_t nodeIndex);
+
+	// Refits the box and height of every node from the node given up to the root, balancing them on the way.
+	void RefitAncestors(int32_t nodeIndex);
+
+	// Returns the box bounding the two boxes given.
+	static BoundingBox CombineBoxes(const BoundingBox& first, const BoundingBox& second);
+
+	// Returns the perimeter of the box given.
+	static float GetPerimeter(const BoundingBox& box);
+
+	// Returns TRUE if the two boxes given overlap (touching counts), else FALSE is returned.
+	static bool AreOverlapping(const BoundingBox& first, const BoundingBox& second);
+
+	// Returns the box of the collider given.
+	static BoundingBox GetColliderBox(const RectangleCollider& collider);
+
+	// Returns the collider with the box given.
+	static RectangleCollider GetBoxCollider(const BoundingBox& box);
+public:
+	AABBTree(float fatMargin = 4.0f);
+	~AABBTree() = default;
+
+	// Inserts the collider given into the tree, the user data given is returned by the queries which find it.
+	// Returns the proxy used to refer to the collider in the tree.
+	int32_t CreateProxy(const RectangleCollider& collider, ColliderHandle userData);
+
+	// Removes the proxy given from the tree.
+	void DestroyProxy(int32_t proxy);
+
+	// Updates the proxy given to the collider given. The tree is only restructured if the collider moved out of its fattened box.
+	// Returns TRUE if the tree was restructured, else FALSE is returned.
+	bool MoveProxy(int32_t proxy, const RectangleCollider& collider);
+
+	// Inserts the collider given into the tree under the handle given, which the queries return as the user data of the collider.
+	// If there's already a collider under the handle, it's replaced by the collider given.
+	void InsertCollider(ColliderHandle handle, const RectangleCollider& collider);
+
+	// Refits the tree to the collider given, which replaces the collider under the handle given.
+	// Returns TRUE if the tree was restructured, else FALSE is returned.
+	bool UpdateCollider(ColliderHandle handle, const RectangleCollider& collider);
+
+	// Removes the collider under the handle given from the tree, if there is one.
+	void RemoveCollider(ColliderHandle handle);
+
+	// Returns the proxy of the collider under the handle given, or a null node if there isn't one.
+	int32_t GetProxy(ColliderHandle handle) const;
+
+	// Returns the colliders overlapping the box given, with the user data they were inserted with.
+	// The results are stored in a buffer reused by every overlap query, so they're only valid until the next one.
+	const std::vector<ColliderOverlap>& QueryOverlaps(const RectangleCollider& box);
+
+	// Returns the colliders hit by the ray given within the maximum distance given, sorted from nearest to furthest.
+	// The results are stored in a buffer reused by every ray query, so they're only valid until the next one.
+	const std::vector<RaycastHit>& QueryRay(const glm::vec2& origin, const glm::vec2& direction, float maxDistance);
+
+	// Returns the user data of the proxy given.
+	const ColliderHandle& GetUserData(int32_t proxy) const;
+
+	// Returns the measurements of how well the tree is balanced, every node in the tree is visited to calculate them.
+	AABBTreeMetrics GetMetrics() const;
+
+	// Returns the number of colliders in the tree.
+	const size_t& GetNumLeaves() const;
+};
+
+#endif
@@ -1,49 +1,140 @@
 #include <core/application_core.h>
 #include <core/game_state.h>
 #include <core/input_system.h>
+#include <core/audio_system.h>
+#include <core/latency_tracker.h>
 #include <graphics/renderer.h>
 #include <serialization/config.h>
 #include <util/directory_system.h>
+#include <util/logging_system.h>
+#include <util/allocation_counter.h>
 #include <util/timestamp.h>
 #include <states/intro_screen.h>
 
-ApplicationCore::ApplicationCore()
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+
+namespace ApplicationGlobals
 {
+	constexpr double timeStep = 0.001;
+
+	// How long the suspended main loop sleeps for at most before checking the window state again (in seconds)
+	constexpr double suspendedWaitTimeout = 0.5;
+
+	// Used when the config file was generated before the background settings were added
+	constexpr int defaultBackgroundFrameRate = 10;
+	constexpr bool defaultPauseAudioInBackground = true;
+
+	// Used when the config file was generated before the frame pacing settings were added
+	constexpr bool defaultAdaptiveVsync = true;
+	constexpr int defaultMaxFramesInFlight = 1;
+}
+
+ApplicationCore::ApplicationCore(int argc, char** argv) :
+	backgroundFrameRate(0), pauseAudioInBackground(false)
+{
+	const LaunchOptions options = ApplicationCore::ParseLaunchOptions(argc, argv);
+
 	// Generate a new default config file if it doesn't exist
 	if (!Util::IsExistingFile(Util::GetGameRequisitesDirectory() + "data/config.json"))
 		Serialization::GenerateConfigFile();
 
-	// Retrieve the window config settings
-	const int width = Serialization::GetConfigElement<int>("window", "width");
-	const int height = Serialization::GetConfigElement<int>("window", "height");
-	const bool enableVsync = Serialization::GetConfigElement<int>("window", "vsync");
-	const bool resizable = Serialization::GetConfigElement<int>("window", "resizable");
-	const bool fullscreen = Serialization::GetConfigElement<int>("window", "fullscreen");
+	// Headless runs are backed by the null devices, so no window, OpenGL context or audio device is created
+	const SystemBackend backend = options.headlessSteps > 0 ? SystemBackend::NULL_DEVICE : SystemBackend::HARDWARE;
+
+	if (backend == SystemBackend::HARDWARE)
+	{
+		// Retrieve the window config settings
+		const int width = Serialization::GetConfigElement<int>("window", "width");
+		const int height = Serialization::GetConfigElement<int>("window", "height");
+		const bool enableVsync = Serialization::GetConfigElement<int>("window", "vsync");
+		const bool resizable = Serialization::GetConfigElement<int>("window", "resizable");
+		const bool fullscreen = Serialization::GetConfigElement<int>("window", "fullscreen");
+		const bool enableAdaptiveVsync = Serialization::GetConfigElement<bool>("window", "adaptiveVsync", 
+			ApplicationGlobals::defaultAdaptiveVsync);
+		const int maxFramesInFlight = Serialization::GetConfigElement<int>("window", "maxFramesInFlight", 
+			ApplicationGlobals::defaultMaxFramesInFlight);
+		this->backgroundFrameRate = std::max(Serialization::GetConfigElement<int>("window", "backgroundFrameRate", 
+			ApplicationGlobals::defaultBackgroundFrameRate), 0);
+		this->pauseAudioInBackground = Serialization::GetConfigElement<bool>("window", "pauseAudioInBackground", 
+			ApplicationGlobals::defaultPauseAudioInBackground);
 
-	// Create the game window
-	this->window = Memory::CreateWindowFrame("Square Run", width, height, fullscreen, resizable, enableVsync);
+		// Create the game window
+		this->window = Memory::CreateWindowFrame("Square Run", width, height, fullscreen, resizable, enableVsync, 
+			enableAdaptiveVsync, maxFramesInFlight);
+	}
 	
-	// Initialize the input system
-	InputSystem::GetInstance().Init(this->window);
-	Renderer::GetInstance().Init(this->window);
+	// Initialize the input system, renderer, audio system and the replay system (if a replay is being recorded or played back)
+	InputSystem::GetInstance().Init(this->window, backend);
+	Renderer::GetInstance().Init(this->window, backend);
+	AudioSystem::GetInstance().Init(backend);
+	ReplaySystem::GetInstance().Init(options.replayMode, options.replayFilePath);
+
+	// Replayed events carry the timestamps of the recording session, so latency is only tracked for live input
+	LatencyTracker::GetInstance().SetEnabled(backend == SystemBackend::HARDWARE && options.replayMode != ReplayMode::REPLAYING);
 
 	// Continue onto the game's main loop with the splash screen game state being the first game state ran
 	GameStateSystem::GetInstance().SwitchState(IntroScreen::GetGameState());
-	this->MainLoop();
+	backend == SystemBackend::HARDWARE ? this->MainLoop() : this->HeadlessLoop(options.headlessSteps);
+}
+
+LaunchOptions ApplicationCore::ParseLaunchOptions(int argc, char** argv)
+{
+	LaunchOptions options;
+
+	for (int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		const std::string argument = argv[argIndex];
+		const bool hasValue = argIndex + 1 < argc;
+
+		if (argument == "--record" && hasValue)
+		{
+			options.replayMode = ReplayMode::RECORDING;
+			options.replayFilePath = argv[++argIndex];
+		}
+		else if (argument == "--replay" && hasValue)
+		{
+			options.replayMode = ReplayMode::REPLAYING;
+			options.replayFilePath = argv[++argIndex];
+		}
+		else if (argument == "--headless" && hasValue)
+		{
+			options.headlessSteps = std::strtoull(argv[++argIndex], nullptr, 10);
+		}
+		else
+			LogSystem::GetInstance().OutputLog("Ignoring unknown launch option: " + argument, Severity::WARNING);
+	}
+
+	return options;
 }
 
 void ApplicationCore::MainLoop()
 {
-	constexpr double timeStep = 0.001;
+	constexpr double timeStep = ApplicationGlobals::timeStep;
 	double accumulatedRenderTime = 0.0, elapsedRenderTime = 0.0;
 
-	while (!this->window->WasRequestedExit() && GameStateSystem::GetInstance().IsActive())
+	while (!this->window->WasRequestedExit() && GameStateSystem::GetInstance().IsActive() && 
+		!ReplaySystem::GetInstance().IsFinished())
 	{
+		const bool inBackground = !this->window->IsFocused() || this->window->IsIconified();
+		if (this->pauseAudioInBackground)
+			AudioSystem::GetInstance().SetAllPaused(inBackground);
+
+		// While minimised (or unfocused with no background frame rate), nothing is updated or rendered, so just sleep until an
+		// event arrives from the window. The time spent suspended is discarded, so the game resumes where it was left.
+		if (this->window->IsIconified() || (inBackground && this->backgroundFrameRate == 0))
+		{
+			this->window->WaitEvents(ApplicationGlobals::suspendedWaitTimeout);
+			elapsedRenderTime = 0.0;
+			continue;
+		}
+
 		// Update the game logic
 		accumulatedRenderTime += elapsedRenderTime;
 		while (accumulatedRenderTime >= timeStep)
 		{
-			this->Update(timeStep);
+			this->Update(timeStep, Util::GetSecondsSinceEpoch());
 			accumulatedRenderTime -= timeStep;
 		}
 
@@ -53,14 +144,80 @@ void ApplicationCore::MainLoop()
 		this->Render();
 		this->window->Refresh();
 
+		// In the background, sleep off the rest of the frame interval instead of rendering the next frame straight away.
+		// Window events wake the loop early, so keep waiting until the interval is over or the window comes back into focus.
+		if (inBackground)
+		{
+			const double nextFrameTime = preRenderTime + (1.0 / this->backgroundFrameRate);
+			for (double currentTime = Util::GetSecondsSinceEpoch(); currentTime < nextFrameTime && !this->window->IsFocused() && 
+				!this->window->IsIconified() && !this->window->WasRequestedExit(); currentTime = Util::GetSecondsSinceEpoch())
+			{
+				this->window->WaitEvents(nextFrameTime - currentTime);
+			}
+		}
+
 		const double postRenderTime = Util::GetSecondsSinceEpoch();
 		elapsedRenderTime = postRenderTime - preRenderTime;
 	}
+
+	AudioSystem::GetInstance().SetAllPaused(false);
+	ReplaySystem::GetInstance().Stop();
+	LatencyTracker::GetInstance().OutputReport();
+
+	LogSystem::GetInstance().OutputLog("Average frame queue depth: " + std::to_string(this->window->GetAverageFrameQueueDepth()) +
+		" (max frames in flight: " + (this->window->GetMaxFramesInFlight() > 0 ? 
+		std::to_string(this->window->GetMaxFramesInFlight()) : std::string("unlimited")) + ")", Severity::INFO);
+}
+
+void ApplicationCore::HeadlessLoop(uint64_t numSteps)
+{
+	constexpr double timeStep = ApplicationGlobals::timeStep;
+
+	GameStateSystem::GetInstance().SetUpdateProfiling(true);
+	const uint64_t preLoopAllocations = Util::GetAllocationCount();
+	const auto preLoopTime = std::chrono::steady_clock::now();
+
+	// There is no wall clock worth sampling when running as fast as possible, so the simulation time is derived from the step count
+	uint64_t numStepsRan = 0;
+	while (numStepsRan < numSteps && GameStateSystem::GetInstance().IsActive() && !ReplaySystem::GetInstance().IsFinished())
+	{
+		this->Update(timeStep, (double)numStepsRan * timeStep);
+		numStepsRan++;
+	}
+
+	const auto postLoopTime = std::chrono::steady_clock::now();
+	const uint64_t numAllocations = Util::GetAllocationCount() - preLoopAllocations;
+	const double elapsedSeconds = std::chrono::duration<double>(postLoopTime - preLoopTime).count();
+
+	ReplaySystem::GetInstance().Stop();
+	GameStateSystem::GetInstance().SetUpdateProfiling(false);
+
+	// Report the simulation throughput and the update cost of each game state
+	LogSystem::GetInstance().OutputLog("Headless run: " + std::to_string(numStepsRan) + " steps in " + 
+		std::to_string(elapsedSeconds) + "s (" + std::to_string(elapsedSeconds > 0.0 ? numStepsRan / elapsedSeconds : 0.0) +
+		" steps/s)", Severity::INFO);
+
+#ifdef _COUNT_ALLOCATIONS
+	LogSystem::GetInstance().OutputLog("Headless run: " + std::to_string(numAllocations) + " allocations (" +
+		std::to_string(numStepsRan > 0 ? (double)numAllocations / numStepsRan : 0.0) + " per step)", Severity::INFO);
+#endif
+
+	for (const auto& [stateType, profile] : GameStateSystem::GetInstance().GetUpdateProfiles())
+	{
+		LogSystem::GetInstance().OutputLog("Headless run: " + std::string(stateType.name()) + " updated " + 
+			std::to_string(profile.numUpdates) + " times, " + std::to_string(profile.totalSeconds * 1e6 / profile.numUpdates) + 
+			"us per update", Severity::INFO);
+	}
 }
 
-void ApplicationCore::Update(const double& deltaTime)
+void ApplicationCore::Update(const double& deltaTime, double stepTime)
 {
+	ReplaySystem::GetInstance().BeginStep(stepTime);
+	InputSystem::GetInstance().Update();
 	GameStateSystem::GetInstance().Update(deltaTime);
+	AudioSystem::GetInstance().Update(deltaTime);
+	ReplaySystem::GetInstance().EndStep();
+	LatencyTracker::GetInstance().OnStepEnd();
 }
 
 void ApplicationCore::Render() const
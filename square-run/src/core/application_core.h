@@ -2,22 +2,42 @@
 #define APPLICATION_CORE_H
 
 #include <core/window_frame.h>
+#include <core/replay_system.h>
+#include <string>
+
+struct LaunchOptions
+{
+	ReplayMode replayMode = ReplayMode::DISABLED;
+	std::string replayFilePath;
+	uint64_t headlessSteps = 0; // When non-zero, the game runs headless for this many simulation steps
+};
 
 class ApplicationCore
 {
 private:
 	WindowFramePtr window;
+	int backgroundFrameRate; // The frame rate while the window is unfocused, if zero then the game is suspended instead
+	bool pauseAudioInBackground;
 private:
+	// Returns the launch options parsed from the command line arguments given.
+	static LaunchOptions ParseLaunchOptions(int argc, char** argv);
+
 	// The main loop where the game is updated and rendered per loop.
+	// While the window is unfocused the loop is throttled down to the background frame rate, and while it's minimised the game is 
+	// suspended entirely, sleeping until the window is restored.
 	void MainLoop();
 
-	// Updates the current game logic.
-	void Update(const double& deltaTime);
+	// Advances the game logic as fast as possible for the number of steps given, without rendering anything.
+	// Once finished, the simulation throughput, update cost of each game state and number of allocations made are reported.
+	void HeadlessLoop(uint64_t numSteps);
+
+	// Updates the current game logic, the step time given is the time the simulation step is sampled at.
+	void Update(const double& deltaTime, double stepTime);
 
 	// Renders the game scene.
 	void Render() const;
 public:
-	ApplicationCore();
+	ApplicationCore(int argc, char** argv);
 	~ApplicationCore() = default;
 };
 
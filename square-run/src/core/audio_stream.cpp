@@ -0,0 +1,509 @@
+#include <core/audio_stream.h>
+#include <util/logging_system.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cctype>
+
+namespace
+{
+	// Returns TRUE if the chunk id read matches the id given, else FALSE is returned.
+	bool IsChunkId(const char* chunkId, const char* expectedId)
+	{
+		return std::memcmp(chunkId, expectedId, 4) == 0;
+	}
+
+	// Returns TRUE if the file name given ends with the stream extension, else FALSE is returned.
+	bool HasStreamExtension(const std::string_view& fileName)
+	{
+		return fileName.size() > AudioStreamGlobals::streamExtension.size() &&
+			fileName.substr(fileName.size() - AudioStreamGlobals::streamExtension.size()) == AudioStreamGlobals::streamExtension;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StreamedTrack::SetLoopRegion(uint32_t startFrame, uint32_t endFrame)
+{
+	this->loopRegion.store(((uint64_t)startFrame << 32) | endFrame, std::memory_order_relaxed);
+}
+
+void StreamedTrack::GetLoopRegion(int32_t numFrames, int32_t& startFrame, int32_t& endFrame) const
+{
+	const uint64_t region = this->loopRegion.load(std::memory_order_relaxed);
+	endFrame = (uint32_t)region == 0 ? numFrames : (int32_t)std::min<uint64_t>((uint32_t)region, (uint64_t)numFrames);
+	startFrame = (int32_t)std::min<uint64_t>(region >> 32, (uint64_t)endFrame);
+
+	// An empty loop body can't be looped, so loop the whole file instead
+	if (startFrame == endFrame)
+	{
+		startFrame = 0;
+		endFrame = numFrames;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+WaveDecoder::WaveDecoder(irrklang::IFileReader* file) :
+	file(file), format(), bitsPerSample(0), bytesPerFrame(0), dataOffset(0), numFrames(0), framePosition(0)
+{}
+
+bool WaveDecoder::ReadHeader()
+{
+	char riffHeader[12] = {};
+	if (this->file->read(riffHeader, sizeof(riffHeader)) != sizeof(riffHeader) || !IsChunkId(riffHeader, "RIFF") ||
+		!IsChunkId(riffHeader + 8, "WAVE"))
+	{
+		return false;
+	}
+
+	// Walk through the chunks until the data chunk is found, the format chunk always comes before it
+	bool foundFormat = false;
+	char chunkHeader[8] = {};
+	while (this->file->read(chunkHeader, sizeof(chunkHeader)) == sizeof(chunkHeader))
+	{
+		uint32_t chunkSize = 0;
+		std::memcpy(&chunkSize, chunkHeader + 4, sizeof(chunkSize));
+
+		if (IsChunkId(chunkHeader, "fmt "))
+		{
+			uint8_t formatChunk[16] = {};
+			if (chunkSize < sizeof(formatChunk) || this->file->read(formatChunk, sizeof(formatChunk)) != sizeof(formatChunk))
+				return false;
+
+			uint16_t formatTag = 0, numChannels = 0, blockAlign = 0, bitsPerSample = 0;
+			uint32_t sampleRate = 0;
+			std::memcpy(&formatTag, formatChunk, 2);
+			std::memcpy(&numChannels, formatChunk + 2, 2);
+			std::memcpy(&sampleRate, formatChunk + 4, 4);
+			std::memcpy(&blockAlign, formatChunk + 12, 2);
+			std::memcpy(&bitsPerSample, formatChunk + 14, 2);
+
+			// Only plain (or extensible) integer PCM of 8 or 16 bits is supported
+			constexpr uint16_t formatPCM = 1, formatExtensible = 0xFFFE;
+			if ((formatTag != formatPCM && formatTag != formatExtensible) || (bitsPerSample != 8 && bitsPerSample != 16) ||
+				numChannels == 0 || blockAlign != numChannels * (bitsPerSample / 8))
+			{
+				return false;
+			}
+
+			this->format.ChannelCount = numChannels;
+			this->format.SampleRate = (irrklang::ik_s32)sampleRate;
+			this->format.SampleFormat = irrklang::ESF_S16;
+			this->bitsPerSample = bitsPerSample;
+			this->bytesPerFrame = blockAlign;
+			foundFormat = true;
+
+			// Skip the rest of the format chunk, chunks are padded to an even size
+			this->file->seek((chunkSize - sizeof(formatChunk)) + (chunkSize & 1), true);
+		}
+		else if (IsChunkId(chunkHeader, "data"))
+		{
+			if (!foundFormat)
+				return false;
+
+			this->dataOffset = this->file->getPos();
+			this->numFrames = (int32_t)(std::min<uint32_t>(chunkSize, this->file->getSize() - this->dataOffset) / this->bytesPerFrame);
+			this->format.FrameCount = this->numFrames;
+			this->framePosition = 0;
+			return true;
+		}
+		else
+		{
+			this->file->seek(chunkSize + (chunkSize & 1), true);
+		}
+	}
+
+	return false;
+}
+
+uint32_t WaveDecoder::DecodeFrames(int16_t* samples, uint32_t frameCount)
+{
+	frameCount = std::min(frameCount, (uint32_t)(this->numFrames - this->framePosition));
+	if (frameCount == 0)
+		return 0;
+
+	// The file's frames are read straight into the samples array, as the 8-bit samples take up no more room than the 16-bit ones
+	const irrklang::ik_s32 bytesRead = this->file->read(samples, frameCount * this->bytesPerFrame);
+	frameCount = bytesRead > 0 ? (uint32_t)bytesRead / this->bytesPerFrame : 0;
+
+	if (this->bitsPerSample == 8)
+	{
+		// Widen the unsigned 8-bit samples from the back, so no sample is overwritten before it's been widened
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(samples);
+		for (size_t sampleIndex = (size_t)frameCount * this->format.ChannelCount; sampleIndex-- > 0;)
+			samples[sampleIndex] = (int16_t)((bytes[sampleIndex] - 128) << 8);
+	}
+
+	this->framePosition += frameCount;
+	return frameCount;
+}
+
+bool WaveDecoder::Seek(int32_t frame)
+{
+	frame = std::clamp(frame, 0, this->numFrames);
+	if (!this->file->seek(this->dataOffset + frame * (int32_t)this->bytesPerFrame))
+		return false;
+
+	this->framePosition = frame;
+	return true;
+}
+
+const int32_t& WaveDecoder::GetPosition() const
+{
+	return this->framePosition;
+}
+
+const irrklang::SAudioStreamFormat& WaveDecoder::GetFormat() const
+{
+	return this->format;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+AudioStreamFileReader::AudioStreamFileReader(const std::string_view& fileName, const std::string_view& filePath) :
+	file(std::string(filePath), std::ios::binary), fileName(fileName), fileSize(0)
+{
+	if (this->file.is_open())
+	{
+		this->file.seekg(0, std::ios::end);
+		this->fileSize = (irrklang::ik_s32)this->file.tellg();
+		this->file.seekg(0, std::ios::beg);
+	}
+}
+
+irrklang::ik_s32 AudioStreamFileReader::read(void* buffer, irrklang::ik_u32 sizeToRead)
+{
+	this->file.read(static_cast<char*>(buffer), sizeToRead);
+	const irrklang::ik_s32 bytesRead = (irrklang::ik_s32)this->file.gcount();
+
+	// Reaching the end of the file sets the fail bit, which would make every following seek fail
+	this->file.clear();
+	return bytesRead;
+}
+
+bool AudioStreamFileReader::seek(irrklang::ik_s32 finalPos, bool relativeMovement)
+{
+	this->file.seekg(finalPos, relativeMovement ? std::ios::cur : std::ios::beg);
+	return !this->file.fail();
+}
+
+irrklang::ik_s32 AudioStreamFileReader::getSize()
+{
+	return this->fileSize;
+}
+
+irrklang::ik_s32 AudioStreamFileReader::getPos()
+{
+	return (irrklang::ik_s32)this->file.tellg();
+}
+
+const irrklang::ik_c8* AudioStreamFileReader::getFileName()
+{
+	return this->fileName.c_str();
+}
+
+bool AudioStreamFileReader::IsOpen() const
+{
+	return this->file.is_open();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+irrklang::IFileReader* AudioStreamFileFactory::createFileReader(const irrklang::ik_c8* filename)
+{
+	const std::string_view streamName = filename;
+	if (!HasStreamExtension(streamName))
+		return nullptr;
+
+	// The stream name is the path of the audio file with the stream extension appended
+	AudioStreamFileReader* reader = new AudioStreamFileReader(streamName,
+		streamName.substr(0, streamName.size() - AudioStreamGlobals::streamExtension.size()));
+
+	if (!reader->IsOpen())
+	{
+		reader->drop();
+		return nullptr;
+	}
+
+	return reader;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+StreamedAudio::StreamedAudio(irrklang::IFileReader* file, StreamedTrackPtr track, uint32_t bufferMilliseconds) :
+	file(file), decoder(file), track(std::move(track)), bufferedSamples(0), numChannels(0), stopping(false),
+	seeksRequested(0), seeksApplied(0), seekFrame(0), seekBoundary(0), endBoundary(UINT64_MAX), samplesPushed(0), samplesPopped(0),
+	finishedDecoding(false)
+{
+	this->file->grab(); // The decoder reads from the file, so increase the ref count to the file
+
+	if (!this->decoder.ReadHeader())
+	{
+		LogSystem::GetInstance().OutputLog("Failed to stream audio file \"" + this->track->filePath +
+			"\", only 8-bit and 16-bit PCM wave files can be streamed", Severity::WARNING);
+		return;
+	}
+
+	// Size the buffer to the depth given, rounded up to a whole number of decode blocks
+	const irrklang::SAudioStreamFormat& format = this->decoder.GetFormat();
+	const size_t bufferFrames = (size_t)format.SampleRate * std::max(bufferMilliseconds, AudioStreamGlobals::minBufferMilliseconds) /
+		1000;
+	const size_t numBlocks = (bufferFrames + AudioStreamGlobals::decodeBlockFrames - 1) / AudioStreamGlobals::decodeBlockFrames;
+
+	this->numChannels = format.ChannelCount;
+	this->decodeBlock.resize((size_t)AudioStreamGlobals::decodeBlockFrames * this->numChannels);
+	this->bufferedSamples = numBlocks * this->decodeBlock.size();
+	this->samples = std::make_unique<RingBuffer<int16_t>>(this->bufferedSamples);
+
+	// Fill the buffer before playback starts reading from it, then leave the decode thread to keep it filled
+	while (this->NeedsRefill())
+		this->DecodeBlock();
+
+	this->decodeThread = std::thread(&StreamedAudio::DecodeLoop, this);
+}
+
+StreamedAudio::~StreamedAudio()
+{
+	if (this->decodeThread.joinable())
+	{
+		this->stopping = true;
+		{
+			std::lock_guard<std::mutex> lock(this->wakeMutex);
+		}
+
+		this->wakeCondition.notify_one();
+		this->decodeThread.join();
+	}
+
+	this->file->drop();
+}
+
+void StreamedAudio::DecodeLoop()
+{
+	// How long the decode thread sleeps for at most, which bounds how late it can be if a wake up is missed
+	const auto sleepTimeout = std::chrono::microseconds((this->bufferedSamples / this->numChannels) * 250000 /
+		this->decoder.GetFormat().SampleRate);
+
+	while (!this->stopping)
+	{
+		this->ApplySeek();
+		while (this->NeedsRefill() && this->seeksApplied == this->seeksRequested)
+			this->DecodeBlock();
+
+		// Sleep until the reader has drained half the buffer or requested a seek. The reader doesn't take the lock to wake the
+		// thread, as it runs on irrKlang's mixing thread, so a wake up can be missed and the sleep is given a timeout.
+		std::unique_lock<std::mutex> lock(this->wakeMutex);
+		this->wakeCondition.wait_for(lock, sleepTimeout, [&]()
+		{
+			return this->stopping || this->seeksApplied != this->seeksRequested ||
+				(!this->finishedDecoding && this->samples->GetSize() <= this->bufferedSamples / 2);
+		});
+	}
+}
+
+void StreamedAudio::DecodeBlock()
+{
+	uint32_t numFrames = 0;
+	while (numFrames < AudioStreamGlobals::decodeBlockFrames)
+	{
+		int16_t* blockSamples = this->decodeBlock.data() + numFrames * this->numChannels;
+		uint32_t numFramesWanted = AudioStreamGlobals::decodeBlockFrames - numFrames;
+
+		if (this->track->looping)
+		{
+			// Jump back to the start of the loop region once its end is reached, the frames are decoded up to the end of it exactly so
+			// the jump lands on the frame
+			int32_t loopStartFrame = 0, loopEndFrame = 0;
+			this->track->GetLoopRegion(this->decoder.GetFormat().FrameCount, loopStartFrame, loopEndFrame);
+
+			if (this->decoder.GetPosition() >= loopEndFrame)
+				this->decoder.Seek(loopStartFrame);
+
+			numFramesWanted = std::min(numFramesWanted, (uint32_t)(loopEndFrame - this->decoder.GetPosition()));
+		}
+
+		const uint32_t numDecodedFrames = this->decoder.DecodeFrames(blockSamples, numFramesWanted);
+		numFrames += numDecodedFrames;
+
+		if (numDecodedFrames == 0 || !this->track->looping)
+			break;
+	}
+
+	this->samplesPushed += this->samples->PushRange(this->decodeBlock.data(), numFrames * this->numChannels);
+	this->track->stats.numDecodedFrames.fetch_add(numFrames, std::memory_order_relaxed);
+
+	if (numFrames < AudioStreamGlobals::decodeBlockFrames)
+	{
+		this->finishedDecoding = true;
+		this->endBoundary.store(this->samplesPushed, std::memory_order_release);
+	}
+}
+
+void StreamedAudio::ApplySeek()
+{
+	const uint32_t seekRequest = this->seeksRequested.load(std::memory_order_acquire);
+	if (seekRequest == this->seeksApplied.load(std::memory_order_relaxed))
+		return;
+
+	this->decoder.Seek(this->seekFrame.load(std::memory_order_relaxed));
+	this->finishedDecoding = false;
+
+	// Everything pushed so far is from before the seek, so the reader skips up to here
+	this->endBoundary.store(UINT64_MAX, std::memory_order_relaxed);
+	this->seekBoundary.store(this->samplesPushed, std::memory_order_relaxed);
+	this->seeksApplied.store(seekRequest, std::memory_order_release);
+}
+
+bool StreamedAudio::NeedsRefill() const
+{
+	return !this->finishedDecoding && this->samples->GetSize() + this->decodeBlock.size() <= this->bufferedSamples;
+}
+
+bool StreamedAudio::IsStreaming() const
+{
+	return this->decodeThread.joinable();
+}
+
+irrklang::SAudioStreamFormat StreamedAudio::getFormat()
+{
+	irrklang::SAudioStreamFormat format = this->decoder.GetFormat();
+
+	// A looping track never runs out of frames, as the decode thread wraps back to the start of the file
+	if (this->track->looping)
+		format.FrameCount = -1;
+
+	return format;
+}
+
+bool StreamedAudio::setPosition(irrklang::ik_s32 pos)
+{
+	this->seekFrame.store(pos, std::memory_order_relaxed);
+	this->seeksRequested.fetch_add(1, std::memory_order_release);
+	this->wakeCondition.notify_one();
+	return true;
+}
+
+irrklang::ik_s32 StreamedAudio::readFrames(void* target, irrklang::ik_s32 frameCountToRead)
+{
+	int16_t* targetSamples = static_cast<int16_t*>(target);
+	const size_t numSamples = (size_t)std::max(frameCountToRead, 0) * this->numChannels;
+	size_t numRead = 0;
+
+	if (this->seeksApplied.load(std::memory_order_acquire) == this->seeksRequested.load(std::memory_order_relaxed))
+	{
+		// Skip the samples decoded before the last seek was applied, using the target as scratch space
+		const uint64_t seekBoundary = this->seekBoundary.load(std::memory_order_relaxed);
+		while (this->samplesPopped < seekBoundary && numSamples > 0)
+		{
+			this->samplesPopped += this->samples->PopRange(targetSamples,
+				(size_t)std::min<uint64_t>(seekBoundary - this->samplesPopped, numSamples));
+		}
+
+		numRead = this->samples->PopRange(targetSamples, numSamples);
+		if (numRead < numSamples)
+		{
+			// The end boundary is read before popping again, so the samples pushed before it was set are sure to be popped
+			const uint64_t endBoundary = this->endBoundary.load(std::memory_order_acquire);
+			numRead += this->samples->PopRange(targetSamples + numRead, numSamples - numRead);
+
+			if (this->samplesPopped + numRead >= endBoundary)
+			{
+				this->samplesPopped += numRead;
+				return (irrklang::ik_s32)(numRead / this->numChannels);
+			}
+
+			this->track->stats.numUnderruns.fetch_add(1, std::memory_order_relaxed);
+			this->track->stats.numSilentFrames.fetch_add((numSamples - numRead) / this->numChannels, std::memory_order_relaxed);
+		}
+
+		this->samplesPopped += numRead;
+	}
+
+	// Play silence for the frames missing, whether the decode thread has fallen behind or is yet to apply a seek
+	std::fill(targetSamples + numRead, targetSamples + numSamples, (int16_t)0);
+
+	if (this->samples->GetSize() <= this->bufferedSamples / 2)
+		this->wakeCondition.notify_one();
+
+	return frameCountToRead;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+AudioStreamLoader::AudioStreamLoader(uint32_t bufferMilliseconds) :
+	bufferMilliseconds(bufferMilliseconds)
+{}
+
+std::string AudioStreamLoader::GetTrackKey(const std::string_view& fileName)
+{
+	std::string trackKey(fileName);
+	std::transform(trackKey.begin(), trackKey.end(), trackKey.begin(),
+		[](unsigned char character) { return (char)std::tolower(character); });
+	return trackKey;
+}
+
+StreamedTrackPtr AudioStreamLoader::AddTrack(const std::string_view& filePath)
+{
+	StreamedTrackPtr track = std::make_shared<StreamedTrack>();
+	track->filePath = filePath;
+
+	// Read the format of the file up front, so the sample rate and length of the track are known before it's played
+	AudioStreamFileReader* file = new AudioStreamFileReader(AudioStreamLoader::GetStreamName(filePath), filePath);
+	WaveDecoder decoder(file);
+
+	if (file->IsOpen() && decoder.ReadHeader())
+	{
+		track->format = decoder.GetFormat();
+	}
+	else
+	{
+		LogSystem::GetInstance().OutputLog("Failed to read the header of streamed audio file \"" + track->filePath + "\"",
+			Severity::WARNING);
+	}
+
+	file->drop();
+
+	std::lock_guard<std::mutex> lock(this->trackMutex);
+
+	// Forget the tracks which have since been unloaded
+	for (auto iterator = this->tracks.begin(); iterator != this->tracks.end();)
+		iterator = iterator->second.expired() ? this->tracks.erase(iterator) : std::next(iterator);
+
+	this->tracks[AudioStreamLoader::GetTrackKey(AudioStreamLoader::GetStreamName(filePath))] = track;
+	return track;
+}
+
+bool AudioStreamLoader::isALoadableFileExtension(const irrklang::ik_c8* fileName)
+{
+	return HasStreamExtension(fileName);
+}
+
+irrklang::IAudioStream* AudioStreamLoader::createAudioStream(irrklang::IFileReader* file)
+{
+	StreamedTrackPtr track;
+	{
+		std::lock_guard<std::mutex> lock(this->trackMutex);
+		auto iterator = this->tracks.find(AudioStreamLoader::GetTrackKey(file->getFileName()));
+		if (iterator != this->tracks.end())
+			track = iterator->second.lock();
+	}
+
+	if (!track)
+		return nullptr;
+
+	StreamedAudio* stream = new StreamedAudio(file, std::move(track), this->bufferMilliseconds);
+	if (!stream->IsStreaming())
+	{
+		stream->drop();
+		return nullptr;
+	}
+
+	return stream;
+}
+
+std::string AudioStreamLoader::GetStreamName(const std::string_view& filePath)
+{
+	return std::string(filePath) + std::string(AudioStreamGlobals::streamExtension);
+}
@@ -0,0 +1,199 @@
+#ifndef AUDIO_STREAM_H
+#define AUDIO_STREAM_H
+
+#include <util/ring_buffer.h>
+#include <irrKlang.h>
+
+#include <string_view>
+#include <string>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <cstdint>
+
+namespace AudioStreamGlobals
+{
+	// Appended to the path of a streamed audio file, so irrKlang opens it through the stream file factory and stream loader
+	constexpr std::string_view streamExtension = ".stream";
+
+	// The number of frames the decode thread decodes at a time
+	constexpr uint32_t decodeBlockFrames = 2048;
+
+	// The smallest buffer depth allowed, the buffer must hold a few decode blocks for the decode thread to keep ahead of playback
+	constexpr uint32_t minBufferMilliseconds = 100;
+
+	// Used when the config file was generated before the stream buffer setting was added
+	constexpr uint32_t defaultBufferMilliseconds = 500;
+}
+
+// Counters for how well the decode thread of a streamed audio is keeping up with playback.
+// These are updated from the audio threads, so they're atomic.
+struct AudioStreamStats
+{
+	std::atomic<uint64_t> numUnderruns = 0; // The number of reads the buffer couldn't fully serve
+	std::atomic<uint64_t> numSilentFrames = 0; // The number of frames of silence played in place of the missing frames
+	std::atomic<uint64_t> numDecodedFrames = 0;
+};
+
+// The shared state of an audio file loaded for streaming, every stream irrKlang opens to play it reads these.
+struct StreamedTrack
+{
+	std::string filePath;
+	irrklang::SAudioStreamFormat format = {}; // Read from the header of the file when the track is added
+
+	// Looping is done by the decode thread, so there's no gap while irrKlang seeks back.
+	// The loop region packs the start frame in the high bits and the end frame in the low bits, so it's read and written in one go.
+	std::atomic<bool> looping = false;
+	std::atomic<uint64_t> loopRegion = 0;
+
+	AudioStreamStats stats;
+
+	// Sets the frames the track loops between, the frames before the start play once as an intro.
+	// If the end frame is zero, the loop runs to the end of the file.
+	void SetLoopRegion(uint32_t startFrame, uint32_t endFrame);
+
+	// Returns the frames the track loops between, clamped to the frames of the file given.
+	void GetLoopRegion(int32_t numFrames, int32_t& startFrame, int32_t& endFrame) const;
+};
+
+using StreamedTrackPtr = std::shared_ptr<StreamedTrack>;
+
+// Decodes the frames of an uncompressed PCM wave file, converting them to signed 16-bit samples.
+class WaveDecoder
+{
+private:
+	irrklang::IFileReader* file;
+	irrklang::SAudioStreamFormat format; // Of the decoded samples, which isn't necessarily the format stored in the file
+	uint32_t bitsPerSample, bytesPerFrame;
+	int32_t dataOffset, numFrames, framePosition;
+public:
+	WaveDecoder(irrklang::IFileReader* file);
+	~WaveDecoder() = default;
+
+	// Reads the header of the wave file.
+	// Returns TRUE if the file is a wave file which can be decoded, else FALSE is returned.
+	bool ReadHeader();
+
+	// Decodes up to the number of frames given into the samples array given, which must have room for them.
+	// Returns the number of frames decoded, this is less than the number asked for once the end of the file is reached.
+	uint32_t DecodeFrames(int16_t* samples, uint32_t frameCount);
+
+	// Moves the decoding position to the frame given.
+	// Returns TRUE if successful, else FALSE is returned.
+	bool Seek(int32_t frame);
+
+	// Returns the frame the next frames are decoded from.
+	const int32_t& GetPosition() const;
+
+	// Returns the format of the decoded samples.
+	const irrklang::SAudioStreamFormat& GetFormat() const;
+};
+
+// Gives irrKlang access to a streamed audio file, through the path it was registered under.
+class AudioStreamFileReader : public irrklang::IFileReader
+{
+private:
+	std::ifstream file;
+	std::string fileName;
+	irrklang::ik_s32 fileSize;
+public:
+	AudioStreamFileReader(const std::string_view& fileName, const std::string_view& filePath);
+	~AudioStreamFileReader() = default;
+
+	irrklang::ik_s32 read(void* buffer, irrklang::ik_u32 sizeToRead) override;
+	bool seek(irrklang::ik_s32 finalPos, bool relativeMovement = false) override;
+	irrklang::ik_s32 getSize() override;
+	irrklang::ik_s32 getPos() override;
+	const irrklang::ik_c8* getFileName() override;
+
+	// Returns TRUE if the file was opened, else FALSE is returned.
+	bool IsOpen() const;
+};
+
+// Opens the streamed audio files for irrKlang, every other file is left to irrKlang's own file access.
+class AudioStreamFileFactory : public irrklang::IFileFactory
+{
+public:
+	irrklang::IFileReader* createFileReader(const irrklang::ik_c8* filename) override;
+};
+
+// An audio stream whose frames are decoded ahead of playback on a dedicated thread, into a lock-free ring buffer of samples that
+// irrKlang reads from. So opening and playing a long track only costs reading the first buffer of it, rather than decoding all of it.
+// If the decode thread falls behind, the missing frames are played as silence and counted in the track's stats.
+class StreamedAudio : public irrklang::IAudioStream
+{
+private:
+	irrklang::IFileReader* file;
+	WaveDecoder decoder;
+	StreamedTrackPtr track;
+
+	std::unique_ptr<RingBuffer<int16_t>> samples; // Sized once the format of the file is known
+	size_t bufferedSamples, numChannels; // The decode thread keeps the ring buffer filled up to the buffered samples count
+	std::vector<int16_t> decodeBlock;
+
+	std::thread decodeThread;
+	std::mutex wakeMutex; // Only used to put the decode thread to sleep while the buffer is full, the buffer itself is lock-free
+	std::condition_variable wakeCondition;
+	std::atomic<bool> stopping;
+
+	// The seek requested by irrKlang is applied by the decode thread. The samples pushed before it's applied are skipped by the
+	// reader, which it knows from the total number of samples pushed at the point the seek was applied.
+	std::atomic<uint32_t> seeksRequested, seeksApplied;
+	std::atomic<int32_t> seekFrame;
+	std::atomic<uint64_t> seekBoundary, endBoundary; // The end boundary is the total pushed once the end of the file was decoded
+	uint64_t samplesPushed, samplesPopped; // Only touched by the decode thread and the reader respectively
+	bool finishedDecoding;
+private:
+	// The loop ran by the decode thread, keeping the buffer filled until the stream is destroyed.
+	void DecodeLoop();
+
+	// Decodes the next block of frames into the buffer, jumping back to the start of the loop region if the track is looping.
+	void DecodeBlock();
+
+	// Applies the latest seek requested, if it hasn't been applied already.
+	void ApplySeek();
+
+	// Returns TRUE if the decode thread should decode more frames, else FALSE is returned.
+	bool NeedsRefill() const;
+public:
+	StreamedAudio(irrklang::IFileReader* file, StreamedTrackPtr track, uint32_t bufferMilliseconds);
+	~StreamedAudio();
+
+	// Returns TRUE if the file given was decodable and the decode thread was started, else FALSE is returned.
+	bool IsStreaming() const;
+
+	irrklang::SAudioStreamFormat getFormat() override;
+	bool setPosition(irrklang::ik_s32 pos) override;
+	irrklang::ik_s32 readFrames(void* target, irrklang::ik_s32 frameCountToRead) override;
+};
+
+// Creates the streams irrKlang plays the streamed audio files with, and keeps track of the audio files registered for streaming.
+class AudioStreamLoader : public irrklang::IAudioStreamLoader
+{
+private:
+	std::unordered_map<std::string, std::weak_ptr<StreamedTrack>> tracks; // Keyed by the lower case stream name
+	std::mutex trackMutex; // Streams are created on irrKlang's thread, while tracks are added on the main thread
+	uint32_t bufferMilliseconds;
+private:
+	// Returns the lower case copy of the file name given, as irrKlang passes the file names to loaders in lower case.
+	static std::string GetTrackKey(const std::string_view& fileName);
+public:
+	AudioStreamLoader(uint32_t bufferMilliseconds);
+
+	// Registers the audio file given for streaming, only its header is read until it's played.
+	// Returns the track of the audio file, it's unregistered once every pointer to the track is gone.
+	StreamedTrackPtr AddTrack(const std::string_view& filePath);
+
+	bool isALoadableFileExtension(const irrklang::ik_c8* fileName) override;
+	irrklang::IAudioStream* createAudioStream(irrklang::IFileReader* file) override;
+
+	// Returns the name irrKlang is given to open the streamed audio file given.
+	static std::string GetStreamName(const std::string_view& filePath);
+};
+
+#endif
@@ -1,21 +1,53 @@
 #include <core/audio_system.h>
+#include <core/replay_system.h>
 #include <util/logging_system.h>
 #include <util/directory_system.h>
+#include <serialization/config.h>
 
 #include <algorithm>
+#include <cmath>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-AudioSystem::AudioSystem()
+AudioSystem::AudioSystem() :
+	engine(nullptr), streamFileFactory(nullptr), streamLoader(nullptr), backend(SystemBackend::HARDWARE), simulationTime(0.0),
+	allPaused(false)
+{}
+
+AudioSystem::~AudioSystem()
 {
-	this->engine = irrklang::createIrrKlangDevice();
-	if (!this->engine)
-		LogSystem::GetInstance().OutputLog("Failed to create IrrKlang device engine", Severity::FATAL);
+	this->voicePool.reset();
+
+	if (this->engine)
+		this->engine->drop();
+
+	if (this->streamLoader)
+	{
+		this->streamLoader->drop();
+		this->streamFileFactory->drop();
+	}
 }
 
-AudioSystem::~AudioSystem()
+void AudioSystem::Init(SystemBackend backend)
 {
-	this->engine->drop();
+	this->backend = backend;
+
+	const irrklang::E_SOUND_OUTPUT_DRIVER outputDriver = backend == SystemBackend::NULL_DEVICE ? irrklang::ESOD_NULL :
+		irrklang::ESOD_AUTO_DETECT;
+
+	this->engine = irrklang::createIrrKlangDevice(outputDriver);
+	if (!this->engine)
+		LogSystem::GetInstance().OutputLog("Failed to create IrrKlang device engine", Severity::FATAL);
+
+	// Hook the streamed audio files into irrKlang, they're opened through the stream file factory and decoded by the stream loader
+	const uint32_t streamBufferMilliseconds = Serialization::GetConfigElement<uint32_t>("audio", "streamBufferMilliseconds",
+		AudioStreamGlobals::defaultBufferMilliseconds);
+	this->streamFileFactory = new AudioStreamFileFactory();
+	this->streamLoader = new AudioStreamLoader(streamBufferMilliseconds);
+	this->engine->addFileFactory(this->streamFileFactory);
+	this->engine->registerAudioStreamLoader(this->streamLoader);
+
+	this->voicePool = std::make_unique<VoicePool>(this->engine);
 }
 
 void AudioSystem::SetMasterVolume(float volume)
@@ -23,16 +55,130 @@ void AudioSystem::SetMasterVolume(float volume)
 	this->engine->setSoundVolume(volume);
 }
 
-GlobalAudioPtr AudioSystem::LoadAudioFromFile(const std::string_view& fileName)
+void AudioSystem::AddLoadedAudio(GlobalAudio* audio)
+{
+	this->loadedAudios.push_back(audio);
+}
+
+void AudioSystem::RemoveLoadedAudio(GlobalAudio* audio)
+{
+	auto iterator = std::find(this->loadedAudios.begin(), this->loadedAudios.end(), audio);
+	if (iterator != this->loadedAudios.end())
+	{
+		*iterator = this->loadedAudios.back();
+		this->loadedAudios.pop_back();
+	}
+}
+
+void AudioSystem::AddAutomatedAudio(GlobalAudio* audio)
+{
+	if (std::find(this->automatedAudios.begin(), this->automatedAudios.end(), audio) == this->automatedAudios.end())
+		this->automatedAudios.push_back(audio);
+}
+
+void AudioSystem::RemoveAutomatedAudio(GlobalAudio* audio)
+{
+	auto iterator = std::find(this->automatedAudios.begin(), this->automatedAudios.end(), audio);
+	if (iterator != this->automatedAudios.end())
+	{
+		*iterator = this->automatedAudios.back();
+		this->automatedAudios.pop_back();
+	}
+}
+
+void AudioSystem::SetAllPaused(bool paused)
+{
+	if (paused == this->allPaused)
+		return;
+
+	this->allPaused = paused;
+	this->voicePool->SetPaused(paused);
+
+	// This runs between simulation steps, so only the queries which aren't synced with the replay system are used here
+	for (GlobalAudio* audio : this->loadedAudios)
+	{
+		if (paused && audio->IsPlaying() && !audio->IsChannelPaused())
+		{
+			audio->SetChannelPaused(true);
+			audio->pausedByAudioSystem = true;
+		}
+		else if (!paused && audio->pausedByAudioSystem)
+		{
+			audio->SetChannelPaused(false);
+			audio->pausedByAudioSystem = false;
+		}
+	}
+}
+
+void AudioSystem::Update(const double& deltaTime)
+{
+	this->simulationTime += deltaTime;
+	this->voicePool->ReclaimStoppedVoices();
+
+	for (size_t audioIndex = 0; audioIndex < this->automatedAudios.size();)
+	{
+		GlobalAudio* audio = this->automatedAudios[audioIndex];
+		if (!audio->UpdateAutomation(deltaTime))
+		{
+			audioIndex++;
+			continue;
+		}
+
+		if (audio->automationCallback)
+			this->completedCallbacks.emplace_back(std::move(audio->automationCallback));
+
+		audio->automationCallback = nullptr;
+		this->automatedAudios[audioIndex] = this->automatedAudios.back();
+		this->automatedAudios.pop_back();
+	}
+
+	// The callbacks are called once every automation has been advanced, as they're free to start or cancel automations (or unload
+	// the audios) themselves
+	for (std::function<void()>& callback : this->completedCallbacks)
+		callback();
+
+	this->completedCallbacks.clear();
+}
+
+void AudioSystem::CrossFade(const GlobalAudioPtr& fadeOutAudio, const GlobalAudioPtr& fadeInAudio, float duration, float fadeInVolume,
+	std::function<void()> completeCallback, bool loopFadeIn)
+{
+	if (!fadeInAudio->IsPlaying())
+	{
+		fadeInAudio->SetVolume(0.0f);
+		fadeInAudio->Play(loopFadeIn);
+	}
+
+	// Both fades run over the same duration and the fade in is started last, so its callback is called after the fade out has ended
+	fadeOutAudio->FadeVolume(0.0f, duration, nullptr, true);
+	fadeInAudio->FadeVolume(fadeInVolume, duration, std::move(completeCallback));
+}
+
+GlobalAudioPtr AudioSystem::LoadAudioFromFile(const std::string_view& fileName, AudioLoadMode mode)
 {
 	// Construct the full path to the audio file
 	const std::string filePath = Util::GetGameRequisitesDirectory() + "assets/" + fileName.data();
 
+	if (mode == AudioLoadMode::STREAM)
+	{
+		// Nothing is read until the audio is played, then irrKlang opens a stream of it through the stream loader on every play
+		StreamedTrackPtr track = this->streamLoader->AddTrack(filePath);
+		irrklang::ISoundSource* streamedAudio = this->engine->addSoundSourceFromFile(
+			AudioStreamLoader::GetStreamName(filePath).c_str(), irrklang::ESM_STREAMING, false);
+
+		return std::make_shared<GlobalAudio>(this->engine, streamedAudio, std::move(track));
+	}
+
 	// Load the audio file
 	irrklang::ISoundSource* loadedAudio = this->engine->addSoundSourceFromFile(filePath.c_str(), irrklang::ESM_AUTO_DETECT, true);
 	return std::make_shared<GlobalAudio>(this->engine, loadedAudio);
 }
 
+VoicePool& AudioSystem::GetVoicePool()
+{
+	return *this->voicePool;
+}
+
 AudioSystem& AudioSystem::GetInstance()
 {
 	static AudioSystem instance;
@@ -41,15 +187,29 @@ AudioSystem& AudioSystem::GetInstance()
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-GlobalAudio::GlobalAudio(irrklang::ISoundEngine* engine, irrklang::ISoundSource* audio) :
-	engine(engine), audio(audio), channel(nullptr)
+GlobalAudio::GlobalAudio(irrklang::ISoundEngine* engine, irrklang::ISoundSource* audio, StreamedTrackPtr track) :
+	engine(engine), audio(audio), channel(nullptr), track(std::move(track)), volume(1.0f), appliedVolume(1.0f),
+	simulated(AudioSystem::GetInstance().backend == SystemBackend::NULL_DEVICE), numAutomationSegments(0), automationSegment(0),
+	segmentStartVolume(0.0f), segmentTime(0.0), stopAfterAutomation(false), pausedByAudioSystem(false)
 {
 	this->engine->grab(); // We get a pointer to the engine, so increase the ref count to the engine
+	AudioSystem::GetInstance().AddLoadedAudio(this);
 }
 
 GlobalAudio::~GlobalAudio()
 {
+	this->CancelAutomation();
 	this->Stop();
+	AudioSystem::GetInstance().RemoveLoadedAudio(this);
+
+#ifdef _DEBUG
+	if (this->track && this->track->stats.numUnderruns > 0)
+	{
+		LogSystem::GetInstance().OutputLog("The streamed audio \"" + this->track->filePath + "\" underran " +
+			std::to_string(this->track->stats.numUnderruns.load()) + " times, " +
+			std::to_string(this->track->stats.numSilentFrames.load()) + " frames of silence were played", Severity::WARNING);
+	}
+#endif
 
 	this->engine->removeSoundSource(this->audio);
 	this->engine->drop();
@@ -57,80 +217,309 @@ GlobalAudio::~GlobalAudio()
 
 void GlobalAudio::SetPlayPosition(uint32_t milliseconds)
 {
-	if (this->channel)
+	if (this->simulated)
+	{
+		const double currentTime = this->simulatedPlayback.paused ? this->simulatedPlayback.pauseTime :
+			AudioSystem::GetInstance().simulationTime;
+
+		this->simulatedPlayback.startTime = currentTime - (milliseconds / 1000.0);
+	}
+	else if (this->channel)
 		this->channel->setPlayPosition(milliseconds);
 }
 
+void GlobalAudio::SetLoopRegion(uint32_t startFrame, uint32_t endFrame)
+{
+	if (!this->track)
+	{
+		LogSystem::GetInstance().OutputLog("Loop regions are only supported for streamed audio", Severity::WARNING);
+		return;
+	}
+
+	if (endFrame != 0 && startFrame >= endFrame)
+	{
+		LogSystem::GetInstance().OutputLog("The loop region given is empty, the start frame must come before the end frame",
+			Severity::WARNING);
+		return;
+	}
+
+	this->track->SetLoopRegion(startFrame, endFrame);
+}
+
+void GlobalAudio::StartAutomation(size_t numSegments, std::function<void()> completeCallback, bool stopOnComplete)
+{
+	this->numAutomationSegments = numSegments;
+	this->automationSegment = 0;
+	this->segmentStartVolume = this->volume;
+	this->segmentTime = 0.0;
+	this->stopAfterAutomation = stopOnComplete;
+	this->automationCallback = std::move(completeCallback);
+
+	AudioSystem::GetInstance().AddAutomatedAudio(this);
+}
+
+bool GlobalAudio::UpdateAutomation(double deltaTime)
+{
+	this->segmentTime += deltaTime;
+
+	// Move through every segment which ended during this step, zero length segments end straight away
+	while (this->automationSegment < this->numAutomationSegments)
+	{
+		const VolumeSegment& segment = this->automationSegments[this->automationSegment];
+		if (this->segmentTime < segment.duration)
+		{
+			const float progress = TweenSystem::Ease(segment.easing, (float)(this->segmentTime / segment.duration));
+			this->volume = this->segmentStartVolume + ((segment.endVolume - this->segmentStartVolume) * progress);
+			this->ApplyVolume(false);
+			return false;
+		}
+
+		this->volume = segment.endVolume;
+		this->segmentStartVolume = segment.endVolume;
+		this->segmentTime -= segment.duration;
+		this->automationSegment++;
+	}
+
+	// The automation has ended, so make sure irrKlang has the exact end volume
+	this->ApplyVolume(true);
+	this->numAutomationSegments = 0;
+
+	if (this->stopAfterAutomation)
+		this->Stop();
+
+	return true;
+}
+
+void GlobalAudio::ApplyVolume(bool force)
+{
+	if (this->channel && (force || std::abs(this->volume - this->appliedVolume) >= AudioGlobals::minVolumeStep))
+	{
+		this->channel->setVolume(this->volume);
+		this->appliedVolume = this->volume;
+	}
+}
+
+double GlobalAudio::GetLength() const
+{
+	if (this->track)
+	{
+		return this->track->format.SampleRate > 0 ?
+			(this->track->format.FrameCount * 1000.0) / this->track->format.SampleRate : 0.0;
+	}
+
+	// irrKlang returns -1 (wrapped around to the largest unsigned value) when the length isn't known
+	const irrklang::ik_u32 playLength = this->audio->getPlayLength();
+	return playLength != (irrklang::ik_u32)-1 ? (double)playLength : 0.0;
+}
+
+double GlobalAudio::GetSimulatedElapsedTime() const
+{
+	const double currentTime = this->simulatedPlayback.paused ? this->simulatedPlayback.pauseTime :
+		AudioSystem::GetInstance().simulationTime;
+
+	// Rounded to the microsecond, so the error built up by adding the step times together doesn't cost a whole step
+	return std::max(std::round((currentTime - this->simulatedPlayback.startTime) * 1e6) / 1e3, 0.0);
+}
+
+bool GlobalAudio::IsChannelPaused() const
+{
+	if (this->simulated)
+		return this->simulatedPlayback.playing && this->simulatedPlayback.paused;
+
+	return this->channel && this->channel->getIsPaused();
+}
+
+bool GlobalAudio::IsPlaying() const
+{
+	if (this->simulated)
+	{
+		return this->simulatedPlayback.playing && (this->simulatedPlayback.looping || this->GetLength() <= 0.0 ||
+			this->GetSimulatedElapsedTime() < this->GetLength());
+	}
+
+	return this->channel && !this->channel->isFinished();
+}
+
 void GlobalAudio::SetVolume(float volume)
 {
-	if (this->channel)
-		this->channel->setVolume(std::clamp(volume, 0.0f, 1.0f));
+	this->CancelAutomation();
+
+	this->volume = std::clamp(volume, 0.0f, 1.0f);
+	this->ApplyVolume(true);
+}
+
+void GlobalAudio::FadeVolume(float targetVolume, float duration, std::function<void()> completeCallback, bool stopOnComplete,
+	EasingType easing)
+{
+	this->automationSegments[0] = { std::clamp(targetVolume, 0.0f, 1.0f), std::max(duration, 0.0f), easing };
+	this->StartAutomation(1, std::move(completeCallback), stopOnComplete);
+}
+
+void GlobalAudio::Duck(float duckedVolume, float attack, float hold, float release, std::function<void()> completeCallback)
+{
+	// Ducking during another automation releases back to the volume that automation was heading to, so ducks can overlap
+	const float releaseVolume = this->IsAutomating() ? this->automationSegments[this->numAutomationSegments - 1].endVolume :
+		this->volume;
+
+	duckedVolume = std::clamp(duckedVolume, 0.0f, 1.0f);
+	this->automationSegments[0] = { duckedVolume, std::max(attack, 0.0f) };
+	this->automationSegments[1] = { duckedVolume, std::max(hold, 0.0f) };
+	this->automationSegments[2] = { releaseVolume, std::max(release, 0.0f) };
+	this->StartAutomation(3, std::move(completeCallback), false);
+}
+
+void GlobalAudio::CancelAutomation()
+{
+	if (this->IsAutomating())
+	{
+		this->numAutomationSegments = 0;
+		this->automationCallback = nullptr;
+		AudioSystem::GetInstance().RemoveAutomatedAudio(this);
+	}
 }
 
 void GlobalAudio::Play(bool loop)
 {
 	// Drop previously used sound channel
-	if (this->channel)
+	this->Stop();
+
+	// Play the audio, streamed audio is looped by its decode thread rather than by irrKlang seeking back to the start
+	if (this->track)
+		this->track->looping = loop;
+
+	// While every audio is paused, the audio is left paused until they're resumed
+	this->pausedByAudioSystem = AudioSystem::GetInstance().allPaused;
+
+	if (this->simulated)
 	{
-		this->channel->stop();
-		this->channel->drop();
+		this->simulatedPlayback = { true, this->pausedByAudioSystem, loop, AudioSystem::GetInstance().simulationTime,
+			AudioSystem::GetInstance().simulationTime };
+
+		return;
 	}
 
-	// Play the audio
-	this->channel = this->engine->play2D(this->audio, loop, false, true, false);
+	// The sound starts paused, so it's never heard at any other volume than the volume it was given
+	this->channel = this->engine->play2D(this->audio, loop && !this->track, true, true, false);
+	if (this->channel)
+	{
+		this->ApplyVolume(true);
+		this->channel->setIsPaused(this->pausedByAudioSystem);
+	}
 }
 
 void GlobalAudio::Stop()
 {
+	this->simulatedPlayback.playing = false;
+	this->pausedByAudioSystem = false;
+
 	if (this->channel)
 	{
 		this->channel->stop();
 		this->channel->drop();
+		this->channel = nullptr;
 	}
 }
 
-void GlobalAudio::Resume()
+void GlobalAudio::SetChannelPaused(bool paused)
 {
+	if (this->simulatedPlayback.playing && paused != this->simulatedPlayback.paused)
+	{
+		if (paused)
+			this->simulatedPlayback.pauseTime = AudioSystem::GetInstance().simulationTime;
+		else
+			this->simulatedPlayback.startTime += AudioSystem::GetInstance().simulationTime - this->simulatedPlayback.pauseTime;
+
+		this->simulatedPlayback.paused = paused;
+	}
+
 	if (this->channel)
-		this->channel->setIsPaused(false);
+		this->channel->setIsPaused(paused);
+}
+
+void GlobalAudio::Resume()
+{
+	// While every audio is paused, the audio is only marked to be resumed along with the rest
+	if (AudioSystem::GetInstance().allPaused)
+		this->pausedByAudioSystem = this->IsPlaying();
+	else
+		this->SetChannelPaused(false);
 }
 
 void GlobalAudio::Pause()
 {
-	if (this->channel)
-		this->channel->setIsPaused(true);
+	this->pausedByAudioSystem = false;
+	this->SetChannelPaused(true);
 }
 
 uint32_t GlobalAudio::GetPlayPosition() const
 {
-	if (this->channel)
-		return this->channel->getPlayPosition();
+	uint32_t playPosition = 0;
+	if (this->simulated && this->simulatedPlayback.playing)
+	{
+		double position = this->GetSimulatedElapsedTime();
+		const double length = this->GetLength();
 
-	return 0;
+		if (length > 0.0 && !this->simulatedPlayback.looping)
+			position = std::min(position, length);
+		else if (length > 0.0)
+		{
+			// Wrap the position around the loop region, which is the whole audio unless a loop region was set on the streamed track
+			double loopStart = 0.0, loopEnd = length;
+			if (this->track)
+			{
+				int32_t startFrame = 0, endFrame = 0;
+				this->track->GetLoopRegion(this->track->format.FrameCount, startFrame, endFrame);
+				loopStart = (startFrame * 1000.0) / this->track->format.SampleRate;
+				loopEnd = (endFrame * 1000.0) / this->track->format.SampleRate;
+			}
+
+			if (position >= loopEnd && loopEnd > loopStart)
+				position = loopStart + std::fmod(position - loopStart, loopEnd - loopStart);
+		}
+
+		playPosition = (uint32_t)position;
+	}
+	else if (this->channel)
+		playPosition = this->channel->getPlayPosition();
+
+	return ReplaySystem::GetInstance().SyncUInt(playPosition);
 }
 
-float GlobalAudio::GetVolume() const
+uint32_t GlobalAudio::GetSampleRate() const
 {
-	if (this->channel)
-		return this->channel->getVolume();
+	return (uint32_t)(this->track ? this->track->format.SampleRate : this->audio->getAudioFormat().SampleRate);
+}
 
-	return 1.0f;
+bool GlobalAudio::IsAutomating() const
+{
+	return this->numAutomationSegments > 0;
 }
 
-bool GlobalAudio::isPaused() const
+float GlobalAudio::GetVolume() const
 {
-	if (this->channel)
-		return this->channel->getIsPaused();
+	// The volume given to irrKlang is only updated once it has changed enough to be heard, so the stored volume is the current one
+	return ReplaySystem::GetInstance().SyncFloat(this->volume);
+}
 
-	return false;
+bool GlobalAudio::isPaused() const
+{
+	return ReplaySystem::GetInstance().SyncBool(this->IsChannelPaused());
 }
 
 bool GlobalAudio::isFinished() const
 {
-	if (this->channel)
-		return this->channel->isFinished();
+	bool finished = false;
+	if (this->simulated)
+		finished = this->simulatedPlayback.playing && !this->IsPlaying();
+	else if (this->channel)
+		finished = this->channel->isFinished();
 
-	return false;
+	return ReplaySystem::GetInstance().SyncBool(finished);
+}
+
+const AudioStreamStats* GlobalAudio::GetStreamStats() const
+{
+	return this->track ? &this->track->stats : nullptr;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
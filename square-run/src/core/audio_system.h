@@ -1,27 +1,125 @@
 #ifndef AUDIO_PLAYER_H
 #define AUDIO_PLAYER_H
 
+#include <core/system_backend.h>
+#include <core/audio_stream.h>
+#include <core/voice_pool.h>
+#include <core/tween_system.h>
 #include <irrKlang.h>
 #include <string_view>
+#include <functional>
+#include <array>
+#include <vector>
 #include <memory>
 
+namespace AudioGlobals
+{
+	constexpr size_t maxVolumeSegments = 3; // Enough for the attack, hold and release of a duck
+
+	// While the volume is automated, it's only passed onto irrKlang once it has moved this far from the volume last passed on
+	constexpr float minVolumeStep = 1.0f / 256.0f;
+}
+
+enum class AudioLoadMode
+{
+	PRELOAD, // The whole audio is decoded into memory when loaded, for short sound effects
+	STREAM // The audio is decoded on a background thread while it plays, for long music tracks
+};
+
+// A part of a volume automation curve, moving the volume to the end volume over the duration given (in seconds).
+struct VolumeSegment
+{
+	float endVolume = 1.0f, duration = 0.0f;
+	EasingType easing = EasingType::LINEAR;
+};
+
 // This is played globally in the sense that it doesnt take into account the position of the sound's source.
 class GlobalAudio
 {
+	friend class AudioSystem;
 private:
 	irrklang::ISoundEngine* engine;
 	irrklang::ISoundSource* audio;
 	irrklang::ISound* channel;
+	StreamedTrackPtr track; // Null unless the audio is streamed
+	float volume, appliedVolume; // The applied volume is the volume irrKlang was last given
+
+	// The null device backend plays nothing, so the play state is simulated from the simulation time rather than left to irrKlang's
+	// null driver (which runs on the wall clock), so the audio finishes on the same step every headless run
+	struct SimulatedPlayback
+	{
+		bool playing = false, paused = false, looping = false;
+		double startTime = 0.0; // The simulation time the audio would have started at, had it played from the beginning
+		double pauseTime = 0.0;
+	};
+
+	bool simulated;
+	SimulatedPlayback simulatedPlayback;
+
+	// Set while the audio is paused by AudioSystem::SetAllPaused(), so only the audios it paused are resumed by it
+	bool pausedByAudioSystem;
+
+	// The volume automation is advanced by the audio system every update, in simulation time, so it ends on the same step every run
+	std::array<VolumeSegment, AudioGlobals::maxVolumeSegments> automationSegments;
+	size_t numAutomationSegments, automationSegment; // No automation is running while the number of segments is zero
+	float segmentStartVolume;
+	double segmentTime;
+	bool stopAfterAutomation;
+	std::function<void()> automationCallback;
+private:
+	// Starts the automation of the first number of segments given, replacing the automation running (if any).
+	void StartAutomation(size_t numSegments, std::function<void()> completeCallback, bool stopOnComplete);
+
+	// Advances the automation by the delta time given.
+	// Returns TRUE once the automation has finished, else FALSE is returned.
+	bool UpdateAutomation(double deltaTime);
+
+	// Passes the volume onto irrKlang if it has moved far enough from the volume last passed on, or if forced to.
+	void ApplyVolume(bool force);
+
+	// Returns the length of the audio in milliseconds, or zero if it isn't known.
+	double GetLength() const;
+
+	// Returns the simulated play position in milliseconds, before it's wrapped around the loop.
+	double GetSimulatedElapsedTime() const;
+
+	// Returns TRUE if the audio has been played and hasn't finished or been stopped since, else FALSE is returned.
+	bool IsPlaying() const;
+
+	// Returns TRUE if the audio is paused, else FALSE is returned. Unlike isPaused() the answer isn't synced with the replay system, 
+	// so it's safe to call between simulation steps.
+	bool IsChannelPaused() const;
+
+	// Pauses or resumes the audio without changing whether it was paused by the audio system.
+	void SetChannelPaused(bool paused);
 public:
-	GlobalAudio(irrklang::ISoundEngine* engine, irrklang::ISoundSource* audio);
+	GlobalAudio(irrklang::ISoundEngine* engine, irrklang::ISoundSource* audio, StreamedTrackPtr track = nullptr);
 	~GlobalAudio();
 
 	// Sets the current play position of the audio in milliseconds.
 	void SetPlayPosition(uint32_t milliseconds);
 
-	// Sets the volume of the audio when played.
+	// Sets the frames (samples per channel) the audio loops between when played looping, the frames before the start play once as
+	// an intro. The jump back to the start is made by the decode thread, so it's exact to the frame.
+	// If the end frame is zero, the loop runs to the end of the audio. Note that only streamed audio supports loop regions.
+	void SetLoopRegion(uint32_t startFrame, uint32_t endFrame = 0);
+
+	// Sets the volume of the audio when played, cancelling the volume automation running (if any).
 	void SetVolume(float volume);
 
+	// Fades the volume of the audio to the volume given over the duration given (in seconds).
+	// The complete callback is called once the fade ends, unless it's cancelled or replaced by another automation first. If stop on
+	// complete is set, the audio is stopped once the fade ends.
+	void FadeVolume(float targetVolume, float duration, std::function<void()> completeCallback = nullptr, bool stopOnComplete = false,
+		EasingType easing = EasingType::LINEAR);
+
+	// Fades the volume of the audio down to the ducked volume over the attack duration, holds it there for the hold duration, then
+	// fades it back up to the volume it had before over the release duration (all in seconds).
+	void Duck(float duckedVolume, float attack, float hold, float release, std::function<void()> completeCallback = nullptr);
+
+	// Stops the volume automation running (if any) where it is, its complete callback isn't called.
+	void CancelAutomation();
+
 	// Plays the audio.
 	void Play(bool loop = false);
 
@@ -37,24 +135,55 @@ public:
 	// Returns the current play position of the audio in milliseconds.
 	uint32_t GetPlayPosition() const;
 
+	// Returns the number of frames per second of the audio.
+	uint32_t GetSampleRate() const;
+
 	// Returns the volume of the audio.
 	float GetVolume() const;
+
+	// Returns TRUE if the volume of the audio is being automated, else FALSE is returned.
+	bool IsAutomating() const;
 	
 	// Returns TRUE if the audio is paused, else FALSE is returned.
 	bool isPaused() const;
 
 	// Returns TRUE if the audio has finished playing, else FALSE is returned.
 	bool isFinished() const;
+
+	// Returns the underrun counters of the audio if it's streamed, else nullptr is returned.
+	const AudioStreamStats* GetStreamStats() const;
 };
 
 using GlobalAudioPtr = std::shared_ptr<GlobalAudio>;
 
 class AudioSystem
 {
+	friend class GlobalAudio;
 private:
 	irrklang::ISoundEngine* engine;
+	AudioStreamFileFactory* streamFileFactory;
+	AudioStreamLoader* streamLoader;
+	std::unique_ptr<VoicePool> voicePool;
+	SystemBackend backend;
+	double simulationTime; // Advanced every update, the null device backend plays the audio along it
+	bool allPaused;
+
+	std::vector<GlobalAudio*> loadedAudios, automatedAudios;
+	std::vector<std::function<void()>> completedCallbacks; // Kept around so completing automations doesn't allocate
 private:
 	AudioSystem();
+
+	// Adds the audio given to the loaded audios, which are paused and resumed by SetAllPaused().
+	void AddLoadedAudio(GlobalAudio* audio);
+
+	// Removes the audio given from the loaded audios.
+	void RemoveLoadedAudio(GlobalAudio* audio);
+
+	// Adds the audio given to the audios whose volume automation is advanced every update (if it's not already added).
+	void AddAutomatedAudio(GlobalAudio* audio);
+
+	// Removes the audio given from the audios whose volume automation is advanced every update.
+	void RemoveAutomatedAudio(GlobalAudio* audio);
 public:
 	AudioSystem(const AudioSystem& other) = delete;
 	AudioSystem(AudioSystem&& temp) noexcept = delete;
@@ -63,11 +192,36 @@ public:
 	AudioSystem& operator=(const AudioSystem& other) = delete;
 	AudioSystem& operator=(AudioSystem&& temp) noexcept = delete;
 
+	// Initializes the audio system, creating the audio device engine.
+	// When the null device backend is selected, audio is still loaded but nothing is output. The play positions are advanced by
+	// Update() instead, so they move in simulation time.
+	void Init(SystemBackend backend = SystemBackend::HARDWARE);
+
 	// Sets the master volume for all audios being played.
 	void SetMasterVolume(float volume);
 
+	// Pauses or resumes every audio currently being played at once.
+	// Only the audios playing when paused are resumed, so the audios paused by the game stay paused. The audios played while
+	// everything is paused start paused, and are resumed along with the rest.
+	void SetAllPaused(bool paused);
+
+	// Advances the volume automations (and the audio played by the null device backend), then calls the complete callbacks of the
+	// automations which ended.
+	// This is called once every simulation step, so the callbacks are fired on the same step every run (and in replays).
+	void Update(const double& deltaTime);
+
+	// Fades the audio given out and stops it, while fading the other audio given in to the volume given, over the duration given
+	// (in seconds). The audio faded in is played first if it's not playing already. The complete callback is called once both fades
+	// have ended.
+	void CrossFade(const GlobalAudioPtr& fadeOutAudio, const GlobalAudioPtr& fadeInAudio, float duration, float fadeInVolume = 1.0f,
+		std::function<void()> completeCallback = nullptr, bool loopFadeIn = false);
+
 	// Returns a pointer to the audio that was loaded from file.
-	GlobalAudioPtr LoadAudioFromFile(const std::string_view& fileName);
+	// Streaming only reads the file as it plays, so it's meant for long music tracks, only PCM wave files can be streamed.
+	GlobalAudioPtr LoadAudioFromFile(const std::string_view& fileName, AudioLoadMode mode = AudioLoadMode::PRELOAD);
+
+	// Returns the voice pool the sound effects are registered with and triggered through.
+	VoicePool& GetVoicePool();
 
 	// Returns singleton instance object of this class.
 	static AudioSystem& GetInstance();
@@ -0,0 +1,369 @@
+#include <core/chunk_streamer.h>
+#include <util/logging_system.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace ChunkStreamerGlobals
+{
+	// The requests in flight are capped at the queue capacity, so the queues of a worker can never fill up
+	constexpr size_t queueCapacity = 64;
+
+	// The layout of the runner chunks generated by default (y grows downwards)
+	constexpr float tileSize = 80.0f;
+	constexpr float groundLevel = 900.0f; // The top of the ground
+	constexpr int safeEdgeTiles = 2; // The tiles at either edge of a chunk are always ground, so gaps never span two chunks
+}
+
+// Returns the seconds since an arbitrary point, from a clock which is safe to read on any thread.
+static double GetStreamingTime()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ChunkStreamer::ChunkWorker::ChunkWorker(size_t queueCapacity) :
+	requests(queueCapacity), readyChunks(queueCapacity)
+{}
+
+ChunkStreamer::ChunkStreamer(const ChunkStreamerDesc& desc) :
+	desc(desc), nextWorker(0), stopping(false), collisionWorld(nullptr), totalGenerationTime(0.0), totalReadyLatency(0.0)
+{
+	if (!this->desc.generator)
+		this->desc.generator = ChunkStreamer::GenerateRunnerChunk;
+
+	this->pendingIndices.reserve(ChunkStreamerGlobals::queueCapacity);
+	for (size_t workerIndex = 0; workerIndex < std::max<size_t>(this->desc.numWorkers, 1); workerIndex++)
+	{
+		this->workers.emplace_back(std::make_unique<ChunkWorker>(ChunkStreamerGlobals::queueCapacity));
+		ChunkWorker& worker = *this->workers.back();
+		worker.thread = std::thread(&ChunkStreamer::WorkerLoop, this, std::ref(worker));
+	}
+}
+
+ChunkStreamer::~ChunkStreamer()
+{
+	this->stopping = true;
+	for (std::unique_ptr<ChunkWorker>& worker : this->workers)
+	{
+		{
+			std::lock_guard<std::mutex> lock(worker->wakeMutex);
+		}
+
+		worker->wakeCondition.notify_one();
+		worker->thread.join();
+	}
+
+	this->Clear();
+}
+
+void ChunkStreamer::WorkerLoop(ChunkWorker& worker)
+{
+	while (true)
+	{
+		LevelChunk* chunk = nullptr;
+		if (!worker.requests.Pop(chunk))
+		{
+			// Sleep until the main thread pushes a request, the predicate is checked under the lock so no wake up is missed
+			std::unique_lock<std::mutex> lock(worker.wakeMutex);
+			worker.wakeCondition.wait(lock, [&]() { return this->stopping || !worker.requests.IsEmpty(); });
+
+			if (this->stopping)
+				return;
+
+			continue;
+		}
+
+		// Every chunk has its own seed, so the chunk comes out the same whichever worker generates it and whenever it's generated
+		const double startTime = GetStreamingTime();
+
+		std::mt19937 randomEngine(ChunkStreamer::GetChunkSeed(this->desc.seed, chunk->index));
+		this->desc.generator(*chunk, randomEngine);
+
+		chunk->generationSeconds = GetStreamingTime() - startTime;
+		worker.readyChunks.Push(chunk);
+	}
+}
+
+void ChunkStreamer::ReceiveReadyChunks(const OrthogonalCamera& camera)
+{
+	const int64_t firstIndex = this->GetChunkIndex(camera.GetPosition().x) - (int64_t)this->desc.chunksBehind;
+	const int64_t lastIndex = this->GetChunkIndex(camera.GetPosition().x + camera.GetSize().x) + (int64_t)this->desc.chunksAhead;
+	const double currentTime = GetStreamingTime();
+
+	for (std::unique_ptr<ChunkWorker>& worker : this->workers)
+	{
+		LevelChunk* chunk = nullptr;
+		while (worker->readyChunks.Pop(chunk))
+		{
+			this->pendingIndices.erase(std::find(this->pendingIndices.begin(), this->pendingIndices.end(), chunk->index));
+
+			const double generationTime = chunk->generationSeconds * 1e3, readyLatency = (currentTime - chunk->requestTime) * 1e3;
+			this->totalGenerationTime += generationTime;
+			this->totalReadyLatency += readyLatency;
+
+			this->stats.numGenerated++;
+			this->stats.maxGenerationTime = std::max(this->stats.maxGenerationTime, generationTime);
+			this->stats.maxReadyLatency = std::max(this->stats.maxReadyLatency, readyLatency);
+			this->stats.averageGenerationTime = this->totalGenerationTime / this->stats.numGenerated;
+			this->stats.averageReadyLatency = this->totalReadyLatency / this->stats.numGenerated;
+
+			// The camera may have moved on while the chunk was being generated
+			if (chunk->index >= firstIndex && chunk->index <= lastIndex)
+				this->ActivateChunk(chunk);
+			else
+				this->RecycleChunk(chunk);
+		}
+	}
+}
+
+void ChunkStreamer::ActivateChunk(LevelChunk* chunk)
+{
+	if (this->collisionWorld)
+	{
+		for (const RectangleCollider& collider : chunk->colliders)
+			chunk->colliderHandles.emplace_back(this->collisionWorld->Insert(collider));
+	}
+
+	const auto insertPosition = std::upper_bound(this->activeChunks.begin(), this->activeChunks.end(), chunk,
+		[](const LevelChunk* first, const LevelChunk* second) { return first->index < second->index; });
+
+	this->activeChunks.insert(insertPosition, chunk);
+}
+
+void ChunkStreamer::RecycleChunk(LevelChunk* chunk)
+{
+	if (this->collisionWorld)
+	{
+		for (const ColliderHandle& handle : chunk->colliderHandles)
+			this->collisionWorld->Remove(handle);
+	}
+
+	// The arrays are cleared rather than freed, so the next chunk generated into them doesn't allocate
+	chunk->colliders.clear();
+	chunk->rects.clear();
+	chunk->colliderHandles.clear();
+
+	this->freeChunks.emplace_back(chunk);
+	this->stats.numRecycled++;
+}
+
+bool ChunkStreamer::IsLoadedOrPending(int64_t chunkIndex) const
+{
+	return std::find(this->pendingIndices.begin(), this->pendingIndices.end(), chunkIndex) != this->pendingIndices.end() ||
+		std::any_of(this->activeChunks.begin(), this->activeChunks.end(),
+			[chunkIndex](const LevelChunk* chunk) { return chunk->index == chunkIndex; });
+}
+
+void ChunkStreamer::RequestChunks(const OrthogonalCamera& camera)
+{
+	const int64_t firstVisibleIndex = this->GetChunkIndex(camera.GetPosition().x);
+	const int64_t lastVisibleIndex = this->GetChunkIndex(camera.GetPosition().x + camera.GetSize().x);
+	const int64_t firstIndex = firstVisibleIndex - (int64_t)this->desc.chunksBehind;
+	const int64_t lastIndex = lastVisibleIndex + (int64_t)this->desc.chunksAhead;
+
+	// Recycle the chunks which are out of range
+	for (size_t chunkIndex = 0; chunkIndex < this->activeChunks.size();)
+	{
+		LevelChunk* chunk = this->activeChunks[chunkIndex];
+		if (chunk->index < firstIndex || chunk->index > lastIndex)
+		{
+			this->activeChunks.erase(this->activeChunks.begin() + chunkIndex);
+			this->RecycleChunk(chunk);
+		}
+		else
+			chunkIndex++;
+	}
+
+	// Request the chunks coming into range, nearest first, i.e. the visible chunks, then the ones ahead and lastly the ones behind
+	for (int64_t offset = 0; offset <= lastIndex - firstIndex; offset++)
+	{
+		const int64_t index = firstVisibleIndex + offset <= lastIndex ? firstVisibleIndex + offset :
+			firstVisibleIndex - (firstVisibleIndex + offset - lastIndex);
+
+		if (this->pendingIndices.size() >= ChunkStreamerGlobals::queueCapacity)
+			break;
+
+		if (this->IsLoadedOrPending(index))
+			continue;
+
+		if (this->freeChunks.empty())
+		{
+			this->chunkStorage.emplace_back(std::make_unique<LevelChunk>());
+			this->freeChunks.emplace_back(this->chunkStorage.back().get());
+		}
+
+		LevelChunk* chunk = this->freeChunks.back();
+		this->freeChunks.pop_back();
+
+		chunk->index = index;
+		chunk->startX = (float)index * this->desc.chunkWidth;
+		chunk->width = this->desc.chunkWidth;
+		chunk->requestTime = GetStreamingTime();
+
+		// Hand the chunk to the workers in turn, then wake the worker up in case it's asleep
+		ChunkWorker& worker = *this->workers[this->nextWorker];
+		this->nextWorker = (this->nextWorker + 1) % this->workers.size();
+
+		worker.requests.Push(chunk);
+		this->pendingIndices.emplace_back(index);
+
+		{
+			std::lock_guard<std::mutex> lock(worker.wakeMutex);
+		}
+
+		worker.wakeCondition.notify_one();
+	}
+}
+
+void ChunkStreamer::SetCollisionWorld(CollisionWorld* world)
+{
+	for (LevelChunk* chunk : this->activeChunks)
+	{
+		if (this->collisionWorld)
+		{
+			for (const ColliderHandle& handle : chunk->colliderHandles)
+				this->collisionWorld->Remove(handle);
+		}
+
+		chunk->colliderHandles.clear();
+		if (world)
+		{
+			for (const RectangleCollider& collider : chunk->colliders)
+				chunk->colliderHandles.emplace_back(world->Insert(collider));
+		}
+	}
+
+	this->collisionWorld = world;
+}
+
+void ChunkStreamer::Update(const OrthogonalCamera& camera)
+{
+	this->ReceiveReadyChunks(camera);
+	this->RequestChunks(camera);
+
+	// A chunk in view which isn't ready means the workers have fallen behind the camera
+	const int64_t lastVisibleIndex = this->GetChunkIndex(camera.GetPosition().x + camera.GetSize().x);
+	for (int64_t index = this->GetChunkIndex(camera.GetPosition().x); index <= lastVisibleIndex; index++)
+	{
+		if (std::none_of(this->activeChunks.begin(), this->activeChunks.end(),
+			[index](const LevelChunk* chunk) { return chunk->index == index; }))
+		{
+			this->stats.numStalls++;
+			break;
+		}
+	}
+}
+
+void ChunkStreamer::WaitForPending(const OrthogonalCamera& camera)
+{
+	this->RequestChunks(camera);
+
+	while (!this->pendingIndices.empty())
+	{
+		std::this_thread::yield();
+		this->ReceiveReadyChunks(camera);
+	}
+}
+
+void ChunkStreamer::Clear()
+{
+	for (LevelChunk* chunk : this->activeChunks)
+		this->RecycleChunk(chunk);
+
+	this->activeChunks.clear();
+}
+
+void ChunkStreamer::OutputStats() const
+{
+	LogSystem::GetInstance().OutputLog("Chunk streaming: " + std::to_string(this->stats.numGenerated) + " chunks generated (" +
+		std::to_string(this->stats.averageGenerationTime) + "ms average, " + std::to_string(this->stats.maxGenerationTime) +
+		"ms max), ready after " + std::to_string(this->stats.averageReadyLatency) + "ms on average (" +
+		std::to_string(this->stats.maxReadyLatency) + "ms max), " + std::to_string(this->stats.numStalls) + " stalls",
+		Severity::INFO);
+}
+
+const std::vector<LevelChunk*>& ChunkStreamer::GetActiveChunks() const
+{
+	return this->activeChunks;
+}
+
+const ChunkStreamingStats& ChunkStreamer::GetStats() const
+{
+	return this->stats;
+}
+
+int64_t ChunkStreamer::GetChunkIndex(float positionX) const
+{
+	return (int64_t)std::floor(positionX / this->desc.chunkWidth);
+}
+
+uint32_t ChunkStreamer::GetChunkSeed(uint64_t seed, int64_t chunkIndex)
+{
+	// Mix the seed and the chunk index (splitmix64), so neighbouring chunks get unrelated seeds
+	uint64_t mixed = seed + ((uint64_t)chunkIndex * 0x9E3779B97F4A7C15ull);
+	mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+	mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+	return (uint32_t)(mixed ^ (mixed >> 31));
+}
+
+void ChunkStreamer::GenerateRunnerChunk(LevelChunk& chunk, std::mt19937& randomEngine)
+{
+	constexpr float tileSize = ChunkStreamerGlobals::tileSize, groundLevel = ChunkStreamerGlobals::groundLevel;
+	const int numTiles = std::max((int)(chunk.width / tileSize), 1);
+
+	std::uniform_int_distribution<int> chanceDistribution(0, 99);
+	std::uniform_int_distribution<int> gapDistribution(2, 3), stackDistribution(1, 2), platformDistribution(3, 5);
+
+	const auto addBlock = [&](const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		chunk.colliders.emplace_back(position, size);
+		chunk.rects.push_back({ position, size, 0.0f, color });
+	};
+
+	// Lay the ground down in strips between the gaps, each strip being a single collider
+	int stripStart = 0;
+	for (int tileIndex = 0; tileIndex < numTiles;)
+	{
+		const bool canGap = tileIndex >= ChunkStreamerGlobals::safeEdgeTiles &&
+			tileIndex < numTiles - ChunkStreamerGlobals::safeEdgeTiles - 3;
+
+		if (canGap && chanceDistribution(randomEngine) < 8)
+		{
+			// A gap straight after another gap leaves no ground between them
+			const float stripWidth = (tileIndex - stripStart) * tileSize;
+			if (stripWidth > 0.0f)
+			{
+				addBlock({ chunk.startX + (stripStart * tileSize) + (stripWidth / 2.0f), groundLevel + tileSize },
+					{ stripWidth, tileSize * 2.0f }, { 0, 0, 0, 255 });
+			}
+
+			tileIndex += gapDistribution(randomEngine);
+			stripStart = tileIndex;
+			continue;
+		}
+
+		// Boxes rest on the ground, and platforms float above it
+		const int obstacleRoll = chanceDistribution(randomEngine);
+		if (tileIndex >= ChunkStreamerGlobals::safeEdgeTiles && obstacleRoll < 10)
+		{
+			const float stackHeight = stackDistribution(randomEngine) * tileSize;
+			addBlock({ chunk.startX + ((tileIndex + 0.5f) * tileSize), groundLevel - (stackHeight / 2.0f) },
+				{ tileSize, stackHeight }, { 255, 0, 0, 255 });
+		}
+		else if (obstacleRoll >= 95 && tileIndex + 3 <= numTiles)
+		{
+			addBlock({ chunk.startX + ((tileIndex + 1.5f) * tileSize), groundLevel - (platformDistribution(randomEngine) * tileSize) },
+				{ tileSize * 3.0f, tileSize / 4.0f }, { 0, 0, 255, 255 });
+		}
+
+		tileIndex++;
+	}
+
+	const float stripWidth = (numTiles - stripStart) * tileSize;
+	if (stripWidth > 0.0f)
+	{
+		addBlock({ chunk.startX + (stripStart * tileSize) + (stripWidth / 2.0f), groundLevel + tileSize },
+			{ stripWidth, tileSize * 2.0f }, { 0, 0, 0, 255 });
+	}
+}
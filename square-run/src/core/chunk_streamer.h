@@ -0,0 +1,148 @@
+#ifndef CHUNK_STREAMER_H
+#define CHUNK_STREAMER_H
+
+#include <core/collision_world.h>
+#include <graphics/orthogonal_camera.h>
+#include <graphics/rect_instance.h>
+#include <util/ring_buffer.h>
+
+#include <functional>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <random>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// A segment of the level, spanning the chunk width from its start position along the x axis.
+// The obstacles and render data are baked when the chunk is generated, and its storage is reused once the chunk is recycled.
+struct LevelChunk
+{
+	int64_t index = 0;
+	float startX = 0.0f, width = 0.0f;
+
+	std::vector<RectangleCollider> colliders; // In world space
+	std::vector<RectInstance> rects; // In world space, ready to be drawn with Renderer::RenderRectInstances()
+	std::vector<ColliderHandle> colliderHandles; // The handles of the colliders in the collision world, while the chunk is active
+
+	// Instrumentation, the times are in seconds
+	double requestTime = 0.0; // When the main thread requested the chunk
+	double generationSeconds = 0.0; // How long the worker thread took to generate the chunk
+};
+
+// Fills the chunk given with its obstacles and render data, using the random engine given (seeded for that chunk).
+// The chunk's index, start position and width are already set, and its arrays are empty.
+using ChunkGenerator = std::function<void(LevelChunk& chunk, std::mt19937& randomEngine)>;
+
+struct ChunkStreamerDesc
+{
+	float chunkWidth = 1920.0f;
+	size_t chunksAhead = 2; // The number of chunks kept loaded past the right edge of the camera view
+	size_t chunksBehind = 1; // The number of chunks kept loaded past the left edge of the camera view
+	size_t numWorkers = 2;
+	uint64_t seed = 0; // Every chunk is generated from this and its index, so the level is the same whatever order chunks load in
+	ChunkGenerator generator; // If not given, ChunkStreamer::GenerateRunnerChunk() is used
+};
+
+// The generation and hand over timings of the chunks streamed so far, in milliseconds.
+struct ChunkStreamingStats
+{
+	size_t numGenerated = 0, numRecycled = 0;
+	size_t numStalls = 0; // The number of updates where a chunk the camera could already see wasn't ready yet
+	double averageGenerationTime = 0.0, maxGenerationTime = 0.0;
+	double averageReadyLatency = 0.0, maxReadyLatency = 0.0; // From the chunk being requested to the main thread receiving it
+};
+
+// Generates the level chunks around the camera on worker threads, ahead of the camera coming into view of them, and recycles the
+// chunks once they're out of range. The generated chunks are handed to the main thread through lock-free queues, and the chunks are
+// pooled, so once the pool holds as many chunks as are ever in range at once streaming stops allocating.
+// The collision world given (if any) must outlive the streamer, as the colliders are removed from it when the streamer is destroyed.
+class ChunkStreamer
+{
+private:
+	// A worker thread, and the queues the main thread uses to send it chunks to generate and receive them back.
+	struct ChunkWorker
+	{
+		std::thread thread;
+		RingBuffer<LevelChunk*> requests, readyChunks;
+
+		// Only used to put the worker to sleep while it has no requests, the queues themselves are lock-free
+		std::mutex wakeMutex;
+		std::condition_variable wakeCondition;
+
+		ChunkWorker(size_t queueCapacity);
+	};
+private:
+	ChunkStreamerDesc desc;
+	std::vector<std::unique_ptr<LevelChunk>> chunkStorage;
+	std::vector<LevelChunk*> freeChunks, activeChunks; // The active chunks are sorted by index
+	std::vector<int64_t> pendingIndices; // The chunks being generated
+	std::vector<std::unique_ptr<ChunkWorker>> workers;
+	size_t nextWorker;
+	std::atomic<bool> stopping;
+
+	CollisionWorld* collisionWorld;
+	ChunkStreamingStats stats;
+	double totalGenerationTime, totalReadyLatency;
+private:
+	// The loop ran by every worker thread, generating the chunks requested until the streamer is destroyed.
+	void WorkerLoop(ChunkWorker& worker);
+
+	// Takes in the chunks which finished generating, activating the ones still in range of the camera given.
+	void ReceiveReadyChunks(const OrthogonalCamera& camera);
+
+	// Recycles the active chunks out of range of the camera given, and requests the chunks coming into range of it.
+	void RequestChunks(const OrthogonalCamera& camera);
+
+	// Adds the chunk given to the active chunks, inserting its colliders into the collision world (if any).
+	void ActivateChunk(LevelChunk* chunk);
+
+	// Removes the colliders of the chunk given from the collision world (if any), and returns the chunk to the pool.
+	void RecycleChunk(LevelChunk* chunk);
+
+	// Returns TRUE if the chunk of the index given is active or being generated, else FALSE is returned.
+	bool IsLoadedOrPending(int64_t chunkIndex) const;
+public:
+	ChunkStreamer(const ChunkStreamerDesc& desc);
+	~ChunkStreamer();
+
+	ChunkStreamer(const ChunkStreamer& other) = delete;
+	ChunkStreamer& operator=(const ChunkStreamer& other) = delete;
+
+	// Sets the collision world the colliders of active chunks are inserted into, pass nullptr to stop using one.
+	// The colliders of the chunks already active are moved over to the new collision world.
+	void SetCollisionWorld(CollisionWorld* world);
+
+	// Takes in the chunks which finished generating, recycles the chunks out of range of the camera given and requests the chunks
+	// coming into range of it. This must be called from the main thread.
+	void Update(const OrthogonalCamera& camera);
+
+	// Blocks until every chunk requested so far has finished generating, then takes them in.
+	// This is useful for making sure the first chunks are in place before the level is shown.
+	void WaitForPending(const OrthogonalCamera& camera);
+
+	// Recycles every active chunk.
+	void Clear();
+
+	// Outputs the streaming stats to the log.
+	void OutputStats() const;
+
+	// Returns the active chunks, sorted from left to right.
+	const std::vector<LevelChunk*>& GetActiveChunks() const;
+
+	// Returns the generation and hand over timings of the chunks streamed so far.
+	const ChunkStreamingStats& GetStats() const;
+
+	// Returns the chunk index covering the x position given.
+	int64_t GetChunkIndex(float positionX) const;
+
+	// Returns the seed the chunk of the index given is generated with.
+	static uint32_t GetChunkSeed(uint64_t seed, int64_t chunkIndex);
+
+	// Generates an endless runner chunk, a ground strip with the odd gap, boxes resting on the ground and platforms above them.
+	static void GenerateRunnerChunk(LevelChunk& chunk, std::mt19937& randomEngine);
+};
+
+#endif
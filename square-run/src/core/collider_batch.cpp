@@ -0,0 +1,234 @@
+#include <core/collider_batch.h>
+
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+
+namespace ColliderBatchGlobals
+{
+	constexpr size_t maskWordBits = 64;
+}
+
+void ColliderBatch::Reserve(size_t numColliders)
+{
+	this->minX.reserve(numColliders);
+	this->minY.reserve(numColliders);
+	this->maxX.reserve(numColliders);
+	this->maxY.reserve(numColliders);
+}
+
+void ColliderBatch::Clear()
+{
+	this->minX.clear();
+	this->minY.clear();
+	this->maxX.clear();
+	this->maxY.clear();
+}
+
+size_t ColliderBatch::Add(const RectangleCollider& collider)
+{
+	// The edges are calculated through the collider so that they're bit-identical to the ones used by RectangleCollider::IsColliding
+	this->minX.emplace_back(collider.GetLeftSidePosition());
+	this->minY.emplace_back(collider.GetTopSidePosition());
+	this->maxX.emplace_back(collider.GetRightSidePosition());
+	this->maxY.emplace_back(collider.GetBottomSidePosition());
+
+	return this->minX.size() - 1;
+}
+
+void ColliderBatch::Set(size_t index, const RectangleCollider& collider)
+{
+	this->minX[index] = collider.GetLeftSidePosition();
+	this->minY[index] = collider.GetTopSidePosition();
+	this->maxX[index] = collider.GetRightSidePosition();
+	this->maxY[index] = collider.GetBottomSidePosition();
+}
+
+size_t ColliderBatch::TestCollider(const RectangleCollider& collider, std::vector<uint64_t>& overlapMask, 
+	std::vector<CollidingSide>& sides) const
+{
+	return this->TestCollider(collider, overlapMask, sides, ColliderBatch::GetSupportedSimdLevel());
+}
+
+size_t ColliderBatch::TestCollider(const RectangleCollider& collider, std::vector<uint64_t>& overlapMask, 
+	std::vector<CollidingSide>& sides, SimdLevel simdLevel) const
+{
+	const size_t numColliders = this->GetSize();
+	overlapMask.assign((numColliders + ColliderBatchGlobals::maskWordBits - 1) / ColliderBatchGlobals::maskWordBits, 0);
+	sides.resize(numColliders);
+
+	const float queryEdges[4] = { collider.GetLeftSidePosition(), collider.GetTopSidePosition(), collider.GetRightSidePosition(),
+		collider.GetBottomSidePosition() };
+
+	// The kernels process the colliders in groups of their vector width, the colliders left over are tested by the scalar kernel
+	size_t numVectorized = 0;
+	switch (simdLevel)
+	{
+	case SimdLevel::AVX2:
+		numVectorized = numColliders - (numColliders % 8);
+		this->TestRangeAVX2(queryEdges, 0, numVectorized, overlapMask.data(), sides.data());
+		break;
+	case SimdLevel::SSE2:
+		numVectorized = numColliders - (numColliders % 4);
+		this->TestRangeSSE2(queryEdges, 0, numVectorized, overlapMask.data(), sides.data());
+		break;
+	default:
+		break;
+	}
+
+	this->TestRangeScalar(queryEdges, numVectorized, numColliders, overlapMask.data(), sides.data());
+
+	size_t numOverlaps = 0;
+	for (const uint64_t& maskWord : overlapMask)
+	{
+		for (uint64_t remainingBits = maskWord; remainingBits; remainingBits &= remainingBits - 1)
+			numOverlaps++;
+	}
+
+	return numOverlaps;
+}
+
+void ColliderBatch::TestRangeScalar(const float queryEdges[4], size_t beginIndex, size_t endIndex, uint64_t* overlapMask, 
+	CollidingSide* sides) const
+{
+	for (size_t index = beginIndex; index < endIndex; index++)
+	{
+		if (!(this->maxX[index] > queryEdges[0] && this->minX[index] < queryEdges[2] && this->minY[index] < queryEdges[3] && 
+			this->maxY[index] > queryEdges[1]))
+		{
+			sides[index] = CollidingSide::NONE;
+			continue;
+		}
+
+		const float leftDistance = std::abs(this->minX[index] - queryEdges[2]);
+		const float rightDistance = std::abs(this->maxX[index] - queryEdges[0]);
+		const float topDistance = std::abs(this->minY[index] - queryEdges[3]);
+		const float bottomDistance = std::abs(this->maxY[index] - queryEdges[1]);
+
+		// Ties are resolved in the same order as RectangleCollider::IsColliding does (right, left, top then bottom)
+		const float lowestDistance = std::min(std::min(rightDistance, leftDistance), std::min(topDistance, bottomDistance));
+		sides[index] =
+			lowestDistance == rightDistance ? CollidingSide::RIGHT :
+			lowestDistance == leftDistance ? CollidingSide::LEFT :
+			lowestDistance == topDistance ? CollidingSide::TOP :
+			CollidingSide::BOTTOM;
+
+		overlapMask[index / ColliderBatchGlobals::maskWordBits] |= 1ull << (index % ColliderBatchGlobals::maskWordBits);
+	}
+}
+
+void ColliderBatch::TestRangeSSE2(const float queryEdges[4], size_t beginIndex, size_t endIndex, uint64_t* overlapMask, 
+	CollidingSide* sides) const
+{
+	const __m128 queryMinX = _mm_set1_ps(queryEdges[0]), queryMinY = _mm_set1_ps(queryEdges[1]);
+	const __m128 queryMaxX = _mm_set1_ps(queryEdges[2]), queryMaxY = _mm_set1_ps(queryEdges[3]);
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+	const __m128i leftSide = _mm_set1_epi32((int)CollidingSide::LEFT), rightSide = _mm_set1_epi32((int)CollidingSide::RIGHT);
+	const __m128i topSide = _mm_set1_epi32((int)CollidingSide::TOP), bottomSide = _mm_set1_epi32((int)CollidingSide::BOTTOM);
+
+	// SSE2 has no blend instruction, so select between the values with masks instead
+	auto select = [](__m128i mask, __m128i trueValue, __m128i falseValue)
+	{
+		return _mm_or_si128(_mm_and_si128(mask, trueValue), _mm_andnot_si128(mask, falseValue));
+	};
+
+	alignas(16) int32_t sideValues[4];
+	for (size_t index = beginIndex; index < endIndex; index += 4)
+	{
+		const __m128 minX = _mm_loadu_ps(&this->minX[index]), minY = _mm_loadu_ps(&this->minY[index]);
+		const __m128 maxX = _mm_loadu_ps(&this->maxX[index]), maxY = _mm_loadu_ps(&this->maxY[index]);
+
+		const __m128 overlapping = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(maxX, queryMinX), _mm_cmplt_ps(minX, queryMaxX)), 
+			_mm_and_ps(_mm_cmplt_ps(minY, queryMaxY), _mm_cmpgt_ps(maxY, queryMinY)));
+
+		const int overlapBits = _mm_movemask_ps(overlapping);
+		if (overlapBits == 0)
+		{
+			_mm_storeu_si128((__m128i*)sideValues, _mm_setzero_si128());
+		}
+		else
+		{
+			const __m128 leftDistance = _mm_and_ps(_mm_sub_ps(minX, queryMaxX), absMask);
+			const __m128 rightDistance = _mm_and_ps(_mm_sub_ps(maxX, queryMinX), absMask);
+			const __m128 topDistance = _mm_and_ps(_mm_sub_ps(minY, queryMaxY), absMask);
+			const __m128 bottomDistance = _mm_and_ps(_mm_sub_ps(maxY, queryMinY), absMask);
+			const __m128 lowestDistance = _mm_min_ps(_mm_min_ps(rightDistance, leftDistance), _mm_min_ps(topDistance, bottomDistance));
+
+			// Select the sides in reverse priority order, so that ties end up resolved the same way as the scalar kernel
+			__m128i side = bottomSide;
+			side = select(_mm_castps_si128(_mm_cmpeq_ps(topDistance, lowestDistance)), topSide, side);
+			side = select(_mm_castps_si128(_mm_cmpeq_ps(leftDistance, lowestDistance)), leftSide, side);
+			side = select(_mm_castps_si128(_mm_cmpeq_ps(rightDistance, lowestDistance)), rightSide, side);
+			side = _mm_and_si128(side, _mm_castps_si128(overlapping));
+
+			_mm_store_si128((__m128i*)sideValues, side);
+			overlapMask[index / ColliderBatchGlobals::maskWordBits] |= (uint64_t)overlapBits << 
+				(index % ColliderBatchGlobals::maskWordBits);
+		}
+
+		for (size_t lane = 0; lane < 4; lane++)
+			sides[index + lane] = (CollidingSide)sideValues[lane];
+	}
+}
+
+AVX2_FUNCTION void ColliderBatch::TestRangeAVX2(const float queryEdges[4], size_t beginIndex, size_t endIndex, 
+	uint64_t* overlapMask, CollidingSide* sides) const
+{
+	const __m256 queryMinX = _mm256_set1_ps(queryEdges[0]), queryMinY = _mm256_set1_ps(queryEdges[1]);
+	const __m256 queryMaxX = _mm256_set1_ps(queryEdges[2]), queryMaxY = _mm256_set1_ps(queryEdges[3]);
+	const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+	const __m256i leftSide = _mm256_set1_epi32((int)CollidingSide::LEFT), rightSide = _mm256_set1_epi32((int)CollidingSide::RIGHT);
+	const __m256i topSide = _mm256_set1_epi32((int)CollidingSide::TOP), bottomSide = _mm256_set1_epi32((int)CollidingSide::BOTTOM);
+
+	alignas(32) int32_t sideValues[8];
+	for (size_t index = beginIndex; index < endIndex; index += 8)
+	{
+		const __m256 minX = _mm256_loadu_ps(&this->minX[index]), minY = _mm256_loadu_ps(&this->minY[index]);
+		const __m256 maxX = _mm256_loadu_ps(&this->maxX[index]), maxY = _mm256_loadu_ps(&this->maxY[index]);
+
+		const __m256 overlapping = _mm256_and_ps(
+			_mm256_and_ps(_mm256_cmp_ps(maxX, queryMinX, _CMP_GT_OQ), _mm256_cmp_ps(minX, queryMaxX, _CMP_LT_OQ)), 
+			_mm256_and_ps(_mm256_cmp_ps(minY, queryMaxY, _CMP_LT_OQ), _mm256_cmp_ps(maxY, queryMinY, _CMP_GT_OQ)));
+
+		const int overlapBits = _mm256_movemask_ps(overlapping);
+		if (overlapBits == 0)
+		{
+			_mm256_store_si256((__m256i*)sideValues, _mm256_setzero_si256());
+		}
+		else
+		{
+			const __m256 leftDistance = _mm256_and_ps(_mm256_sub_ps(minX, queryMaxX), absMask);
+			const __m256 rightDistance = _mm256_and_ps(_mm256_sub_ps(maxX, queryMinX), absMask);
+			const __m256 topDistance = _mm256_and_ps(_mm256_sub_ps(minY, queryMaxY), absMask);
+			const __m256 bottomDistance = _mm256_and_ps(_mm256_sub_ps(maxY, queryMinY), absMask);
+			const __m256 lowestDistance = _mm256_min_ps(_mm256_min_ps(rightDistance, leftDistance), 
+				_mm256_min_ps(topDistance, bottomDistance));
+
+			// Select the sides in reverse priority order, so that ties end up resolved the same way as the scalar kernel
+			__m256i side = bottomSide;
+			side = _mm256_blendv_epi8(side, topSide, _mm256_castps_si256(_mm256_cmp_ps(topDistance, lowestDistance, _CMP_EQ_OQ)));
+			side = _mm256_blendv_epi8(side, leftSide, _mm256_castps_si256(_mm256_cmp_ps(leftDistance, lowestDistance, _CMP_EQ_OQ)));
+			side = _mm256_blendv_epi8(side, rightSide, _mm256_castps_si256(_mm256_cmp_ps(rightDistance, lowestDistance, _CMP_EQ_OQ)));
+			side = _mm256_and_si256(side, _mm256_castps_si256(overlapping));
+
+			_mm256_store_si256((__m256i*)sideValues, side);
+			overlapMask[index / ColliderBatchGlobals::maskWordBits] |= (uint64_t)overlapBits << 
+				(index % ColliderBatchGlobals::maskWordBits);
+		}
+
+		for (size_t lane = 0; lane < 8; lane++)
+			sides[index + lane] = (CollidingSide)sideValues[lane];
+	}
+}
+
+size_t ColliderBatch::GetSize() const
+{
+	return this->minX.size();
+}
+
+SimdLevel ColliderBatch::GetSupportedSimdLevel()
+{
+	return Util::GetSupportedSimdLevel();
+}
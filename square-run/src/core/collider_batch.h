@@ -0,0 +1,57 @@
+#ifndef COLLIDER_BATCH_H
+#define COLLIDER_BATCH_H
+
+#include <core/collision_detection.h>
+#include <util/simd.h>
+#include <vector>
+#include <cstdint>
+
+// A batch of rectangle colliders stored as structure-of-arrays (the edges of every collider are stored in separate arrays), so that 
+// one collider can be tested against many colliders at once with SIMD instructions.
+class ColliderBatch
+{
+private:
+	std::vector<float> minX, minY, maxX, maxY; // The left, top, right and bottom edges of the colliders
+private:
+	// The collision kernels, each tests the collider edges given against the batch colliders in the range given.
+	void TestRangeScalar(const float queryEdges[4], size_t beginIndex, size_t endIndex, uint64_t* overlapMask, 
+		CollidingSide* sides) const;
+	void TestRangeSSE2(const float queryEdges[4], size_t beginIndex, size_t endIndex, uint64_t* overlapMask, 
+		CollidingSide* sides) const;
+	void TestRangeAVX2(const float queryEdges[4], size_t beginIndex, size_t endIndex, uint64_t* overlapMask, 
+		CollidingSide* sides) const;
+public:
+	ColliderBatch() = default;
+	~ColliderBatch() = default;
+
+	// Reserves enough memory for the number of colliders given.
+	void Reserve(size_t numColliders);
+
+	// Removes every collider from the batch.
+	void Clear();
+
+	// Adds the collider given to the end of the batch.
+	// Returns the index of the collider in the batch.
+	size_t Add(const RectangleCollider& collider);
+
+	// Replaces the collider at the index given.
+	void Set(size_t index, const RectangleCollider& collider);
+
+	// Tests the collider given against every collider in the batch, using the highest instruction set supported by the CPU.
+	// Bit i of the overlap mask is set if the batch collider at index i is colliding, and sides[i] is the side of that batch collider 
+	// being collided with (the same as RectangleCollider::IsColliding would return). The output containers are resized to fit.
+	// Returns the number of batch colliders colliding with the collider given.
+	size_t TestCollider(const RectangleCollider& collider, std::vector<uint64_t>& overlapMask, std::vector<CollidingSide>& sides) const;
+
+	// Same as above, but ran with the instruction set given (which must be supported by the CPU).
+	size_t TestCollider(const RectangleCollider& collider, std::vector<uint64_t>& overlapMask, std::vector<CollidingSide>& sides, 
+		SimdLevel simdLevel) const;
+
+	// Returns the number of colliders in the batch.
+	size_t GetSize() const;
+
+	// Returns the highest instruction set supported by the CPU (and operating system).
+	static SimdLevel GetSupportedSimdLevel();
+};
+
+#endif
@@ -1,5 +1,30 @@
 #include <core/collision_detection.h>
 
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace CollisionGlobals
+{
+	// Returns the contact normal of a hit on the side of a moving collider given.
+	glm::vec2 GetSideNormal(CollidingSide side)
+	{
+		switch (side)
+		{
+		case CollidingSide::LEFT:
+			return { 1.0f, 0.0f };
+		case CollidingSide::RIGHT:
+			return { -1.0f, 0.0f };
+		case CollidingSide::TOP:
+			return { 0.0f, 1.0f };
+		case CollidingSide::BOTTOM:
+			return { 0.0f, -1.0f };
+		default:
+			return { 0.0f, 0.0f };
+		}
+	}
+}
+
 RectangleCollider::RectangleCollider() = default;
 
 RectangleCollider::RectangleCollider(const glm::vec2 & pos, const glm::vec2 & size) :
@@ -62,6 +87,140 @@ CollidingSide RectangleCollider::IsColliding(const RectangleCollider& otherColli
 	return CollidingSide::NONE; // No collision has been detected
 }
 
+SweepResult RectangleCollider::Sweep(const glm::vec2& displacement, const RectangleCollider& otherCollider) const
+{
+	SweepResult result;
+	constexpr float infinity = std::numeric_limits<float>::infinity();
+
+	// Calculate the fractions of the displacement at which the colliders start and stop overlapping on each axis
+	float entryTimeX = -infinity, exitTimeX = infinity;
+	if (displacement.x > 0.0f)
+	{
+		entryTimeX = (otherCollider.GetLeftSidePosition() - this->GetRightSidePosition()) / displacement.x;
+		exitTimeX = (otherCollider.GetRightSidePosition() - this->GetLeftSidePosition()) / displacement.x;
+	}
+	else if (displacement.x < 0.0f)
+	{
+		entryTimeX = (otherCollider.GetRightSidePosition() - this->GetLeftSidePosition()) / displacement.x;
+		exitTimeX = (otherCollider.GetLeftSidePosition() - this->GetRightSidePosition()) / displacement.x;
+	}
+	else if (this->GetRightSidePosition() <= otherCollider.GetLeftSidePosition() ||
+		this->GetLeftSidePosition() >= otherCollider.GetRightSidePosition())
+	{
+		return result; // Not moving on this axis and never overlapping on it
+	}
+
+	float entryTimeY = -infinity, exitTimeY = infinity;
+	if (displacement.y > 0.0f)
+	{
+		entryTimeY = (otherCollider.GetTopSidePosition() - this->GetBottomSidePosition()) / displacement.y;
+		exitTimeY = (otherCollider.GetBottomSidePosition() - this->GetTopSidePosition()) / displacement.y;
+	}
+	else if (displacement.y < 0.0f)
+	{
+		entryTimeY = (otherCollider.GetBottomSidePosition() - this->GetTopSidePosition()) / displacement.y;
+		exitTimeY = (otherCollider.GetTopSidePosition() - this->GetBottomSidePosition()) / displacement.y;
+	}
+	else if (this->GetBottomSidePosition() <= otherCollider.GetTopSidePosition() ||
+		this->GetTopSidePosition() >= otherCollider.GetBottomSidePosition())
+	{
+		return result;
+	}
+
+	// The colliders only overlap while they overlap on both axes
+	const float entryTime = std::max(entryTimeX, entryTimeY);
+	const float exitTime = std::min(exitTimeX, exitTimeY);
+	if (entryTime > exitTime || entryTime > 1.0f || exitTime <= 0.0f)
+		return result;
+
+	if (entryTime < 0.0f)
+	{
+		// The colliders are already overlapping, so only block the displacement if it goes further into the other collider
+		const CollidingSide side = this->IsColliding(otherCollider);
+		const glm::vec2 normal = CollisionGlobals::GetSideNormal(side);
+		if (side == CollidingSide::NONE || glm::dot(displacement, normal) >= 0.0f)
+			return result;
+
+		result.timeOfImpact = 0.0f;
+		result.side = side;
+		result.normal = normal;
+	}
+	else
+	{
+		// The axis which starts overlapping last is the one the colliders touch on, corners are treated as a hit on the X axis
+		result.timeOfImpact = entryTime;
+		if (entryTimeX >= entryTimeY)
+			result.side = displacement.x > 0.0f ? CollidingSide::RIGHT : CollidingSide::LEFT;
+		else
+			result.side = displacement.y > 0.0f ? CollidingSide::BOTTOM : CollidingSide::TOP;
+
+		result.normal = CollisionGlobals::GetSideNormal(result.side);
+	}
+
+	result.hit = true;
+	return result;
+}
+
+bool RectangleCollider::Raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, float& hitDistance, 
+	CollidingSide& hitSide) const
+{
+	constexpr float infinity = std::numeric_limits<float>::infinity();
+	float entryDistance = -infinity, exitDistance = infinity;
+	CollidingSide entrySide = CollidingSide::NONE;
+
+	// Intersect the ray with the slabs of the collider on both axes
+	if (direction.x != 0.0f)
+	{
+		const float leftDistance = (this->GetLeftSidePosition() - origin.x) / direction.x;
+		const float rightDistance = (this->GetRightSidePosition() - origin.x) / direction.x;
+
+		entryDistance = std::min(leftDistance, rightDistance);
+		exitDistance = std::max(leftDistance, rightDistance);
+		entrySide = direction.x > 0.0f ? CollidingSide::LEFT : CollidingSide::RIGHT;
+	}
+	else if (origin.x <= this->GetLeftSidePosition() || origin.x >= this->GetRightSidePosition())
+		return false;
+
+	if (direction.y != 0.0f)
+	{
+		const float topDistance = (this->GetTopSidePosition() - origin.y) / direction.y;
+		const float bottomDistance = (this->GetBottomSidePosition() - origin.y) / direction.y;
+
+		if (std::min(topDistance, bottomDistance) > entryDistance)
+		{
+			entryDistance = std::min(topDistance, bottomDistance);
+			entrySide = direction.y > 0.0f ? CollidingSide::TOP : CollidingSide::BOTTOM;
+		}
+
+		exitDistance = std::min(exitDistance, std::max(topDistance, bottomDistance));
+	}
+	else if (origin.y <= this->GetTopSidePosition() || origin.y >= this->GetBottomSidePosition())
+		return false;
+
+	if (entryDistance > exitDistance || exitDistance < 0.0f || entryDistance > maxDistance)
+		return false;
+
+	// The ray started inside of the collider
+	if (entryDistance < 0.0f)
+	{
+		entryDistance = 0.0f;
+		entrySide = CollidingSide::NONE;
+	}
+
+	hitDistance = entryDistance;
+	hitSide = entrySide;
+	return true;
+}
+
+glm::vec2 RectangleCollider::GetSlideDisplacement(const glm::vec2& displacement, const SweepResult& sweepResult)
+{
+	if (!sweepResult.hit)
+		return glm::vec2(0.0f);
+
+	const glm::vec2 remainingDisplacement = displacement * (1.0f - sweepResult.timeOfImpact);
+	return remainingDisplacement - (sweepResult.normal * glm::dot(remainingDisplacement, sweepResult.normal));
+}
+
 float RectangleCollider::GetLeftSidePosition() const
 {
 	return this->position.x - (this->size.x / 2.0f);
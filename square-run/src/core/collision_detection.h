@@ -12,6 +12,15 @@ enum class CollidingSide
 	BOTTOM
 };
 
+// The result of sweeping a moving rectangle collider against another rectangle collider.
+struct SweepResult
+{
+	bool hit = false;
+	float timeOfImpact = 1.0f; // The fraction of the displacement travelled before the colliders touch, from 0.0f to 1.0f
+	glm::vec2 normal = glm::vec2(0.0f); // The contact normal, pointing away from the other collider towards the moving collider
+	CollidingSide side = CollidingSide::NONE; // The side of the moving collider that hits the other collider
+};
+
 class RectangleCollider
 {
 private:
@@ -31,6 +40,21 @@ public:
 	// If no collision is occurring, no side is returned (aka CollidingSide::NONE).
 	CollidingSide IsColliding(const RectangleCollider& otherCollider) const;
 
+	// Sweeps the rectangle collider along the displacement given, and returns when and where it first hits the other rectangle collider.
+	// If the colliders are already overlapping, a hit at time zero is only returned if the displacement moves them further into each 
+	// other, so that overlapping colliders are always free to separate.
+	SweepResult Sweep(const glm::vec2& displacement, const RectangleCollider& otherCollider) const;
+
+	// Casts the ray given (the direction must be normalized) against the rectangle collider.
+	// Returns TRUE if the ray hits within the maximum distance given, along with the distance to the hit and the side of the collider 
+	// the ray entered through. If the ray starts inside the collider, the distance is zero and no side is given.
+	bool Raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, float& hitDistance, 
+		CollidingSide& hitSide) const;
+
+	// Returns the part of the displacement left over after the sweep hit given, with the component going into the contact surface 
+	// removed (i.e. the rest of the movement slides along the surface).
+	static glm::vec2 GetSlideDisplacement(const glm::vec2& displacement, const SweepResult& sweepResult);
+
 	// Returns the X axis position of the left side of the rectangle collider.
 	float GetLeftSidePosition() const;
 
@@ -0,0 +1,564 @@
+#include <core/collision_world.h>
+#include <util/logging_system.h>
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace CollisionWorldGlobals
+{
+	// The maximum number of surfaces the collider can slide along in one move
+	constexpr int maxSlideIterations = 4;
+
+	// The distance colliders are kept away from the surfaces they're moved against
+	constexpr float contactSkinWidth = 0.001f;
+
+	// The cell table is kept at most half full, so the searches through it stay short
+	constexpr size_t minCellTableSize = 64;
+
+	// The handles reserved by every new cell, so that the pooled cells rarely need to grow when reused by busier cells
+	constexpr size_t minCellCapacity = 8;
+}
+
+CollisionWorld::CollisionWorld(float cellSize) :
+	cellSize(cellSize), numColliders(0), occupiedMinCell(0), occupiedMaxCell(0), occupiedBoundsDirty(false), currentQueryStamp(0)
+{
+	if (cellSize <= 0.0f)
+		LogSystem::GetInstance().OutputLog("The cell size of a collision world must be greater than zero", Severity::FATAL);
+}
+
+uint64_t CollisionWorld::GetCellKey(int cellX, int cellY)
+{
+	return ((uint64_t)(uint32_t)cellX << 32) | (uint32_t)cellY;
+}
+
+size_t CollisionWorld::GetCellSlot(uint64_t cellKey) const
+{
+	// Mix the bits of the key (the splitmix64 finaliser), as neighbouring cells have keys which only differ in their lower bits
+	cellKey = (cellKey ^ (cellKey >> 30)) * 0xBF58476D1CE4E5B9ull;
+	cellKey = (cellKey ^ (cellKey >> 27)) * 0x94D049BB133111EBull;
+	return (size_t)(cellKey ^ (cellKey >> 31)) & (this->cellTable.size() - 1);
+}
+
+glm::ivec2 CollisionWorld::GetCellCoords(const glm::vec2& point) const
+{
+	return { (int)std::floor(point.x / this->cellSize), (int)std::floor(point.y / this->cellSize) };
+}
+
+uint32_t CollisionWorld::FindCell(int cellX, int cellY) const
+{
+	if (this->occupiedCells.empty())
+		return CollisionWorldGlobals::invalidCell;
+
+	const uint64_t cellKey = CollisionWorld::GetCellKey(cellX, cellY);
+	const size_t slotMask = this->cellTable.size() - 1;
+
+	for (size_t slot = this->GetCellSlot(cellKey);; slot = (slot + 1) & slotMask)
+	{
+		const uint32_t cellIndex = this->cellTable[slot];
+		if (cellIndex == CollisionWorldGlobals::invalidCell || this->cellStorage[cellIndex].key == cellKey)
+			return cellIndex;
+	}
+}
+
+uint32_t CollisionWorld::AcquireCell(int cellX, int cellY)
+{
+	uint32_t cellIndex = this->FindCell(cellX, cellY);
+	if (cellIndex != CollisionWorldGlobals::invalidCell)
+		return cellIndex;
+
+	if ((this->occupiedCells.size() + 1) * 2 > this->cellTable.size())
+		this->ResizeCellTable(std::max(this->cellTable.size() * 2, CollisionWorldGlobals::minCellTableSize));
+
+	// Reuse the storage of a released cell if there is any
+	if (!this->freeCells.empty())
+	{
+		cellIndex = this->freeCells.back();
+		this->freeCells.pop_back();
+	}
+	else
+	{
+		cellIndex = (uint32_t)this->cellStorage.size();
+		this->cellStorage.emplace_back().handles.reserve(CollisionWorldGlobals::minCellCapacity);
+	}
+
+	Cell& cell = this->cellStorage[cellIndex];
+	cell.key = CollisionWorld::GetCellKey(cellX, cellY);
+	cell.occupiedIndex = (uint32_t)this->occupiedCells.size();
+	this->occupiedCells.emplace_back(cellIndex);
+
+	const size_t slotMask = this->cellTable.size() - 1;
+	size_t slot = this->GetCellSlot(cell.key);
+	while (this->cellTable[slot] != CollisionWorldGlobals::invalidCell)
+		slot = (slot + 1) & slotMask;
+
+	this->cellTable[slot] = cellIndex;
+
+	// The bounds only grow as cells are occupied, so they're kept up to date here unless they need recalculating anyway
+	const glm::ivec2 cellCoords = { cellX, cellY };
+	if (this->occupiedCells.size() == 1)
+	{
+		this->occupiedMinCell = this->occupiedMaxCell = cellCoords;
+		this->occupiedBoundsDirty = false;
+	}
+	else if (!this->occupiedBoundsDirty)
+	{
+		this->occupiedMinCell = glm::min(this->occupiedMinCell, cellCoords);
+		this->occupiedMaxCell = glm::max(this->occupiedMaxCell, cellCoords);
+	}
+
+	return cellIndex;
+}
+
+void CollisionWorld::ReleaseCell(uint32_t cellIndex)
+{
+	Cell& cell = this->cellStorage[cellIndex];
+	const size_t slotMask = this->cellTable.size() - 1;
+
+	size_t slot = this->GetCellSlot(cell.key);
+	while (this->cellTable[slot] != cellIndex)
+		slot = (slot + 1) & slotMask;
+
+	// Shift the cells after the slot back into it where their search would still find them, so no search is cut short by the gap
+	for (size_t nextSlot = (slot + 1) & slotMask; this->cellTable[nextSlot] != CollisionWorldGlobals::invalidCell;
+		nextSlot = (nextSlot + 1) & slotMask)
+	{
+		const size_t idealSlot = this->GetCellSlot(this->cellStorage[this->cellTable[nextSlot]].key);
+		if (((nextSlot - idealSlot) & slotMask) >= ((nextSlot - slot) & slotMask))
+		{
+			this->cellTable[slot] = this->cellTable[nextSlot];
+			slot = nextSlot;
+		}
+	}
+
+	this->cellTable[slot] = CollisionWorldGlobals::invalidCell;
+
+	// The order of the occupied cells doesn't matter, so swap the cell with the last one and pop it off
+	const uint32_t lastCellIndex = this->occupiedCells.back();
+	this->occupiedCells[cell.occupiedIndex] = lastCellIndex;
+	this->cellStorage[lastCellIndex].occupiedIndex = cell.occupiedIndex;
+	this->occupiedCells.pop_back();
+
+	this->freeCells.emplace_back(cellIndex);
+	this->occupiedBoundsDirty = true;
+}
+
+void CollisionWorld::ResizeCellTable(size_t tableSize)
+{
+	this->cellTable.assign(tableSize, CollisionWorldGlobals::invalidCell);
+
+	const size_t slotMask = tableSize - 1;
+	for (const uint32_t& cellIndex : this->occupiedCells)
+	{
+		size_t slot = this->GetCellSlot(this->cellStorage[cellIndex].key);
+		while (this->cellTable[slot] != CollisionWorldGlobals::invalidCell)
+			slot = (slot + 1) & slotMask;
+
+		this->cellTable[slot] = cellIndex;
+	}
+}
+
+void CollisionWorld::UpdateOccupiedBounds()
+{
+	if (!this->occupiedBoundsDirty)
+		return;
+
+	this->occupiedMinCell = glm::ivec2(std::numeric_limits<int>::max());
+	this->occupiedMaxCell = glm::ivec2(std::numeric_limits<int>::min());
+
+	for (const uint32_t& cellIndex : this->occupiedCells)
+	{
+		const uint64_t cellKey = this->cellStorage[cellIndex].key;
+		const glm::ivec2 cellCoords = { (int)(uint32_t)(cellKey >> 32), (int)(uint32_t)cellKey };
+
+		this->occupiedMinCell = glm::min(this->occupiedMinCell, cellCoords);
+		this->occupiedMaxCell = glm::max(this->occupiedMaxCell, cellCoords);
+	}
+
+	this->occupiedBoundsDirty = false;
+}
+
+void CollisionWorld::AddToCells(ColliderHandle handle)
+{
+	ColliderEntry& entry = this->colliders[handle];
+	entry.minCell = this->GetCellCoords({ entry.collider.GetLeftSidePosition(), entry.collider.GetTopSidePosition() });
+	entry.maxCell = this->GetCellCoords({ entry.collider.GetRightSidePosition(), entry.collider.GetBottomSidePosition() });
+
+	for (int cellY = entry.minCell.y; cellY <= entry.maxCell.y; cellY++)
+	{
+		for (int cellX = entry.minCell.x; cellX <= entry.maxCell.x; cellX++)
+			this->cellStorage[this->AcquireCell(cellX, cellY)].handles.emplace_back(handle);
+	}
+}
+
+void CollisionWorld::RemoveFromCells(ColliderHandle handle)
+{
+	const ColliderEntry& entry = this->colliders[handle];
+	for (int cellY = entry.minCell.y; cellY <= entry.maxCell.y; cellY++)
+	{
+		for (int cellX = entry.minCell.x; cellX <= entry.maxCell.x; cellX++)
+		{
+			const uint32_t cellIndex = this->FindCell(cellX, cellY);
+			if (cellIndex == CollisionWorldGlobals::invalidCell)
+				continue;
+
+			// The order of the handles in a cell doesn't matter, so swap the handle with the last one and pop it off
+			std::vector<ColliderHandle>& cellHandles = this->cellStorage[cellIndex].handles;
+			auto handleIterator = std::find(cellHandles.begin(), cellHandles.end(), handle);
+			if (handleIterator != cellHandles.end())
+			{
+				*handleIterator = cellHandles.back();
+				cellHandles.pop_back();
+			}
+
+			if (cellHandles.empty())
+				this->ReleaseCell(cellIndex);
+		}
+	}
+}
+
+uint32_t CollisionWorld::BeginQuery()
+{
+	// Once the stamp wraps around, the old stamps could be mistaken for the new ones so reset them all
+	if (++this->currentQueryStamp == 0)
+	{
+		for (ColliderEntry& entry : this->colliders)
+			entry.queryStamp = 0;
+
+		this->currentQueryStamp = 1;
+	}
+
+	return this->currentQueryStamp;
+}
+
+ColliderHandle CollisionWorld::Insert(const RectangleCollider& collider)
+{
+	// Reuse a handle of a removed collider if there are any
+	ColliderHandle handle = 0;
+	if (!this->freeHandles.empty())
+	{
+		handle = this->freeHandles.back();
+		this->freeHandles.pop_back();
+	}
+	else
+	{
+		handle = (ColliderHandle)this->colliders.size();
+		this->colliders.emplace_back();
+	}
+
+	ColliderEntry& entry = this->colliders[handle];
+	entry.collider = collider;
+	entry.queryStamp = 0;
+	entry.active = true;
+
+	this->AddToCells(handle);
+	this->numColliders++;
+
+	return handle;
+}
+
+void CollisionWorld::Update(ColliderHandle handle, const RectangleCollider& collider)
+{
+	if (!this->IsValid(handle))
+		return;
+
+	ColliderEntry& entry = this->colliders[handle];
+	const glm::ivec2 newMinCell = this->GetCellCoords({ collider.GetLeftSidePosition(), collider.GetTopSidePosition() });
+	const glm::ivec2 newMaxCell = this->GetCellCoords({ collider.GetRightSidePosition(), collider.GetBottomSidePosition() });
+
+	// Only move the collider between cells if it covers different cells now
+	if (newMinCell != entry.minCell || newMaxCell != entry.maxCell)
+	{
+		this->RemoveFromCells(handle);
+		entry.collider = collider;
+		this->AddToCells(handle);
+	}
+	else
+		entry.collider = collider;
+}
+
+void CollisionWorld::Remove(ColliderHandle handle)
+{
+	if (!this->IsValid(handle))
+		return;
+
+	this->RemoveFromCells(handle);
+	this->colliders[handle].active = false;
+	this->freeHandles.emplace_back(handle);
+	this->numColliders--;
+}
+
+void CollisionWorld::Clear()
+{
+	// The cells are cleared rather than freed, so their storage is reused by the colliders inserted afterwards
+	for (const uint32_t& cellIndex : this->occupiedCells)
+	{
+		this->cellStorage[cellIndex].handles.clear();
+		this->freeCells.emplace_back(cellIndex);
+	}
+
+	std::fill(this->cellTable.begin(), this->cellTable.end(), CollisionWorldGlobals::invalidCell);
+	this->occupiedCells.clear();
+	this->occupiedBoundsDirty = false;
+
+	this->colliders.clear();
+	this->freeHandles.clear();
+	this->numColliders = 0;
+}
+
+const std::vector<ColliderOverlap>& CollisionWorld::QueryOverlaps(const RectangleCollider& box)
+{
+	this->overlapResults.clear();
+	const uint32_t queryStamp = this->BeginQuery();
+
+	const glm::ivec2 minCell = this->GetCellCoords({ box.GetLeftSidePosition(), box.GetTopSidePosition() });
+	const glm::ivec2 maxCell = this->GetCellCoords({ box.GetRightSidePosition(), box.GetBottomSidePosition() });
+
+	for (int cellY = minCell.y; cellY <= maxCell.y; cellY++)
+	{
+		for (int cellX = minCell.x; cellX <= maxCell.x; cellX++)
+		{
+			const uint32_t cellIndex = this->FindCell(cellX, cellY);
+			if (cellIndex == CollisionWorldGlobals::invalidCell)
+				continue;
+
+			for (const ColliderHandle& handle : this->cellStorage[cellIndex].handles)
+			{
+				ColliderEntry& entry = this->colliders[handle];
+				if (entry.queryStamp == queryStamp)
+					continue;
+
+				entry.queryStamp = queryStamp;
+
+				const CollidingSide side = entry.collider.IsColliding(box);
+				if (side != CollidingSide::NONE)
+					this->overlapResults.push_back({ handle, side });
+			}
+		}
+	}
+
+	return this->overlapResults;
+}
+
+const std::vector<ColliderPair>& CollisionWorld::QueryPairs()
+{
+	this->pairResults.clear();
+
+	// Only the occupied cells are walked through, so the cells colliders have left behind cost nothing
+	for (const uint32_t& cellIndex : this->occupiedCells)
+	{
+		const uint64_t cellKey = this->cellStorage[cellIndex].key;
+		const std::vector<ColliderHandle>& cell = this->cellStorage[cellIndex].handles;
+
+		for (size_t firstIndex = 0; firstIndex < cell.size(); firstIndex++)
+		{
+			const ColliderEntry& firstEntry = this->colliders[cell[firstIndex]];
+			for (size_t secondIndex = firstIndex + 1; secondIndex < cell.size(); secondIndex++)
+			{
+				const ColliderEntry& secondEntry = this->colliders[cell[secondIndex]];
+
+				const CollidingSide side = firstEntry.collider.IsColliding(secondEntry.collider);
+				if (side == CollidingSide::NONE)
+					continue;
+
+				// A pair of colliders can share many cells, so the pair is only reported by the cell containing the top left corner 
+				// of the area where the colliders overlap
+				const glm::vec2 overlapCorner = { 
+					std::max(firstEntry.collider.GetLeftSidePosition(), secondEntry.collider.GetLeftSidePosition()),
+					std::max(firstEntry.collider.GetTopSidePosition(), secondEntry.collider.GetTopSidePosition()) };
+
+				const glm::ivec2 overlapCell = this->GetCellCoords(overlapCorner);
+				if (CollisionWorld::GetCellKey(overlapCell.x, overlapCell.y) == cellKey)
+					this->pairResults.push_back({ cell[firstIndex], cell[secondIndex], side });
+			}
+		}
+	}
+
+	return this->pairResults;
+}
+
+const std::vector<RaycastHit>& CollisionWorld::QueryRay(const glm::vec2& origin, const glm::vec2& direction, float maxDistance)
+{
+	this->raycastResults.clear();
+
+	const float directionLength = glm::length(direction);
+	if (directionLength <= 0.0f || maxDistance <= 0.0f || this->numColliders == 0)
+		return this->raycastResults;
+
+	const glm::vec2 rayDirection = direction / directionLength;
+	constexpr float infinity = std::numeric_limits<float>::infinity();
+
+	// Only the part of the ray within the bounds of the occupied cells is walked through, so the walk is cut short even when the 
+	// maximum distance is infinite, and it starts at the bounds when the origin is outside of them
+	this->UpdateOccupiedBounds();
+	const glm::vec2 boundsMin = glm::vec2(this->occupiedMinCell) * this->cellSize;
+	const glm::vec2 boundsMax = glm::vec2(this->occupiedMaxCell + 1) * this->cellSize;
+
+	float entryDistance = 0.0f, exitDistance = maxDistance;
+	for (int axis = 0; axis < 2; axis++)
+	{
+		if (rayDirection[axis] == 0.0f)
+		{
+			if (origin[axis] < boundsMin[axis] || origin[axis] > boundsMax[axis])
+				return this->raycastResults;
+
+			continue;
+		}
+
+		const float firstDistance = (boundsMin[axis] - origin[axis]) / rayDirection[axis];
+		const float secondDistance = (boundsMax[axis] - origin[axis]) / rayDirection[axis];
+		entryDistance = std::max(entryDistance, std::min(firstDistance, secondDistance));
+		exitDistance = std::min(exitDistance, std::max(firstDistance, secondDistance));
+	}
+
+	if (entryDistance > exitDistance)
+		return this->raycastResults;
+
+	const uint32_t queryStamp = this->BeginQuery();
+
+	// Walk through the cells the ray passes through in order (a DDA traversal), the distances to the next cell boundary on 
+	// each axis are stepped along and the nearest one is crossed each iteration
+	glm::ivec2 cell = glm::clamp(this->GetCellCoords(origin + (rayDirection * entryDistance)), this->occupiedMinCell,
+		this->occupiedMaxCell);
+
+	const glm::ivec2 cellStep = { rayDirection.x > 0.0f ? 1 : -1, rayDirection.y > 0.0f ? 1 : -1 };
+
+	const glm::vec2 boundaryDistanceStep = { rayDirection.x != 0.0f ? this->cellSize / std::abs(rayDirection.x) : infinity,
+		rayDirection.y != 0.0f ? this->cellSize / std::abs(rayDirection.y) : infinity };
+
+	glm::vec2 nextBoundaryDistance;
+	nextBoundaryDistance.x = rayDirection.x != 0.0f ? 
+		(((float)(cell.x + (cellStep.x > 0 ? 1 : 0)) * this->cellSize) - origin.x) / rayDirection.x : infinity;
+	nextBoundaryDistance.y = rayDirection.y != 0.0f ? 
+		(((float)(cell.y + (cellStep.y > 0 ? 1 : 0)) * this->cellSize) - origin.y) / rayDirection.y : infinity;
+
+	float cellEntryDistance = entryDistance;
+	while (cellEntryDistance <= exitDistance)
+	{
+		const uint32_t cellIndex = this->FindCell(cell.x, cell.y);
+		if (cellIndex != CollisionWorldGlobals::invalidCell)
+		{
+			for (const ColliderHandle& handle : this->cellStorage[cellIndex].handles)
+			{
+				ColliderEntry& entry = this->colliders[handle];
+				if (entry.queryStamp == queryStamp)
+					continue;
+
+				entry.queryStamp = queryStamp;
+
+				float hitDistance = 0.0f;
+				CollidingSide hitSide = CollidingSide::NONE;
+				if (entry.collider.Raycast(origin, rayDirection, maxDistance, hitDistance, hitSide))
+					this->raycastResults.push_back({ handle, hitDistance, origin + (rayDirection * hitDistance), hitSide });
+			}
+		}
+
+		// Cross into the next cell
+		if (nextBoundaryDistance.x < nextBoundaryDistance.y)
+		{
+			cellEntryDistance = nextBoundaryDistance.x;
+			nextBoundaryDistance.x += boundaryDistanceStep.x;
+			cell.x += cellStep.x;
+		}
+		else
+		{
+			cellEntryDistance = nextBoundaryDistance.y;
+			nextBoundaryDistance.y += boundaryDistanceStep.y;
+			cell.y += cellStep.y;
+		}
+	}
+
+	std::sort(this->raycastResults.begin(), this->raycastResults.end(), 
+		[](const RaycastHit& first, const RaycastHit& second) { return first.distance < second.distance; });
+
+	return this->raycastResults;
+}
+
+SweepHit CollisionWorld::Sweep(const RectangleCollider& collider, const glm::vec2& displacement, ColliderHandle ignoredHandle)
+{
+	SweepHit earliestHit;
+	if (displacement.x == 0.0f && displacement.y == 0.0f)
+		return earliestHit;
+
+	// Only the colliders touching the box covering the whole sweep can be hit
+	const glm::vec2 sweepMin = glm::min(glm::vec2(collider.GetLeftSidePosition(), collider.GetTopSidePosition()),
+		glm::vec2(collider.GetLeftSidePosition(), collider.GetTopSidePosition()) + displacement);
+	const glm::vec2 sweepMax = glm::max(glm::vec2(collider.GetRightSidePosition(), collider.GetBottomSidePosition()),
+		glm::vec2(collider.GetRightSidePosition(), collider.GetBottomSidePosition()) + displacement);
+
+	// The sweep box is grown slightly, as colliders which are only touching aren't reported as overlapping
+	const glm::vec2 sweepPadding = glm::vec2(CollisionWorldGlobals::contactSkinWidth);
+	const RectangleCollider sweepBox((sweepMin + sweepMax) / 2.0f, (sweepMax - sweepMin) + (sweepPadding * 2.0f));
+
+	for (const ColliderOverlap& overlap : this->QueryOverlaps(sweepBox))
+	{
+		if (overlap.handle == ignoredHandle)
+			continue;
+
+		const SweepResult result = collider.Sweep(displacement, this->colliders[overlap.handle].collider);
+		if (result.hit && (!earliestHit.result.hit || result.timeOfImpact < earliestHit.result.timeOfImpact))
+		{
+			earliestHit.handle = overlap.handle;
+			earliestHit.result = result;
+		}
+	}
+
+	return earliestHit;
+}
+
+SweepHit CollisionWorld::MoveAndSlide(RectangleCollider& collider, const glm::vec2& displacement, ColliderHandle ignoredHandle)
+{
+	SweepHit firstHit;
+	glm::vec2 remainingDisplacement = displacement;
+
+	for (int iteration = 0; iteration < CollisionWorldGlobals::maxSlideIterations; iteration++)
+	{
+		const SweepHit hit = this->Sweep(collider, remainingDisplacement, ignoredHandle);
+		if (!hit.result.hit)
+		{
+			collider.SetPosition(collider.GetPosition() + remainingDisplacement);
+			break;
+		}
+
+		if (!firstHit.result.hit)
+			firstHit = hit;
+
+		// Move up to the contact point, backing off by the skin width so that the collider doesn't end up overlapping the surface
+		const float displacementLength = glm::length(remainingDisplacement);
+		const float safeTimeOfImpact = std::max(hit.result.timeOfImpact - 
+			(CollisionWorldGlobals::contactSkinWidth / displacementLength), 0.0f);
+
+		collider.SetPosition(collider.GetPosition() + (remainingDisplacement * safeTimeOfImpact));
+		remainingDisplacement = RectangleCollider::GetSlideDisplacement(remainingDisplacement, hit.result);
+
+		if (remainingDisplacement.x == 0.0f && remainingDisplacement.y == 0.0f)
+			break;
+	}
+
+	return firstHit;
+}
+
+const RectangleCollider& CollisionWorld::GetCollider(ColliderHandle handle) const
+{
+	return this->colliders[handle].collider;
+}
+
+bool CollisionWorld::IsValid(ColliderHandle handle) const
+{
+	return handle < this->colliders.size() && this->colliders[handle].active;
+}
+
+const size_t& CollisionWorld::GetNumColliders() const
+{
+	return this->numColliders;
+}
+
+const float& CollisionWorld::GetCellSize() const
+{
+	return this->cellSize;
+}
+
+CollisionWorldPtr Memory::CreateCollisionWorld(float cellSize)
+{
+	return std::make_shared<CollisionWorld>(cellSize);
+}
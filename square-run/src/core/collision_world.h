@@ -0,0 +1,177 @@
+#ifndef COLLISION_WORLD_H
+#define COLLISION_WORLD_H
+
+#include <core/collision_detection.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+using ColliderHandle = uint32_t;
+
+namespace CollisionWorldGlobals
+{
+	constexpr ColliderHandle invalidHandle = UINT32_MAX;
+	constexpr uint32_t invalidCell = UINT32_MAX;
+}
+
+// A collider overlapping the box queried, the side is the side of the collider being collided with by the box.
+struct ColliderOverlap
+{
+	ColliderHandle handle;
+	CollidingSide side;
+};
+
+// A pair of overlapping colliders, the side is the side of the first collider being collided with by the second collider.
+struct ColliderPair
+{
+	ColliderHandle first, second;
+	CollidingSide side;
+};
+
+// A collider hit by the ray queried, the side is the side of the collider the ray entered through.
+// If the ray started inside of the collider, the distance is zero and no side is given.
+struct RaycastHit
+{
+	ColliderHandle handle;
+	float distance;
+	glm::vec2 point;
+	CollidingSide side;
+};
+
+// The earliest collider hit when sweeping a collider through the world.
+struct SweepHit
+{
+	ColliderHandle handle = CollisionWorldGlobals::invalidHandle;
+	SweepResult result;
+};
+
+class CollisionWorld
+{
+private:
+	struct ColliderEntry
+	{
+		RectangleCollider collider;
+		glm::ivec2 minCell, maxCell;
+		uint32_t queryStamp = 0; // The last query which visited the collider, so that colliders spanning cells are visited once
+		bool active = false;
+	};
+
+	struct Cell
+	{
+		uint64_t key = 0;
+		std::vector<ColliderHandle> handles;
+		uint32_t occupiedIndex = 0; // The index of the cell in the occupied cells
+	};
+private:
+	float cellSize;
+	std::vector<ColliderEntry> colliders;
+	std::vector<ColliderHandle> freeHandles;
+	size_t numColliders;
+
+	// The cells are released once their last collider leaves, and their storage is pooled so that it's reused by the cells occupied
+	// afterwards. The cells are found through an open addressing table of cell indices, so occupying a cell doesn't allocate either.
+	std::vector<Cell> cellStorage;
+	std::vector<uint32_t> freeCells, occupiedCells, cellTable;
+	glm::ivec2 occupiedMinCell, occupiedMaxCell; // The bounds of the occupied cells, recalculated when needed once a cell is released
+	bool occupiedBoundsDirty;
+	uint32_t currentQueryStamp;
+
+	std::vector<ColliderOverlap> overlapResults;
+	std::vector<ColliderPair> pairResults;
+	std::vector<RaycastHit> raycastResults;
+private:
+	// Returns the key of the cell at the cell coordinates given.
+	static uint64_t GetCellKey(int cellX, int cellY);
+
+	// Returns the slot of the cell table the search for the cell key given starts at.
+	size_t GetCellSlot(uint64_t cellKey) const;
+
+	// Returns the coordinates of the cell containing the point given.
+	glm::ivec2 GetCellCoords(const glm::vec2& point) const;
+
+	// Returns the index of the occupied cell at the cell coordinates given, or an invalid cell if it isn't occupied.
+	uint32_t FindCell(int cellX, int cellY) const;
+
+	// Returns the index of the cell at the cell coordinates given, occupying it if it isn't already.
+	uint32_t AcquireCell(int cellX, int cellY);
+
+	// Returns the storage of the cell given (which must have no colliders left) to the pool.
+	void ReleaseCell(uint32_t cellIndex);
+
+	// Resizes the cell table to the size given and inserts the occupied cells back into it.
+	void ResizeCellTable(size_t tableSize);
+
+	// Calculates the bounds of the occupied cells again, if a cell was released since they were last calculated.
+	void UpdateOccupiedBounds();
+
+	// Adds the collider of the handle given to every cell it covers.
+	void AddToCells(ColliderHandle handle);
+
+	// Removes the collider of the handle given from every cell it covers.
+	void RemoveFromCells(ColliderHandle handle);
+
+	// Starts a new query, returning the stamp used to mark the colliders visited by it.
+	uint32_t BeginQuery();
+public:
+	CollisionWorld(float cellSize);
+	~CollisionWorld() = default;
+
+	// Inserts the collider given into the world.
+	// Returns the handle used to refer to the collider from then on.
+	ColliderHandle Insert(const RectangleCollider& collider);
+
+	// Replaces the collider of the handle given, moving it between cells if needed.
+	void Update(ColliderHandle handle, const RectangleCollider& collider);
+
+	// Removes the collider of the handle given from the world, the handle may be reused by colliders inserted afterwards.
+	void Remove(ColliderHandle handle);
+
+	// Removes every collider from the world.
+	void Clear();
+
+	// Returns the colliders overlapping the box given.
+	// The results are stored in a buffer reused by every overlap query, so they're only valid until the next one.
+	const std::vector<ColliderOverlap>& QueryOverlaps(const RectangleCollider& box);
+
+	// Returns every pair of overlapping colliders in the world, each pair being reported once.
+	// The results are stored in a buffer reused by every pair query, so they're only valid until the next one.
+	const std::vector<ColliderPair>& QueryPairs();
+
+	// Returns the colliders hit by the ray given within the maximum distance given, sorted from nearest to furthest.
+	// The results are stored in a buffer reused by every ray query, so they're only valid until the next one.
+	const std::vector<RaycastHit>& QueryRay(const glm::vec2& origin, const glm::vec2& direction, float maxDistance);
+
+	// Sweeps the collider given along the displacement given, and returns the first collider in the world it hits.
+	// The collider of the handle given to ignore is skipped, so that colliders in the world can be swept against the rest of it.
+	SweepHit Sweep(const RectangleCollider& collider, const glm::vec2& displacement, 
+		ColliderHandle ignoredHandle = CollisionWorldGlobals::invalidHandle);
+
+	// Moves the collider given along the displacement given, stopping at the colliders in the world it hits and sliding the rest of 
+	// the way along their surfaces. The collider is kept a small distance away from the surfaces, so it doesn't get stuck on them.
+	// Returns the first collider hit, if any.
+	SweepHit MoveAndSlide(RectangleCollider& collider, const glm::vec2& displacement, 
+		ColliderHandle ignoredHandle = CollisionWorldGlobals::invalidHandle);
+
+	// Returns the collider of the handle given.
+	const RectangleCollider& GetCollider(ColliderHandle handle) const;
+
+	// Returns TRUE if the handle given refers to a collider in the world, else FALSE is returned.
+	bool IsValid(ColliderHandle handle) const;
+
+	// Returns the number of colliders in the world.
+	const size_t& GetNumColliders() const;
+
+	// Returns the size of the cells in the world.
+	const float& GetCellSize() const;
+};
+
+using CollisionWorldPtr = std::shared_ptr<CollisionWorld>;
+
+namespace Memory
+{
+	// Returns a shared pointer to the new created collision world.
+	extern CollisionWorldPtr CreateCollisionWorld(float cellSize);
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <core/collision_world.h>
+#include <glm/glm.hpp>
+
+// The placement of an entity in the world.
+struct TransformComponent
+{
+	glm::vec2 position, size;
+	float rotationAngle = 0.0f; // In degrees
+};
+
+// Moves the entity at a constant velocity.
+struct VelocityComponent
+{
+	glm::vec2 velocity; // In units per second
+};
+
+// Moves the entity back to its start position once it has been moving for the loop duration, used for looping effects.
+struct LoopingMotionComponent
+{
+	glm::vec2 startPosition;
+	float loopDuration = 0.0f, elapsedTime = 0.0f; // In seconds
+	bool looped = false; // Set on the update the loop duration passed, the entity is moved back later in the same update
+};
+
+// Renders the entity as a colored rectangle, every entity with one is rendered in a single instanced draw call.
+struct RectRenderComponent
+{
+	glm::vec4 color = glm::vec4(255);
+};
+
+// Gives the entity a collider in a collision world, the collider follows the entity's transform.
+struct ColliderComponent
+{
+	ColliderHandle handle = CollisionWorldGlobals::invalidHandle; // Invalid until the collider is first synced
+};
+
+#endif
@@ -0,0 +1,126 @@
+#include <core/entity_registry.h>
+#include <util/logging_system.h>
+
+#include <atomic>
+
+namespace ComponentType
+{
+	ComponentTypeID GenerateID()
+	{
+		static std::atomic<ComponentTypeID> nextTypeID = 0;
+		const ComponentTypeID typeID = nextTypeID.fetch_add(1);
+
+		if (typeID >= EntityGlobals::maxComponentTypes)
+			LogSystem::GetInstance().OutputLog("Exceeded the maximum number of component types", Severity::FATAL);
+
+		return typeID;
+	}
+}
+
+bool Entity::operator==(const Entity& other) const
+{
+	return this->index == other.index && this->generation == other.generation;
+}
+
+bool Entity::operator!=(const Entity& other) const
+{
+	return !(*this == other);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+EntityRegistry::EntityRegistry() :
+	numEntities(0)
+{}
+
+Entity EntityRegistry::CreateEntity()
+{
+	// Reuse the index of a destroyed entity if there are any, its generation was already bumped when it was destroyed
+	uint32_t entityIndex = 0;
+	if (!this->freeIndices.empty())
+	{
+		entityIndex = this->freeIndices.back();
+		this->freeIndices.pop_back();
+	}
+	else
+	{
+		entityIndex = (uint32_t)this->generations.size();
+		this->generations.emplace_back(0);
+		this->aliveFlags.emplace_back(0);
+	}
+
+	this->aliveFlags[entityIndex] = 1;
+	this->numEntities++;
+	return { entityIndex, this->generations[entityIndex] };
+}
+
+void EntityRegistry::DestroyEntity(Entity entity)
+{
+	if (!this->IsAlive(entity))
+		return;
+
+	for (std::unique_ptr<IComponentPool>& pool : this->pools)
+	{
+		if (pool)
+			pool->Remove(entity.index);
+	}
+
+	this->generations[entity.index]++;
+	this->aliveFlags[entity.index] = 0;
+	this->freeIndices.emplace_back(entity.index);
+	this->numEntities--;
+}
+
+void EntityRegistry::Clear()
+{
+	for (uint32_t entityIndex = 0; entityIndex < (uint32_t)this->generations.size(); entityIndex++)
+		this->DestroyEntity(this->GetEntity(entityIndex));
+
+	this->deferredCommands.clear();
+}
+
+void EntityRegistry::DeferDestroyEntity(Entity entity)
+{
+	this->DeferCommand([entity](EntityRegistry& registry) { registry.DestroyEntity(entity); });
+}
+
+void EntityRegistry::DeferCommand(std::function<void(EntityRegistry&)> command)
+{
+	std::lock_guard<std::mutex> lock(this->deferredMutex);
+	this->deferredCommands.emplace_back(std::move(command));
+}
+
+void EntityRegistry::FlushDeferred()
+{
+	// The commands are swapped out first, so that commands deferring more commands are ran on the next flush instead
+	std::vector<std::function<void(EntityRegistry&)>> commands;
+	{
+		std::lock_guard<std::mutex> lock(this->deferredMutex);
+		commands.swap(this->deferredCommands);
+	}
+
+	for (std::function<void(EntityRegistry&)>& command : commands)
+		command(*this);
+
+	// Hand the command buffer back so its memory is reused
+	commands.clear();
+	std::lock_guard<std::mutex> lock(this->deferredMutex);
+	if (this->deferredCommands.empty())
+		this->deferredCommands.swap(commands);
+}
+
+bool EntityRegistry::IsAlive(Entity entity) const
+{
+	return entity.index < this->generations.size() && this->aliveFlags[entity.index] && 
+		this->generations[entity.index] == entity.generation;
+}
+
+Entity EntityRegistry::GetEntity(uint32_t entityIndex) const
+{
+	return { entityIndex, this->generations[entityIndex] };
+}
+
+const size_t& EntityRegistry::GetNumEntities() const
+{
+	return this->numEntities;
+}
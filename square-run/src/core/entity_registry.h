@@ -0,0 +1,207 @@
+#ifndef ENTITY_REGISTRY_H
+#define ENTITY_REGISTRY_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <bitset>
+#include <tuple>
+#include <cstdint>
+
+namespace EntityGlobals
+{
+	constexpr uint32_t invalidIndex = UINT32_MAX;
+	constexpr size_t maxComponentTypes = 64;
+}
+
+// An entity is only an index into the component pools, the generation is bumped every time the index is reused so that stale 
+// entities can be told apart from the live entity now using the index.
+struct Entity
+{
+	uint32_t index = EntityGlobals::invalidIndex;
+	uint32_t generation = 0;
+
+	bool operator==(const Entity& other) const;
+	bool operator!=(const Entity& other) const;
+};
+
+using ComponentTypeID = uint32_t;
+using ComponentMask = std::bitset<EntityGlobals::maxComponentTypes>;
+
+namespace ComponentType
+{
+	// Returns a new component type ID, every component type is given one the first time it's used.
+	extern ComponentTypeID GenerateID();
+
+	// Returns the ID of the component type given, the IDs are handed out in the order the component types are first used.
+	template<typename Component> ComponentTypeID GetID();
+
+	// Returns a mask with the bits of the component types given set.
+	template<typename... Components> ComponentMask GetMask();
+}
+
+// The type erased interface of a component pool, used by the registry to remove the components of destroyed entities.
+class IComponentPool
+{
+public:
+	virtual ~IComponentPool() = default;
+
+	// Removes the component of the entity index given, if it has one.
+	virtual void Remove(uint32_t entityIndex) = 0;
+
+	// Returns TRUE if the entity index given has a component in the pool, else FALSE is returned.
+	virtual bool Has(uint32_t entityIndex) const = 0;
+};
+
+// A sparse set of components, the components are stored contiguously (with no gaps) so they can be iterated over quickly, while 
+// the sparse array maps every entity index to the position of its component.
+template<typename Component> class ComponentPool : public IComponentPool
+{
+public:
+	using RemoveCallback = std::function<void(uint32_t entityIndex, Component& component)>;
+private:
+	std::vector<uint32_t> sparse; // The position of each entity's component in the dense arrays, or the invalid index
+	std::vector<uint32_t> entities; // The entity index owning each component
+	std::vector<Component> components;
+	RemoveCallback onRemove;
+public:
+	ComponentPool() = default;
+	~ComponentPool() = default;
+
+	// Adds the component given to the entity index given, replacing its current component if it already has one.
+	// Returns the component added.
+	Component& Add(uint32_t entityIndex, Component component);
+
+	// Removes the component of the entity index given, if it has one. The last component is moved into the removed component's 
+	// place, so the order of the components isn't preserved.
+	void Remove(uint32_t entityIndex) override;
+
+	// Sets the function called on a component just before it's removed.
+	void SetRemoveCallback(RemoveCallback callbackFunc);
+
+	// Returns TRUE if the entity index given has a component in the pool, else FALSE is returned.
+	bool Has(uint32_t entityIndex) const override;
+
+	// Returns the component of the entity index given, the entity must have one.
+	Component& Get(uint32_t entityIndex);
+
+	// Returns the component of the entity index given, the entity must have one.
+	const Component& Get(uint32_t entityIndex) const;
+
+	// Returns the entity indices owning the components, in the same order as the components.
+	const std::vector<uint32_t>& GetEntities() const;
+
+	// Returns the components, stored contiguously.
+	std::vector<Component>& GetComponents();
+
+	// Returns the components, stored contiguously.
+	const std::vector<Component>& GetComponents() const;
+
+	// Returns the number of components in the pool.
+	size_t GetSize() const;
+};
+
+class EntityRegistry;
+
+// A view over the entities which have every one of the component types given.
+// The entities are iterated in the order of the smallest of the pools, so the other pools are only probed for those entities.
+template<typename... Components> class ComponentView
+{
+private:
+	EntityRegistry& registry;
+	std::tuple<ComponentPool<Components>*...> pools;
+public:
+	ComponentView(EntityRegistry& registry);
+	~ComponentView() = default;
+
+	// Calls the function given for every entity in the view, with the entity and references to its components.
+	// Components must not be added or removed while iterating, defer them instead.
+	template<typename Func> void Each(Func func);
+
+	// Returns the number of entities in the smallest pool of the view, which is the most entities the view can have.
+	size_t GetSizeHint() const;
+};
+
+class EntityRegistry
+{
+private:
+	std::vector<uint32_t> generations;
+	std::vector<uint8_t> aliveFlags;
+	std::vector<uint32_t> freeIndices;
+	std::vector<std::unique_ptr<IComponentPool>> pools; // Indexed by component type ID
+	size_t numEntities;
+
+	// The structural changes deferred by systems, applied in the order they were deferred once the registry is flushed
+	std::vector<std::function<void(EntityRegistry&)>> deferredCommands;
+	std::mutex deferredMutex;
+public:
+	EntityRegistry();
+	~EntityRegistry() = default;
+
+	EntityRegistry(const EntityRegistry& other) = delete;
+	EntityRegistry& operator=(const EntityRegistry& other) = delete;
+
+	// Returns a new entity with no components.
+	Entity CreateEntity();
+
+	// Destroys the entity given and removes all of its components.
+	void DestroyEntity(Entity entity);
+
+	// Destroys every entity.
+	void Clear();
+
+	// Adds the component given to the entity given, replacing its current component of the same type if it has one.
+	// Returns the component added.
+	template<typename Component> Component& AddComponent(Entity entity, Component component);
+
+	// Removes the component of the type given from the entity given, if it has one.
+	template<typename Component> void RemoveComponent(Entity entity);
+
+	// Returns TRUE if the entity given has a component of the type given, else FALSE is returned.
+	template<typename Component> bool HasComponent(Entity entity) const;
+
+	// Returns the component of the type given of the entity given, the entity must have one.
+	template<typename Component> Component& GetComponent(Entity entity);
+
+	// Returns the pool of the component type given, creating it if it doesn't exist yet.
+	template<typename Component> ComponentPool<Component>& GetPool();
+
+	// Returns the pool of the component type given, or nullptr if no component of the type has been added yet.
+	template<typename Component> ComponentPool<Component>* FindPool();
+
+	// Returns the pool of the component type given, or nullptr if no component of the type has been added yet.
+	template<typename Component> const ComponentPool<Component>* FindPool() const;
+
+	// Returns a view over the entities which have every one of the component types given.
+	template<typename... Components> ComponentView<Components...> View();
+
+	// Defers destroying the entity given until the registry is next flushed.
+	void DeferDestroyEntity(Entity entity);
+
+	// Defers adding the component given to the entity given until the registry is next flushed.
+	template<typename Component> void DeferAddComponent(Entity entity, Component component);
+
+	// Defers removing the component of the type given from the entity given until the registry is next flushed.
+	template<typename Component> void DeferRemoveComponent(Entity entity);
+
+	// Defers the command given until the registry is next flushed, it can make any structural change e.g. creating entities.
+	// This (like the other deferred functions) is safe to call from systems running in parallel.
+	void DeferCommand(std::function<void(EntityRegistry&)> command);
+
+	// Applies every deferred structural change, in the order they were deferred.
+	void FlushDeferred();
+
+	// Returns TRUE if the entity given hasn't been destroyed, else FALSE is returned.
+	bool IsAlive(Entity entity) const;
+
+	// Returns the entity currently using the index given.
+	Entity GetEntity(uint32_t entityIndex) const;
+
+	// Returns the number of entities alive.
+	const size_t& GetNumEntities() const;
+};
+
+#include <core/entity_registry.inl>
+
+#endif
@@ -0,0 +1,206 @@
+#include <core/entity_registry.h>
+
+template<typename Component> ComponentTypeID ComponentType::GetID()
+{
+	static const ComponentTypeID typeID = ComponentType::GenerateID();
+	return typeID;
+}
+
+template<typename... Components> ComponentMask ComponentType::GetMask()
+{
+	ComponentMask mask;
+	(mask.set(ComponentType::GetID<Components>()), ...);
+	return mask;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename Component> Component& ComponentPool<Component>::Add(uint32_t entityIndex, Component component)
+{
+	if (entityIndex >= this->sparse.size())
+		this->sparse.resize(entityIndex + 1, EntityGlobals::invalidIndex);
+
+	if (this->sparse[entityIndex] != EntityGlobals::invalidIndex)
+	{
+		Component& existingComponent = this->components[this->sparse[entityIndex]];
+		existingComponent = std::move(component);
+		return existingComponent;
+	}
+
+	this->sparse[entityIndex] = (uint32_t)this->components.size();
+	this->entities.emplace_back(entityIndex);
+	this->components.emplace_back(std::move(component));
+
+	return this->components.back();
+}
+
+template<typename Component> void ComponentPool<Component>::Remove(uint32_t entityIndex)
+{
+	if (!this->Has(entityIndex))
+		return;
+
+	const uint32_t removedSlot = this->sparse[entityIndex];
+	if (this->onRemove)
+		this->onRemove(entityIndex, this->components[removedSlot]);
+
+	// Move the last component into the removed component's slot, keeping the components contiguous
+	const uint32_t lastSlot = (uint32_t)this->components.size() - 1;
+	if (removedSlot != lastSlot)
+	{
+		this->components[removedSlot] = std::move(this->components[lastSlot]);
+		this->entities[removedSlot] = this->entities[lastSlot];
+		this->sparse[this->entities[removedSlot]] = removedSlot;
+	}
+
+	this->components.pop_back();
+	this->entities.pop_back();
+	this->sparse[entityIndex] = EntityGlobals::invalidIndex;
+}
+
+template<typename Component> void ComponentPool<Component>::SetRemoveCallback(RemoveCallback callbackFunc)
+{
+	this->onRemove = callbackFunc;
+}
+
+template<typename Component> bool ComponentPool<Component>::Has(uint32_t entityIndex) const
+{
+	return entityIndex < this->sparse.size() && this->sparse[entityIndex] != EntityGlobals::invalidIndex;
+}
+
+template<typename Component> Component& ComponentPool<Component>::Get(uint32_t entityIndex)
+{
+	return this->components[this->sparse[entityIndex]];
+}
+
+template<typename Component> const Component& ComponentPool<Component>::Get(uint32_t entityIndex) const
+{
+	return this->components[this->sparse[entityIndex]];
+}
+
+template<typename Component> const std::vector<uint32_t>& ComponentPool<Component>::GetEntities() const
+{
+	return this->entities;
+}
+
+template<typename Component> std::vector<Component>& ComponentPool<Component>::GetComponents()
+{
+	return this->components;
+}
+
+template<typename Component> const std::vector<Component>& ComponentPool<Component>::GetComponents() const
+{
+	return this->components;
+}
+
+template<typename Component> size_t ComponentPool<Component>::GetSize() const
+{
+	return this->components.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename... Components> ComponentView<Components...>::ComponentView(EntityRegistry& registry) :
+	registry(registry), pools(registry.FindPool<Components>()...)
+{}
+
+template<typename... Components> template<typename Func> void ComponentView<Components...>::Each(Func func)
+{
+	// If any of the component types has no pool yet, then no entity can have all of them
+	const bool allPoolsExist = ((std::get<ComponentPool<Components>*>(this->pools) != nullptr) && ...);
+	if (!allPoolsExist)
+		return;
+
+	// Iterate over the entities of the smallest pool
+	const std::vector<uint32_t>* smallestEntities = nullptr;
+	auto findSmallest = [&smallestEntities](const auto* pool)
+	{
+		if (!smallestEntities || pool->GetSize() < smallestEntities->size())
+			smallestEntities = &pool->GetEntities();
+	};
+
+	(findSmallest(std::get<ComponentPool<Components>*>(this->pools)), ...);
+
+	for (size_t entityPosition = 0; entityPosition < smallestEntities->size(); entityPosition++)
+	{
+		const uint32_t entityIndex = (*smallestEntities)[entityPosition];
+		if ((std::get<ComponentPool<Components>*>(this->pools)->Has(entityIndex) && ...))
+			func(this->registry.GetEntity(entityIndex), std::get<ComponentPool<Components>*>(this->pools)->Get(entityIndex)...);
+	}
+}
+
+template<typename... Components> size_t ComponentView<Components...>::GetSizeHint() const
+{
+	size_t sizeHint = SIZE_MAX;
+	((sizeHint = std::min(sizeHint, std::get<ComponentPool<Components>*>(this->pools) ? 
+		std::get<ComponentPool<Components>*>(this->pools)->GetSize() : 0)), ...);
+
+	return sizeHint;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename Component> Component& EntityRegistry::AddComponent(Entity entity, Component component)
+{
+	return this->GetPool<Component>().Add(entity.index, std::move(component));
+}
+
+template<typename Component> void EntityRegistry::RemoveComponent(Entity entity)
+{
+	ComponentPool<Component>* pool = this->FindPool<Component>();
+	if (pool && this->IsAlive(entity))
+		pool->Remove(entity.index);
+}
+
+template<typename Component> bool EntityRegistry::HasComponent(Entity entity) const
+{
+	const ComponentPool<Component>* pool = this->FindPool<Component>();
+	return pool && this->IsAlive(entity) && pool->Has(entity.index);
+}
+
+template<typename Component> Component& EntityRegistry::GetComponent(Entity entity)
+{
+	return this->FindPool<Component>()->Get(entity.index);
+}
+
+template<typename Component> ComponentPool<Component>& EntityRegistry::GetPool()
+{
+	const ComponentTypeID typeID = ComponentType::GetID<Component>();
+	if (typeID >= this->pools.size())
+		this->pools.resize(typeID + 1);
+
+	if (!this->pools[typeID])
+		this->pools[typeID] = std::make_unique<ComponentPool<Component>>();
+
+	return *static_cast<ComponentPool<Component>*>(this->pools[typeID].get());
+}
+
+template<typename Component> ComponentPool<Component>* EntityRegistry::FindPool()
+{
+	const ComponentTypeID typeID = ComponentType::GetID<Component>();
+	return typeID < this->pools.size() ? static_cast<ComponentPool<Component>*>(this->pools[typeID].get()) : nullptr;
+}
+
+template<typename Component> const ComponentPool<Component>* EntityRegistry::FindPool() const
+{
+	const ComponentTypeID typeID = ComponentType::GetID<Component>();
+	return typeID < this->pools.size() ? static_cast<const ComponentPool<Component>*>(this->pools[typeID].get()) : nullptr;
+}
+
+template<typename... Components> ComponentView<Components...> EntityRegistry::View()
+{
+	return ComponentView<Components...>(*this);
+}
+
+template<typename Component> void EntityRegistry::DeferAddComponent(Entity entity, Component component)
+{
+	this->DeferCommand([entity, component = std::move(component)](EntityRegistry& registry) mutable
+	{
+		if (registry.IsAlive(entity))
+			registry.AddComponent(entity, std::move(component));
+	});
+}
+
+template<typename Component> void EntityRegistry::DeferRemoveComponent(Entity entity)
+{
+	this->DeferCommand([entity](EntityRegistry& registry) { registry.RemoveComponent<Component>(entity); });
+}
@@ -0,0 +1,70 @@
+#include <core/entity_systems.h>
+
+namespace EntitySystems
+{
+	void UpdateMotion(EntityRegistry& registry, double deltaTime)
+	{
+		registry.View<TransformComponent, VelocityComponent>().Each([deltaTime](Entity entity, TransformComponent& transform, 
+			VelocityComponent& velocity)
+		{
+			transform.position += velocity.velocity * (float)deltaTime;
+		});
+	}
+
+	void UpdateLoopTimers(EntityRegistry& registry, double deltaTime)
+	{
+		registry.View<LoopingMotionComponent>().Each([deltaTime](Entity entity, LoopingMotionComponent& motion)
+		{
+			motion.elapsedTime += (float)deltaTime;
+			motion.looped = motion.elapsedTime >= motion.loopDuration;
+			if (motion.looped)
+				motion.elapsedTime = 0.0f;
+		});
+	}
+
+	void ResetLoopedMotion(EntityRegistry& registry, double deltaTime)
+	{
+		registry.View<TransformComponent, LoopingMotionComponent>().Each([](Entity entity, TransformComponent& transform, 
+			const LoopingMotionComponent& motion)
+		{
+			if (motion.looped)
+				transform.position = motion.startPosition;
+		});
+	}
+
+	void AddMotionSystems(SystemScheduler& scheduler)
+	{
+		scheduler.AddSystem("motion", SystemAccess().Read<VelocityComponent>().Write<TransformComponent>(), UpdateMotion);
+		scheduler.AddSystem("loop-timers", SystemAccess().Write<LoopingMotionComponent>(), UpdateLoopTimers);
+		scheduler.AddSystem("looped-motion-reset", SystemAccess().Read<LoopingMotionComponent>().Write<TransformComponent>(), 
+			ResetLoopedMotion);
+	}
+
+	void BindCollisionWorld(EntityRegistry& registry, CollisionWorld& world)
+	{
+		registry.GetPool<ColliderComponent>().SetRemoveCallback([&world](uint32_t entityIndex, ColliderComponent& collider)
+		{
+			if (collider.handle != CollisionWorldGlobals::invalidHandle)
+				world.Remove(collider.handle);
+		});
+	}
+
+	void SyncColliders(EntityRegistry& registry, CollisionWorld& world)
+	{
+		registry.View<ColliderComponent, TransformComponent>().Each([&world](Entity entity, ColliderComponent& collider, 
+			const TransformComponent& transform)
+		{
+			const RectangleCollider transformCollider(transform.position, transform.size);
+			if (collider.handle == CollisionWorldGlobals::invalidHandle)
+				collider.handle = world.Insert(transformCollider);
+			else
+				world.Update(collider.handle, transformCollider);
+		});
+	}
+
+	void AddColliderSystems(SystemScheduler& scheduler, CollisionWorld& world)
+	{
+		scheduler.AddSystem("collider-sync", SystemAccess().Read<TransformComponent>().Write<ColliderComponent>(), 
+			[&world](EntityRegistry& registry, double deltaTime) { SyncColliders(registry, world); });
+	}
+}
@@ -0,0 +1,35 @@
+#ifndef ENTITY_SYSTEMS_H
+#define ENTITY_SYSTEMS_H
+
+#include <core/system_scheduler.h>
+#include <core/components.h>
+
+namespace EntitySystems
+{
+	// Moves every entity with a velocity by its velocity.
+	extern void UpdateMotion(EntityRegistry& registry, double deltaTime);
+
+	// Advances the loop time of every looping entity, marking the entities whose loop duration has passed.
+	// This doesn't touch the transforms, so it runs alongside the motion system.
+	extern void UpdateLoopTimers(EntityRegistry& registry, double deltaTime);
+
+	// Moves every looping entity marked by the loop timers back to its start position.
+	extern void ResetLoopedMotion(EntityRegistry& registry, double deltaTime);
+
+	// Adds the motion systems to the scheduler given, in the order they need to run.
+	// The motion and loop timer systems write separate components so they run in parallel, then the looped entities are reset.
+	extern void AddMotionSystems(SystemScheduler& scheduler);
+
+	// Makes the colliders of the entities in the registry given be removed from the collision world given when their collider 
+	// component (or the entity itself) is removed. The collision world must outlive the registry's collider components.
+	extern void BindCollisionWorld(EntityRegistry& registry, CollisionWorld& world);
+
+	// Inserts the colliders of new collider entities into the collision world given, and moves the rest to match their transform.
+	extern void SyncColliders(EntityRegistry& registry, CollisionWorld& world);
+
+	// Adds the collider system to the scheduler given, which syncs the colliders of the entities into the collision world given.
+	// It's the only system touching the collision world, so it only conflicts with the systems writing the transforms.
+	extern void AddColliderSystems(SystemScheduler& scheduler, CollisionWorld& world);
+}
+
+#endif
@@ -1,12 +1,15 @@
 #include <core/game_state.h>
 #include <core/transition_system.h>
+#include <core/tween_system.h>
 #include <interface/user_interface.h>
 
+#include <chrono>
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 GameState::GameState() :
-	camera({ 0, 0 }, { RenderingGlobals::sceneViewWidth, RenderingGlobals::sceneViewHeight }), renderWhilePaused(true), 
-	updateWhilePaused(true)
+	camera({ 0, 0 }, { RenderingGlobals::sceneViewWidth, RenderingGlobals::sceneViewHeight }), 
+	stateArena("game state", ArenaGlobals::stateArenaBlockSize), tweenGroup(TweenSystem::GetInstance().CreateGroup()), renderWhilePaused(true), updateWhilePaused(true)
 {}
 
 void GameState::Resume() {}
@@ -31,7 +34,7 @@ void GameState::PopState()
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 GameStateSystem::GameStateSystem() :
-	pendingGameState(nullptr)
+	pendingGameState(nullptr), profileUpdates(false)
 {}
 
 void GameStateSystem::SwitchState(GameState* gameState, float transitionSpeed)
@@ -65,6 +68,7 @@ void GameStateSystem::PopState()
 	if (!this->stateStack.empty())
 	{
 		this->stateStack.back()->Destroy();
+		this->stateStack.back()->stateArena.Release();
 		this->stateStack.pop_back();
 	}
 
@@ -81,7 +85,10 @@ void GameStateSystem::Update(const double& deltaTime)
 	{
 		// Destroy all game states currently in the stack
 		for (GameState* gameState : this->stateStack)
+		{
 			gameState->Destroy();
+			gameState->stateArena.Release();
+		}
 
 		this->stateStack.clear();
 
@@ -93,12 +100,31 @@ void GameStateSystem::Update(const double& deltaTime)
 		TransitionSystem::GetInstance().NotifyGameStateLoaded();
 	}
 
+	// The tweens are advanced before the game states, so the states see the animated values of this step. The tweens of each game 
+	// state are advanced along with it, so they're held while the game state is paused.
+	TweenSystem::GetInstance().Update(deltaTime);
+
 	for (size_t stateIndex = 0; stateIndex < this->stateStack.size(); stateIndex++)
 	{
 		// Update the current active game state (and game states which are set to be updated while paused)
 		GameState* gameState = this->stateStack[stateIndex];
 		if ((stateIndex == 0) || (gameState->updateWhilePaused))
-			gameState->Update(deltaTime);
+		{
+			TweenSystem::GetInstance().Update(deltaTime, gameState->tweenGroup);
+
+			if (this->profileUpdates)
+			{
+				const auto preUpdateTime = std::chrono::steady_clock::now();
+				gameState->Update(deltaTime);
+				const auto postUpdateTime = std::chrono::steady_clock::now();
+
+				StateUpdateProfile& profile = this->updateProfiles[typeid(*gameState)];
+				profile.totalSeconds += std::chrono::duration<double>(postUpdateTime - preUpdateTime).count();
+				profile.numUpdates++;
+			}
+			else
+				gameState->Update(deltaTime);
+		}
 	}
 
 	UserInterfaceManager::GetInstance().UpdateActiveUI(deltaTime);
@@ -120,6 +146,21 @@ void GameStateSystem::Render() const
 
 	TransitionSystem::GetInstance().Render();
 	Renderer::GetInstance().FlushRenderedScene();
+
+	// Everything allocated for the frame has been used up by now
+	LinearArena::GetFrameArena().Reset();
+}
+
+void GameStateSystem::SetUpdateProfiling(bool enable)
+{
+	this->profileUpdates = enable;
+	if (enable)
+		this->updateProfiles.clear();
+}
+
+const StateUpdateProfileMap& GameStateSystem::GetUpdateProfiles() const
+{
+	return this->updateProfiles;
 }
 
 bool GameStateSystem::IsActive() const
@@ -2,6 +2,10 @@
 #define GAME_STATE_H
 
 #include <graphics/renderer.h>
+#include <util/linear_allocator.h>
+#include <core/tween_system.h>
+#include <unordered_map>
+#include <typeindex>
 #include <vector>
 
 class GameState
@@ -9,6 +13,8 @@ class GameState
 	friend class GameStateSystem;
 protected:
 	OrthogonalCamera camera;
+	LinearArena stateArena; // For data living as long as the game state, it's released once the game state is destroyed
+	TweenGroup tweenGroup; // The tweens played in it are only advanced while the game state is being updated
 	bool updateWhilePaused, renderWhilePaused;
 protected:
 	GameState();
@@ -37,11 +43,23 @@ protected:
 	void PopState();
 };
 
+// The accumulated update cost of a game state, gathered while update profiling is enabled.
+struct StateUpdateProfile
+{
+	uint64_t numUpdates = 0;
+	double totalSeconds = 0.0;
+};
+
+using StateUpdateProfileMap = std::unordered_map<std::type_index, StateUpdateProfile>;
+
 class GameStateSystem
 {
 private:
 	std::vector<GameState*> stateStack;
 	GameState* pendingGameState;
+
+	StateUpdateProfileMap updateProfiles;
+	bool profileUpdates;
 private:
 	GameStateSystem();
 public:
@@ -65,8 +83,15 @@ public:
 	void Update(const double& deltaTime);
 
 	// Renders the most recent game state and game states which are instructed to keep rendering even when paused.
+	// The frame arena is reset once the frame has been rendered.
 	void Render() const;
 
+	// Enables or disables the profiling of each game state's update cost.
+	void SetUpdateProfiling(bool enable);
+
+	// Returns the update cost of each game state updated since update profiling was enabled, keyed by the game state's type.
+	const StateUpdateProfileMap& GetUpdateProfiles() const;
+
 	// Returns TRUE if there are 
 	bool IsActive() const;
 	static GameStateSystem& GetInstance();
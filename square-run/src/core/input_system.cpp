@@ -1,35 +1,180 @@
 #include <core/input_system.h>
+#include <core/replay_system.h>
+#include <core/latency_tracker.h>
 #include <GLFW/glfw3.h>
 
-void InputSystem::Init(WindowFramePtr window)
+namespace InputGlobals
+{
+	constexpr size_t eventQueueCapacity = 1024;
+}
+
+InputSystem::InputSystem() :
+	backend(SystemBackend::HARDWARE), eventQueue(InputGlobals::eventQueueCapacity), numDroppedEvents(0)
+{
+	this->stepEvents.reserve(InputGlobals::eventQueueCapacity);
+}
+
+void InputSystem::Init(WindowFramePtr window, SystemBackend backend)
 {
 	this->window = window;
+	this->backend = backend;
+
+	if (this->backend == SystemBackend::HARDWARE)
+	{
+		// Register the window callbacks which feed the event queue
+		glfwSetKeyCallback(this->window->GetFramePtr(), InputSystem::KeyCallback);
+		glfwSetMouseButtonCallback(this->window->GetFramePtr(), InputSystem::MouseButtonCallback);
+		glfwSetCursorPosCallback(this->window->GetFramePtr(), InputSystem::CursorPositionCallback);
+
+		// The cursor position callback is only called once the cursor moves, so queue the initial cursor position
+		double cursorPosX = 0.0, cursorPosY = 0.0;
+		glfwGetCursorPos(this->window->GetFramePtr(), &cursorPosX, &cursorPosY);
+		InputSystem::CursorPositionCallback(this->window->GetFramePtr(), cursorPosX, cursorPosY);
+	}
+}
+
+void InputSystem::QueueEvent(const InputEvent& inputEvent)
+{
+	if (!this->eventQueue.Push(inputEvent))
+		this->numDroppedEvents++;
+}
+
+void InputSystem::ApplyEvent(const InputEvent& inputEvent)
+{
+	switch (inputEvent.type)
+	{
+	case InputEventType::KEY_PRESS:
+		this->snapshot.keysDown.set(inputEvent.code);
+		this->snapshot.keysPressed.set(inputEvent.code);
+		break;
+	case InputEventType::KEY_RELEASE:
+		this->snapshot.keysDown.reset(inputEvent.code);
+		this->snapshot.keysReleased.set(inputEvent.code);
+		break;
+	case InputEventType::MOUSE_BUTTON_PRESS:
+		this->snapshot.buttonsDown.set(inputEvent.code);
+		this->snapshot.buttonsPressed.set(inputEvent.code);
+		break;
+	case InputEventType::MOUSE_BUTTON_RELEASE:
+		this->snapshot.buttonsDown.reset(inputEvent.code);
+		this->snapshot.buttonsReleased.set(inputEvent.code);
+		break;
+	case InputEventType::CURSOR_MOVE:
+		this->snapshot.cursorPosition = inputEvent.cursorPosition;
+		this->snapshot.cursorMoved = true;
+		break;
+	}
+}
+
+void InputSystem::Update()
+{
+	// Clear the edges of the previous simulation step
+	this->snapshot.keysPressed.reset();
+	this->snapshot.keysReleased.reset();
+	this->snapshot.buttonsPressed.reset();
+	this->snapshot.buttonsReleased.reset();
+	this->snapshot.cursorMoved = false;
+
+	// Consume the queued events in the order they arrived.
+	// If a key or button has already changed during this step, then the rest of the events are left for the next step, this way 
+	// a press and release arriving between two polls still results in the key or button being seen as held for one step
+	this->stepEvents.clear();
+	std::bitset<(size_t)KeyCode::KEY_LAST + 1> changedKeys;
+	std::bitset<(size_t)MouseCode::MOUSE_BUTTON_LAST + 1> changedButtons;
+
+	while (const InputEvent* inputEvent = this->eventQueue.Peek())
+	{
+		if (inputEvent->type == InputEventType::KEY_PRESS || inputEvent->type == InputEventType::KEY_RELEASE)
+		{
+			if (changedKeys.test(inputEvent->code))
+				break;
+
+			changedKeys.set(inputEvent->code);
+		}
+		else if (inputEvent->type == InputEventType::MOUSE_BUTTON_PRESS || inputEvent->type == InputEventType::MOUSE_BUTTON_RELEASE)
+		{
+			if (changedButtons.test(inputEvent->code))
+				break;
+
+			changedButtons.set(inputEvent->code);
+		}
+
+		this->stepEvents.emplace_back();
+		this->eventQueue.Pop(this->stepEvents.back());
+	}
+
+	// When replaying, the events consumed are swapped out with the recorded ones
+	ReplaySystem::GetInstance().SyncInputEvents(this->stepEvents);
+
+	for (const InputEvent& inputEvent : this->stepEvents)
+	{
+		// Only key and button events are tracked, as cursor moves arrive far too often to be meaningful latency samples
+		if (inputEvent.type != InputEventType::CURSOR_MOVE)
+			LatencyTracker::GetInstance().OnEventConsumed(inputEvent.timestamp);
+
+		this->ApplyEvent(inputEvent);
+	}
 }
 
 bool InputSystem::WasKeyPressed(KeyCode key) const
 {
-	return glfwGetKey(this->window->GetFramePtr(), (int)key);
+	return this->snapshot.keysDown.test((size_t)key);
+}
+
+bool InputSystem::WasKeyJustPressed(KeyCode key) const
+{
+	return this->snapshot.keysPressed.test((size_t)key);
+}
+
+bool InputSystem::WasKeyJustReleased(KeyCode key) const
+{
+	return this->snapshot.keysReleased.test((size_t)key);
 }
 
 bool InputSystem::WasMouseButtonPressed(MouseCode button) const
 {
-	return glfwGetMouseButton(this->window->GetFramePtr(), (int)button);
+	return this->snapshot.buttonsDown.test((size_t)button);
 }
 
-glm::vec2 InputSystem::GetCursorPosition(const OrthogonalCamera* viewport) const
+bool InputSystem::WasMouseButtonJustPressed(MouseCode button) const
+{
+	return this->snapshot.buttonsPressed.test((size_t)button);
+}
+
+bool InputSystem::WasMouseButtonJustReleased(MouseCode button) const
+{
+	return this->snapshot.buttonsReleased.test((size_t)button);
+}
+
+bool InputSystem::HasCursorMoved() const
 {
-	// Get the current cursor position
-	double cursorPosX = 0.0, cursorPosY = 0.0;
-	glfwGetCursorPos(this->window->GetFramePtr(), &cursorPosX, &cursorPosY);
+	return this->snapshot.cursorMoved;
+}
 
-	// If a viewport camera was given then map the cursor position to it's dimensions
+glm::vec2 InputSystem::GetCursorPosition(const OrthogonalCamera* viewport) const
+{
+	// The cursor position is stored normalized, so map it to the viewport camera dimensions if given, else the window dimensions
 	if (viewport)
-	{
-		cursorPosX = cursorPosX * (viewport->GetSize().x / this->window->GetWidth());
-		cursorPosY = cursorPosY * (viewport->GetSize().y / this->window->GetHeight());
-	}
+		return this->snapshot.cursorPosition * viewport->GetSize();
+	else if (this->window)
+		return this->snapshot.cursorPosition * glm::vec2((float)this->window->GetWidth(), (float)this->window->GetHeight());
+
+	return this->snapshot.cursorPosition;
+}
+
+const std::vector<InputEvent>& InputSystem::GetStepEvents() const
+{
+	return this->stepEvents;
+}
 
-	return glm::vec2((float)cursorPosX, (float)cursorPosY);
+const InputSnapshot& InputSystem::GetSnapshot() const
+{
+	return this->snapshot;
+}
+
+const uint64_t& InputSystem::GetNumDroppedEvents() const
+{
+	return this->numDroppedEvents;
 }
 
 InputSystem& InputSystem::GetInstance()
@@ -37,3 +182,34 @@ InputSystem& InputSystem::GetInstance()
 	static InputSystem instance;
 	return instance;
 }
+
+void InputSystem::KeyCallback(GLFWwindow* frame, int key, int scancode, int action, int mods)
+{
+	// Key repeats don't change the state of the key, so they're ignored
+	if (key < 0 || key > (int)KeyCode::KEY_LAST || action == GLFW_REPEAT)
+		return;
+
+	InputSystem::GetInstance().QueueEvent({ action == GLFW_PRESS ? InputEventType::KEY_PRESS : InputEventType::KEY_RELEASE, key, 
+		glm::vec2(), glfwGetTime() });
+}
+
+void InputSystem::MouseButtonCallback(GLFWwindow* frame, int button, int action, int mods)
+{
+	if (button < 0 || button > (int)MouseCode::MOUSE_BUTTON_LAST)
+		return;
+
+	InputSystem::GetInstance().QueueEvent({ action == GLFW_PRESS ? InputEventType::MOUSE_BUTTON_PRESS : 
+		InputEventType::MOUSE_BUTTON_RELEASE, button, glm::vec2(), glfwGetTime() });
+}
+
+void InputSystem::CursorPositionCallback(GLFWwindow* frame, double posX, double posY)
+{
+	// The window has no size while it's minimised, so there's no position to normalize the cursor position against
+	const WindowFramePtr& window = InputSystem::GetInstance().window;
+	if (window->GetWidth() == 0 || window->GetHeight() == 0)
+		return;
+
+	const glm::vec2 normalizedPosition = { (float)(posX / window->GetWidth()), (float)(posY / window->GetHeight()) };
+
+	InputSystem::GetInstance().QueueEvent({ InputEventType::CURSOR_MOVE, 0, normalizedPosition, glfwGetTime() });
+}
@@ -2,8 +2,12 @@
 #define INPUT_SYSTEM_H
 
 #include <core/window_frame.h>
+#include <core/system_backend.h>
 #include <graphics/orthogonal_camera.h>
+#include <util/ring_buffer.h>
 #include <glm/glm.hpp>
+#include <bitset>
+#include <vector>
 
 // Key codes extracted from the GLFW 3 source code.
 enum class KeyCode : int
@@ -153,12 +157,56 @@ enum class MouseCode
 	MOUSE_BUTTON_MIDDLE = MOUSE_BUTTON_3
 };
 
+enum class InputEventType : uint8_t
+{
+	KEY_PRESS,
+	KEY_RELEASE,
+	MOUSE_BUTTON_PRESS,
+	MOUSE_BUTTON_RELEASE,
+	CURSOR_MOVE
+};
+
+// An input event received from the window, timestamped at the moment it arrived.
+struct InputEvent
+{
+	InputEventType type;
+	int code; // The key or mouse button code, unused by cursor move events
+	glm::vec2 cursorPosition; // The cursor position normalized to the window size, only used by cursor move events
+	double timestamp;
+};
+
+// The state of the input devices during a simulation step, built once at the start of every step.
+struct InputSnapshot
+{
+	std::bitset<(size_t)KeyCode::KEY_LAST + 1> keysDown, keysPressed, keysReleased;
+	std::bitset<(size_t)MouseCode::MOUSE_BUTTON_LAST + 1> buttonsDown, buttonsPressed, buttonsReleased;
+	glm::vec2 cursorPosition; // Normalized to the window size
+	bool cursorMoved = false;
+};
+
 class InputSystem
 {
 private:
 	WindowFramePtr window;
+	SystemBackend backend;
+
+	RingBuffer<InputEvent> eventQueue;
+	std::vector<InputEvent> stepEvents;
+	InputSnapshot snapshot;
+	uint64_t numDroppedEvents;
 private:
-	InputSystem() = default;
+	InputSystem();
+
+	// Queues the input event given, to be consumed by the next simulation step.
+	void QueueEvent(const InputEvent& inputEvent);
+
+	// Applies the input event given to the current input snapshot.
+	void ApplyEvent(const InputEvent& inputEvent);
+
+	// The window callbacks which queue the input events as they arrive.
+	static void KeyCallback(GLFWwindow* frame, int key, int scancode, int action, int mods);
+	static void MouseButtonCallback(GLFWwindow* frame, int button, int action, int mods);
+	static void CursorPositionCallback(GLFWwindow* frame, double posX, double posY);
 public:
 	InputSystem(const InputSystem& other) = delete;
 	InputSystem(InputSystem&& temp) noexcept = delete;
@@ -168,19 +216,48 @@ public:
 	InputSystem& operator=(InputSystem&& temp) noexcept = delete;
 
 	// Initializes the input system.
-	void Init(WindowFramePtr window);
+	// When the null device backend is selected, no window is needed and no keys or buttons are ever reported as pressed.
+	void Init(WindowFramePtr window, SystemBackend backend = SystemBackend::HARDWARE);
+
+	// Consumes the input events queued since the last simulation step and builds the input snapshot for the new step.
+	// Should be called once at the start of every simulation step.
+	void Update();
 
-	// Returns TRUE if the key specified was pressed, else FALSE is returned.
+	// Returns TRUE if the key specified is held down, else FALSE is returned.
 	bool WasKeyPressed(KeyCode key) const;
 
-	// Returns TRUE if the mouse button specified was pressed, else FALSE is returned.
+	// Returns TRUE if the key specified went down during this simulation step, else FALSE is returned.
+	bool WasKeyJustPressed(KeyCode key) const;
+
+	// Returns TRUE if the key specified was released during this simulation step, else FALSE is returned.
+	bool WasKeyJustReleased(KeyCode key) const;
+
+	// Returns TRUE if the mouse button specified is held down, else FALSE is returned.
 	bool WasMouseButtonPressed(MouseCode button) const;
 
+	// Returns TRUE if the mouse button specified went down during this simulation step, else FALSE is returned.
+	bool WasMouseButtonJustPressed(MouseCode button) const;
+
+	// Returns TRUE if the mouse button specified was released during this simulation step, else FALSE is returned.
+	bool WasMouseButtonJustReleased(MouseCode button) const;
+
+	// Returns TRUE if the cursor moved during this simulation step, else FALSE is returned.
+	bool HasCursorMoved() const;
+
 	// If you pass a orthogonal camera object, then the cursor position is mapped to the camera viewport resolution 
 	// instead of the window resolution.
 	// Returns the current position of the cursor.
 	glm::vec2 GetCursorPosition(const OrthogonalCamera* viewport = nullptr) const;
 
+	// Returns the input events consumed by the current simulation step.
+	const std::vector<InputEvent>& GetStepEvents() const;
+
+	// Returns the input snapshot of the current simulation step.
+	const InputSnapshot& GetSnapshot() const;
+
+	// Returns the number of input events dropped because the event queue was full.
+	const uint64_t& GetNumDroppedEvents() const;
+
 	// Returns singleton instance object of this class.
 	static InputSystem& GetInstance();
 };
@@ -0,0 +1,169 @@
+#include <core/latency_tracker.h>
+#include <util/logging_system.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <string>
+
+namespace LatencyGlobals
+{
+	// The number of most recent latency samples the distribution is calculated over
+	constexpr size_t maxSamples = 4096;
+}
+
+LatencyTracker::LatencyTracker() :
+	enabled(false), numConsumed(0), numSimulated(0), numSubmitted(0), nextSampleIndex(0)
+{
+	this->samples.reserve(LatencyGlobals::maxSamples);
+	this->percentileScratch.reserve(LatencyGlobals::maxSamples);
+}
+
+void LatencyTracker::SetEnabled(bool enable)
+{
+	this->enabled = enable;
+	this->numConsumed = this->numSimulated = this->numSubmitted = 0;
+}
+
+void LatencyTracker::OnEventConsumed(double arrivalTime)
+{
+	// Events consumed while the tracked events array is full are simply not sampled
+	if (!this->enabled || this->numConsumed == this->trackedEvents.size())
+		return;
+
+	TrackedEvent& trackedEvent = this->trackedEvents[this->numConsumed++];
+	trackedEvent.arrivalTime = arrivalTime;
+	trackedEvent.consumeTime = glfwGetTime();
+}
+
+void LatencyTracker::OnStepEnd()
+{
+	if (!this->enabled || this->numSimulated == this->numConsumed)
+		return;
+
+	const double time = glfwGetTime();
+
+	// The tracked events are always kept in the order: submitted, simulated, consumed
+	for (size_t eventIndex = this->numSimulated; eventIndex < this->numConsumed; eventIndex++)
+		this->trackedEvents[eventIndex].simulatedTime = time;
+
+	this->numSimulated = this->numConsumed;
+}
+
+void LatencyTracker::OnPresentBegin()
+{
+	if (!this->enabled || this->numSubmitted == this->numSimulated)
+		return;
+
+	const double time = glfwGetTime();
+	for (size_t eventIndex = this->numSubmitted; eventIndex < this->numSimulated; eventIndex++)
+		this->trackedEvents[eventIndex].submitTime = time;
+
+	this->numSubmitted = this->numSimulated;
+}
+
+void LatencyTracker::OnPresentEnd()
+{
+	if (!this->enabled || this->numSubmitted == 0)
+		return;
+
+	const double time = glfwGetTime();
+
+	// Every submitted event's effect has now been presented, so turn them into latency samples
+	for (size_t eventIndex = 0; eventIndex < this->numSubmitted; eventIndex++)
+	{
+		const TrackedEvent& trackedEvent = this->trackedEvents[eventIndex];
+		const LatencySample sample = { trackedEvent.consumeTime - trackedEvent.arrivalTime, 
+			trackedEvent.simulatedTime - trackedEvent.consumeTime, trackedEvent.submitTime - trackedEvent.simulatedTime, 
+			time - trackedEvent.submitTime };
+
+		if (this->samples.size() < LatencyGlobals::maxSamples)
+			this->samples.emplace_back(sample);
+		else
+			this->samples[this->nextSampleIndex] = sample;
+
+		this->nextSampleIndex = (this->nextSampleIndex + 1) % LatencyGlobals::maxSamples;
+	}
+
+	// Move the events still making their way through the pipeline to the front
+	std::move(this->trackedEvents.begin() + this->numSubmitted, this->trackedEvents.begin() + this->numConsumed, 
+		this->trackedEvents.begin());
+
+	this->numConsumed -= this->numSubmitted;
+	this->numSimulated -= this->numSubmitted;
+	this->numSubmitted = 0;
+}
+
+LatencyPercentiles LatencyTracker::CalculatePercentiles(double LatencySample::* phase) const
+{
+	LatencyPercentiles percentiles;
+	if (this->samples.empty())
+		return percentiles;
+
+	this->percentileScratch.clear();
+	for (const LatencySample& sample : this->samples)
+		this->percentileScratch.emplace_back(phase ? sample.*phase : 
+			sample.queueing + sample.simulation + sample.render + sample.present);
+
+	// Partially sort the values to find each percentile, the later percentiles only need to look past the previous one
+	auto findPercentile = [&](double percentile, size_t startIndex)
+	{
+		const size_t index = std::min((size_t)(percentile * this->percentileScratch.size()), this->percentileScratch.size() - 1);
+		std::nth_element(this->percentileScratch.begin() + startIndex, this->percentileScratch.begin() + index, 
+			this->percentileScratch.end());
+
+		return index;
+	};
+
+	const size_t p50Index = findPercentile(0.50, 0);
+	const size_t p95Index = findPercentile(0.95, p50Index);
+	const size_t p99Index = findPercentile(0.99, p95Index);
+
+	percentiles.p50 = this->percentileScratch[p50Index];
+	percentiles.p95 = this->percentileScratch[p95Index];
+	percentiles.p99 = this->percentileScratch[p99Index];
+	return percentiles;
+}
+
+void LatencyTracker::OutputReport() const
+{
+	const LatencyReport report = this->GetReport();
+	if (report.numSamples == 0)
+		return;
+
+	auto formatPercentiles = [](const std::string_view& phaseName, const LatencyPercentiles& percentiles)
+	{
+		return std::string(phaseName) + " p50 " + std::to_string(percentiles.p50 * 1000.0) + "ms, p95 " + 
+			std::to_string(percentiles.p95 * 1000.0) + "ms, p99 " + std::to_string(percentiles.p99 * 1000.0) + "ms";
+	};
+
+	LogSystem::GetInstance().OutputLog("Input latency over " + std::to_string(report.numSamples) + " events: " + 
+		formatPercentiles("total", report.total), Severity::INFO);
+	LogSystem::GetInstance().OutputLog("Input latency phases: " + formatPercentiles("queueing", report.queueing) + " | " +
+		formatPercentiles("simulation", report.simulation), Severity::INFO);
+	LogSystem::GetInstance().OutputLog("Input latency phases: " + formatPercentiles("render", report.render) + " | " +
+		formatPercentiles("present", report.present), Severity::INFO);
+}
+
+LatencyReport LatencyTracker::GetReport() const
+{
+	LatencyReport report;
+	report.total = this->CalculatePercentiles(nullptr);
+	report.queueing = this->CalculatePercentiles(&LatencySample::queueing);
+	report.simulation = this->CalculatePercentiles(&LatencySample::simulation);
+	report.render = this->CalculatePercentiles(&LatencySample::render);
+	report.present = this->CalculatePercentiles(&LatencySample::present);
+	report.numSamples = this->samples.size();
+
+	return report;
+}
+
+bool LatencyTracker::IsEnabled() const
+{
+	return this->enabled;
+}
+
+LatencyTracker& LatencyTracker::GetInstance()
+{
+	static LatencyTracker instance;
+	return instance;
+}
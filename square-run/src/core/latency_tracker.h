@@ -0,0 +1,87 @@
+#ifndef LATENCY_TRACKER_H
+#define LATENCY_TRACKER_H
+
+#include <vector>
+#include <array>
+#include <cstddef>
+
+struct LatencyPercentiles
+{
+	double p50 = 0.0, p95 = 0.0, p99 = 0.0; // In seconds
+};
+
+// The input-to-photon latency distribution, split into the phases an input event goes through before its effect is presented.
+struct LatencyReport
+{
+	LatencyPercentiles total;
+	LatencyPercentiles queueing; // From the event arriving to the simulation step consuming it
+	LatencyPercentiles simulation; // From the simulation step consuming the event to the step finishing
+	LatencyPercentiles render; // From the simulation step finishing to the frame presenting it being submitted
+	LatencyPercentiles present; // From the frame being submitted to the buffer swap returning
+	size_t numSamples = 0;
+};
+
+class LatencyTracker
+{
+private:
+	// An input event making its way through the pipeline, the timestamps are filled in as each phase is reached.
+	struct TrackedEvent
+	{
+		double arrivalTime = 0.0, consumeTime = 0.0, simulatedTime = 0.0, submitTime = 0.0;
+	};
+
+	struct LatencySample
+	{
+		double queueing = 0.0, simulation = 0.0, render = 0.0, present = 0.0;
+	};
+private:
+	bool enabled;
+	std::array<TrackedEvent, 256> trackedEvents;
+	size_t numConsumed, numSimulated, numSubmitted;
+
+	std::vector<LatencySample> samples;
+	size_t nextSampleIndex;
+	mutable std::vector<double> percentileScratch;
+private:
+	LatencyTracker();
+
+	// Returns the percentiles of the latency phase given, calculated over the stored samples.
+	LatencyPercentiles CalculatePercentiles(double LatencySample::* phase) const;
+public:
+	LatencyTracker(const LatencyTracker& other) = delete;
+	LatencyTracker(LatencyTracker&& temp) noexcept = delete;
+	~LatencyTracker() = default;
+
+	LatencyTracker& operator=(const LatencyTracker& other) = delete;
+	LatencyTracker& operator=(LatencyTracker&& temp) noexcept = delete;
+
+	// Enables or disables latency tracking, it's only meaningful when the events come from a live window.
+	void SetEnabled(bool enable);
+
+	// Notifies the tracker that an input event, which arrived at the time given, is being consumed by the current simulation step.
+	// The arrival time must come from the window clock (glfwGetTime), as every other phase is timed with it.
+	void OnEventConsumed(double arrivalTime);
+
+	// Notifies the tracker that the current simulation step has finished.
+	void OnStepEnd();
+
+	// Notifies the tracker that the rendered frame is about to be presented (i.e. the buffers are about to be swapped).
+	void OnPresentBegin();
+
+	// Notifies the tracker that the rendered frame has been presented (i.e. the buffer swap returned).
+	void OnPresentEnd();
+
+	// Returns TRUE if latency tracking is enabled, else FALSE is returned.
+	bool IsEnabled() const;
+
+	// Outputs the latency report to the log.
+	void OutputReport() const;
+
+	// Returns the latency distribution calculated over the most recent latency samples.
+	LatencyReport GetReport() const;
+
+	// Returns singleton instance object of this class.
+	static LatencyTracker& GetInstance();
+};
+
+#endif
@@ -0,0 +1,290 @@
+#include <core/particle_system.h>
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+
+namespace ParticleGlobals
+{
+	// The arrays are padded to a multiple of the widest SIMD register, so the kernels never need a scalar remainder loop
+	constexpr size_t laneWidth = 8;
+}
+
+ParticleEmitter::ParticleEmitter(const ParticleEmitterDesc& desc, LinearArena* arena) :
+	desc(desc), numParticles(0), position(0.0f), emitting(true), emitAccumulator(0.0f), randomEngine(desc.seed)
+{
+	const size_t paddedCapacity = (desc.capacity + ParticleGlobals::laneWidth - 1) / ParticleGlobals::laneWidth *
+		ParticleGlobals::laneWidth;
+	const size_t numValues = paddedCapacity * this->channels.size();
+
+	float* channelData = nullptr;
+	if (arena)
+	{
+		channelData = arena->AllocateArray<float>(numValues);
+		std::fill_n(channelData, numValues, 0.0f);
+	}
+	else
+	{
+		this->ownedChannels.resize(numValues, 0.0f);
+		channelData = this->ownedChannels.data();
+	}
+
+	for (size_t channelIndex = 0; channelIndex < this->channels.size(); channelIndex++)
+		this->channels[channelIndex] = channelData + (channelIndex * paddedCapacity);
+}
+
+float* ParticleEmitter::GetChannelData(ParticleChannel channel)
+{
+	return this->channels[(size_t)channel];
+}
+
+void ParticleEmitter::Spawn(size_t count)
+{
+	count = std::min(count, this->desc.capacity - this->numParticles);
+
+	std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+	const auto randomRange = [&](float min, float max) { return min + ((max - min) * unitDistribution(this->randomEngine)); };
+
+	for (size_t spawnIndex = 0; spawnIndex < count; spawnIndex++)
+	{
+		const size_t index = this->numParticles++;
+
+		// Pick a point within the spawn circle, the square root keeps the points evenly spread rather than bunched at the center
+		const float angle = randomRange(0.0f, 6.2831853f);
+		const float distance = this->desc.spawnRadius * std::sqrt(unitDistribution(this->randomEngine));
+		const float lifetime = std::max(randomRange(this->desc.minLifetime, this->desc.maxLifetime), 1e-3f);
+
+		this->GetChannelData(ParticleChannel::POSITION_X)[index] = this->position.x + (std::cos(angle) * distance);
+		this->GetChannelData(ParticleChannel::POSITION_Y)[index] = this->position.y + (std::sin(angle) * distance);
+		this->GetChannelData(ParticleChannel::VELOCITY_X)[index] = randomRange(this->desc.minVelocity.x, this->desc.maxVelocity.x);
+		this->GetChannelData(ParticleChannel::VELOCITY_Y)[index] = randomRange(this->desc.minVelocity.y, this->desc.maxVelocity.y);
+
+		// The rates are set so the color and size reach their end values as the particle dies
+		for (int component = 0; component < 4; component++)
+		{
+			this->GetChannelData((ParticleChannel)((int)ParticleChannel::RED + component))[index] = this->desc.startColor[component];
+			this->GetChannelData((ParticleChannel)((int)ParticleChannel::RED_RATE + component))[index] =
+				(this->desc.endColor[component] - this->desc.startColor[component]) / lifetime;
+		}
+
+		this->GetChannelData(ParticleChannel::SIZE)[index] = this->desc.startSize;
+		this->GetChannelData(ParticleChannel::SIZE_RATE)[index] = (this->desc.endSize - this->desc.startSize) / lifetime;
+		this->GetChannelData(ParticleChannel::LIFETIME)[index] = lifetime;
+	}
+}
+
+void ParticleEmitter::IntegrateRangeScalar(size_t beginIndex, size_t endIndex, float deltaTime)
+{
+	float* positionX = this->GetChannelData(ParticleChannel::POSITION_X), *positionY = this->GetChannelData(ParticleChannel::POSITION_Y);
+	float* velocityX = this->GetChannelData(ParticleChannel::VELOCITY_X), *velocityY = this->GetChannelData(ParticleChannel::VELOCITY_Y);
+	float* size = this->GetChannelData(ParticleChannel::SIZE), *lifetime = this->GetChannelData(ParticleChannel::LIFETIME);
+	const float* sizeRate = this->GetChannelData(ParticleChannel::SIZE_RATE);
+
+	const float accelerationX = this->desc.acceleration.x * deltaTime, accelerationY = this->desc.acceleration.y * deltaTime;
+
+	for (size_t index = beginIndex; index < endIndex; index++)
+	{
+		velocityX[index] = velocityX[index] + accelerationX;
+		velocityY[index] = velocityY[index] + accelerationY;
+		positionX[index] = positionX[index] + (velocityX[index] * deltaTime);
+		positionY[index] = positionY[index] + (velocityY[index] * deltaTime);
+
+		size[index] = std::max(size[index] + (sizeRate[index] * deltaTime), 0.0f);
+		lifetime[index] = lifetime[index] - deltaTime;
+	}
+
+	for (int component = 0; component < 4; component++)
+	{
+		float* color = this->GetChannelData((ParticleChannel)((int)ParticleChannel::RED + component));
+		const float* colorRate = this->GetChannelData((ParticleChannel)((int)ParticleChannel::RED_RATE + component));
+
+		for (size_t index = beginIndex; index < endIndex; index++)
+			color[index] = color[index] + (colorRate[index] * deltaTime);
+	}
+}
+
+void ParticleEmitter::IntegrateRangeSSE2(size_t beginIndex, size_t endIndex, float deltaTime)
+{
+	float* positionX = this->GetChannelData(ParticleChannel::POSITION_X), *positionY = this->GetChannelData(ParticleChannel::POSITION_Y);
+	float* velocityX = this->GetChannelData(ParticleChannel::VELOCITY_X), *velocityY = this->GetChannelData(ParticleChannel::VELOCITY_Y);
+	float* size = this->GetChannelData(ParticleChannel::SIZE), *lifetime = this->GetChannelData(ParticleChannel::LIFETIME);
+	const float* sizeRate = this->GetChannelData(ParticleChannel::SIZE_RATE);
+
+	const __m128 timeStep = _mm_set1_ps(deltaTime), zero = _mm_setzero_ps();
+	const __m128 accelerationX = _mm_set1_ps(this->desc.acceleration.x * deltaTime);
+	const __m128 accelerationY = _mm_set1_ps(this->desc.acceleration.y * deltaTime);
+
+	for (size_t index = beginIndex; index < endIndex; index += 4)
+	{
+		const __m128 newVelocityX = _mm_add_ps(_mm_loadu_ps(&velocityX[index]), accelerationX);
+		const __m128 newVelocityY = _mm_add_ps(_mm_loadu_ps(&velocityY[index]), accelerationY);
+		_mm_storeu_ps(&velocityX[index], newVelocityX);
+		_mm_storeu_ps(&velocityY[index], newVelocityY);
+		_mm_storeu_ps(&positionX[index], _mm_add_ps(_mm_loadu_ps(&positionX[index]), _mm_mul_ps(newVelocityX, timeStep)));
+		_mm_storeu_ps(&positionY[index], _mm_add_ps(_mm_loadu_ps(&positionY[index]), _mm_mul_ps(newVelocityY, timeStep)));
+
+		_mm_storeu_ps(&size[index], _mm_max_ps(_mm_add_ps(_mm_loadu_ps(&size[index]),
+			_mm_mul_ps(_mm_loadu_ps(&sizeRate[index]), timeStep)), zero));
+		_mm_storeu_ps(&lifetime[index], _mm_sub_ps(_mm_loadu_ps(&lifetime[index]), timeStep));
+	}
+
+	for (int component = 0; component < 4; component++)
+	{
+		float* color = this->GetChannelData((ParticleChannel)((int)ParticleChannel::RED + component));
+		const float* colorRate = this->GetChannelData((ParticleChannel)((int)ParticleChannel::RED_RATE + component));
+
+		for (size_t index = beginIndex; index < endIndex; index += 4)
+		{
+			_mm_storeu_ps(&color[index], _mm_add_ps(_mm_loadu_ps(&color[index]),
+				_mm_mul_ps(_mm_loadu_ps(&colorRate[index]), timeStep)));
+		}
+	}
+}
+
+AVX2_FUNCTION void ParticleEmitter::IntegrateRangeAVX2(size_t beginIndex, size_t endIndex, float deltaTime)
+{
+	float* positionX = this->GetChannelData(ParticleChannel::POSITION_X), *positionY = this->GetChannelData(ParticleChannel::POSITION_Y);
+	float* velocityX = this->GetChannelData(ParticleChannel::VELOCITY_X), *velocityY = this->GetChannelData(ParticleChannel::VELOCITY_Y);
+	float* size = this->GetChannelData(ParticleChannel::SIZE), *lifetime = this->GetChannelData(ParticleChannel::LIFETIME);
+	const float* sizeRate = this->GetChannelData(ParticleChannel::SIZE_RATE);
+
+	const __m256 timeStep = _mm256_set1_ps(deltaTime), zero = _mm256_setzero_ps();
+	const __m256 accelerationX = _mm256_set1_ps(this->desc.acceleration.x * deltaTime);
+	const __m256 accelerationY = _mm256_set1_ps(this->desc.acceleration.y * deltaTime);
+
+	for (size_t index = beginIndex; index < endIndex; index += 8)
+	{
+		const __m256 newVelocityX = _mm256_add_ps(_mm256_loadu_ps(&velocityX[index]), accelerationX);
+		const __m256 newVelocityY = _mm256_add_ps(_mm256_loadu_ps(&velocityY[index]), accelerationY);
+		_mm256_storeu_ps(&velocityX[index], newVelocityX);
+		_mm256_storeu_ps(&velocityY[index], newVelocityY);
+		_mm256_storeu_ps(&positionX[index], _mm256_add_ps(_mm256_loadu_ps(&positionX[index]), _mm256_mul_ps(newVelocityX, timeStep)));
+		_mm256_storeu_ps(&positionY[index], _mm256_add_ps(_mm256_loadu_ps(&positionY[index]), _mm256_mul_ps(newVelocityY, timeStep)));
+
+		_mm256_storeu_ps(&size[index], _mm256_max_ps(_mm256_add_ps(_mm256_loadu_ps(&size[index]),
+			_mm256_mul_ps(_mm256_loadu_ps(&sizeRate[index]), timeStep)), zero));
+		_mm256_storeu_ps(&lifetime[index], _mm256_sub_ps(_mm256_loadu_ps(&lifetime[index]), timeStep));
+	}
+
+	for (int component = 0; component < 4; component++)
+	{
+		float* color = this->GetChannelData((ParticleChannel)((int)ParticleChannel::RED + component));
+		const float* colorRate = this->GetChannelData((ParticleChannel)((int)ParticleChannel::RED_RATE + component));
+
+		for (size_t index = beginIndex; index < endIndex; index += 8)
+		{
+			_mm256_storeu_ps(&color[index], _mm256_add_ps(_mm256_loadu_ps(&color[index]),
+				_mm256_mul_ps(_mm256_loadu_ps(&colorRate[index]), timeStep)));
+		}
+	}
+}
+
+void ParticleEmitter::RemoveDeadParticles()
+{
+	const float* lifetime = this->GetChannelData(ParticleChannel::LIFETIME);
+
+	size_t index = 0;
+	while (index < this->numParticles)
+	{
+		if (lifetime[index] > 0.0f)
+		{
+			index++;
+			continue;
+		}
+
+		// Swap the last particle into the place of the dead one, the index isn't advanced as the moved particle is checked next
+		const size_t lastIndex = --this->numParticles;
+		for (float* channel : this->channels)
+			channel[index] = channel[lastIndex];
+	}
+}
+
+void ParticleEmitter::SetPosition(const glm::vec2& position)
+{
+	this->position = position;
+}
+
+void ParticleEmitter::SetEmitting(bool emitting)
+{
+	this->emitting = emitting;
+	this->emitAccumulator = 0.0f;
+}
+
+void ParticleEmitter::Burst(size_t count)
+{
+	this->Spawn(count);
+}
+
+void ParticleEmitter::Update(float deltaTime)
+{
+	this->Update(deltaTime, Util::GetSupportedSimdLevel());
+}
+
+void ParticleEmitter::Update(float deltaTime, SimdLevel level)
+{
+	// Spawn the particles due, the fraction left over is carried onto the next step so the emit rate isn't tied to the step size
+	if (this->emitting)
+	{
+		this->emitAccumulator += this->desc.emitRate * deltaTime;
+		const float numDue = std::floor(this->emitAccumulator);
+		this->emitAccumulator -= numDue;
+		this->Spawn((size_t)numDue);
+	}
+
+	// The padding past the alive particles is integrated along with them, which saves handling a remainder
+	const size_t endIndex = (this->numParticles + ParticleGlobals::laneWidth - 1) / ParticleGlobals::laneWidth *
+		ParticleGlobals::laneWidth;
+
+	switch (std::min(level, Util::GetSupportedSimdLevel()))
+	{
+	case SimdLevel::AVX2:
+		this->IntegrateRangeAVX2(0, endIndex, deltaTime);
+		break;
+	case SimdLevel::SSE2:
+		this->IntegrateRangeSSE2(0, endIndex, deltaTime);
+		break;
+	default:
+		this->IntegrateRangeScalar(0, this->numParticles, deltaTime);
+		break;
+	}
+
+	this->RemoveDeadParticles();
+}
+
+void ParticleEmitter::Clear()
+{
+	this->numParticles = 0;
+	this->emitAccumulator = 0.0f;
+}
+
+bool ParticleEmitter::IsEmitting() const
+{
+	return this->emitting;
+}
+
+const float* ParticleEmitter::GetChannel(ParticleChannel channel) const
+{
+	return this->channels[(size_t)channel];
+}
+
+size_t ParticleEmitter::GetNumParticles() const
+{
+	return this->numParticles;
+}
+
+size_t ParticleEmitter::GetCapacity() const
+{
+	return this->desc.capacity;
+}
+
+const glm::vec2& ParticleEmitter::GetPosition() const
+{
+	return this->position;
+}
+
+namespace Memory
+{
+	ParticleEmitterPtr CreateParticleEmitter(const ParticleEmitterDesc& desc, LinearArena* arena)
+	{
+		return std::make_shared<ParticleEmitter>(desc, arena);
+	}
+}
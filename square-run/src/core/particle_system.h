@@ -0,0 +1,129 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <util/simd.h>
+#include <util/linear_allocator.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <array>
+#include <memory>
+#include <random>
+#include <cstdint>
+
+// The per particle values stored by an emitter, each one is kept in its own contiguous array.
+enum class ParticleChannel
+{
+	POSITION_X,
+	POSITION_Y,
+	VELOCITY_X,
+	VELOCITY_Y,
+	RED,
+	GREEN,
+	BLUE,
+	ALPHA,
+	RED_RATE, // The change in each value per second, so the value reaches its end value as the particle dies
+	GREEN_RATE,
+	BLUE_RATE,
+	ALPHA_RATE,
+	SIZE,
+	SIZE_RATE,
+	LIFETIME, // The seconds left before the particle dies
+	COUNT
+};
+
+// The settings of a particle emitter, the particles are spawned with values picked at random between the minimum and maximum given.
+struct ParticleEmitterDesc
+{
+	size_t capacity = 1024; // The maximum number of particles alive at once, no more are spawned until some die
+	float emitRate = 100.0f; // The number of particles spawned per second while emitting
+	float spawnRadius = 0.0f; // The particles are spawned at a random position within this distance from the emitter position
+	float minLifetime = 0.5f, maxLifetime = 1.0f; // In seconds
+	glm::vec2 minVelocity = glm::vec2(-100.0f), maxVelocity = glm::vec2(100.0f);
+	glm::vec2 acceleration = glm::vec2(0.0f); // Applied to every particle, e.g. gravity
+	glm::vec4 startColor = glm::vec4(255), endColor = glm::vec4(255, 255, 255, 0); // In the range 0-255
+	float startSize = 32.0f, endSize = 0.0f;
+	uint32_t seed = 0; // The emitter is deterministic, so the same seed and steps always produce the same particles
+};
+
+// A fixed capacity pool of particles, stored as a structure of arrays so the particles can be integrated with SIMD instructions.
+// The arrays are allocated once when the emitter is created (back to back, from an arena if one is given), and dead particles are 
+// removed by swapping the last particle into their place, so the alive particles are always packed at the start of the arrays.
+class ParticleEmitter
+{
+private:
+	ParticleEmitterDesc desc;
+	std::array<float*, (size_t)ParticleChannel::COUNT> channels;
+	std::vector<float> ownedChannels; // Backs the channels when the emitter wasn't given an arena
+	size_t numParticles;
+
+	glm::vec2 position;
+	bool emitting;
+	float emitAccumulator;
+	std::mt19937 randomEngine;
+private:
+	// Returns a pointer to the start of the channel given.
+	float* GetChannelData(ParticleChannel channel);
+
+	// Spawns the number of particles given at the emitter position (fewer if the emitter runs out of capacity).
+	void Spawn(size_t count);
+
+	// Integrates the particles within the index range given over the time step given.
+	void IntegrateRangeScalar(size_t beginIndex, size_t endIndex, float deltaTime);
+	void IntegrateRangeSSE2(size_t beginIndex, size_t endIndex, float deltaTime);
+	void IntegrateRangeAVX2(size_t beginIndex, size_t endIndex, float deltaTime);
+
+	// Removes every particle with no lifetime left, the last particle is moved into the place of each one removed.
+	void RemoveDeadParticles();
+public:
+	// If an arena is given the channels are allocated from it, so the arena must outlive the emitter.
+	ParticleEmitter(const ParticleEmitterDesc& desc, LinearArena* arena = nullptr);
+	~ParticleEmitter() = default;
+
+	ParticleEmitter(const ParticleEmitter& other) = delete;
+	ParticleEmitter& operator=(const ParticleEmitter& other) = delete;
+
+	// Sets the position the particles are spawned at.
+	void SetPosition(const glm::vec2& position);
+
+	// Starts or stops the emitter spawning particles, the particles already alive carry on until they die.
+	void SetEmitting(bool emitting);
+
+	// Spawns the number of particles given straight away (fewer if the emitter runs out of capacity).
+	void Burst(size_t count);
+
+	// Spawns the particles due over the time step given, then integrates and removes the dead particles.
+	// The kernels of the highest instruction set supported by the CPU are used.
+	void Update(float deltaTime);
+
+	// Spawns the particles due over the time step given, then integrates and removes the dead particles.
+	// The kernels of the instruction set given are used, falling back to the highest supported one if the CPU doesn't support it.
+	void Update(float deltaTime, SimdLevel level);
+
+	// Removes every alive particle.
+	void Clear();
+
+	// Returns TRUE if the emitter is spawning particles, else FALSE is returned.
+	bool IsEmitting() const;
+
+	// Returns the values of the channel given, only the first GetNumParticles() values belong to alive particles.
+	const float* GetChannel(ParticleChannel channel) const;
+
+	// Returns the number of alive particles.
+	size_t GetNumParticles() const;
+
+	// Returns the maximum number of particles alive at once.
+	size_t GetCapacity() const;
+
+	// Returns the position the particles are spawned at.
+	const glm::vec2& GetPosition() const;
+};
+
+using ParticleEmitterPtr = std::shared_ptr<ParticleEmitter>;
+
+namespace Memory
+{
+	// Returns a shared pointer to the new created particle emitter, whose particles are allocated from the arena given (if any).
+	extern ParticleEmitterPtr CreateParticleEmitter(const ParticleEmitterDesc& desc, LinearArena* arena = nullptr);
+}
+
+#endif
@@ -0,0 +1,210 @@
+#include <core/replay_system.h>
+#include <util/logging_system.h>
+#include <util/timestamp.h>
+
+#include <iterator>
+#include <cstring>
+
+namespace ReplayGlobals
+{
+	constexpr char fileMagic[4] = { 'S', 'R', 'R', 'P' };
+	constexpr uint32_t fileVersion = 2;
+	constexpr size_t headerSize = sizeof(fileMagic) + sizeof(fileVersion);
+
+	// The recording tape is written out to the replay file once it grows past this size (in bytes)
+	constexpr size_t recordingFlushThreshold = 64 * 1024;
+}
+
+ReplaySystem::ReplaySystem() :
+	mode(ReplayMode::DISABLED), readOffset(0), stepCount(0), finished(false)
+{}
+
+ReplaySystem::~ReplaySystem()
+{
+	this->Stop();
+}
+
+void ReplaySystem::Init(ReplayMode mode, const std::string_view& filePath)
+{
+	this->mode = mode;
+	this->filePath = filePath;
+	this->readOffset = 0;
+	this->stepCount = 0;
+	this->finished = false;
+
+	if (mode == ReplayMode::RECORDING)
+	{
+		// Open the replay file and write the file header
+		this->recordingFile.open(this->filePath, std::ios::binary | std::ios::trunc);
+		if (this->recordingFile.fail())
+			LogSystem::GetInstance().OutputLog("Failed to open the replay file for recording: " + this->filePath, Severity::FATAL);
+
+		this->recordingFile.write(ReplayGlobals::fileMagic, sizeof(ReplayGlobals::fileMagic));
+		this->recordingFile.write((const char*)&ReplayGlobals::fileVersion, sizeof(ReplayGlobals::fileVersion));
+
+		this->tape.reserve(ReplayGlobals::recordingFlushThreshold * 2);
+		LogSystem::GetInstance().OutputLog("Recording replay to: " + this->filePath, Severity::INFO);
+	}
+	else if (mode == ReplayMode::REPLAYING)
+	{
+		// Load the whole replay file into the tape
+		std::ifstream replayFile(this->filePath, std::ios::binary);
+		if (replayFile.fail())
+			LogSystem::GetInstance().OutputLog("Failed to open the replay file: " + this->filePath, Severity::FATAL);
+
+		this->tape.assign(std::istreambuf_iterator<char>(replayFile), std::istreambuf_iterator<char>());
+
+		// Validate the file header
+		uint32_t version = 0;
+		if (this->tape.size() >= ReplayGlobals::headerSize)
+			std::memcpy(&version, this->tape.data() + sizeof(ReplayGlobals::fileMagic), sizeof(version));
+
+		if (this->tape.size() < ReplayGlobals::headerSize ||
+			std::memcmp(this->tape.data(), ReplayGlobals::fileMagic, sizeof(ReplayGlobals::fileMagic)) != 0 ||
+			version != ReplayGlobals::fileVersion)
+		{
+			LogSystem::GetInstance().OutputLog("The replay file is invalid or of an unsupported version: " + this->filePath,
+				Severity::FATAL);
+		}
+
+		this->readOffset = ReplayGlobals::headerSize;
+		LogSystem::GetInstance().OutputLog("Replaying from: " + this->filePath, Severity::INFO);
+	}
+}
+
+void ReplaySystem::Stop()
+{
+	if (this->mode == ReplayMode::RECORDING)
+	{
+		this->FlushRecording();
+		this->recordingFile.close();
+
+		LogSystem::GetInstance().OutputLog("Recorded " + std::to_string(this->stepCount) + " simulation steps", Severity::INFO);
+	}
+
+	this->mode = ReplayMode::DISABLED;
+	this->tape.clear();
+}
+
+void ReplaySystem::FlushRecording()
+{
+	this->recordingFile.write((const char*)this->tape.data(), this->tape.size());
+	this->tape.clear();
+}
+
+void ReplaySystem::EndReplay(const std::string_view& reason)
+{
+	LogSystem::GetInstance().OutputLog(std::string(reason) + " (step " + std::to_string(this->stepCount) + ")",
+		Severity::INFO);
+
+	this->mode = ReplayMode::DISABLED;
+	this->finished = true;
+	this->tape.clear();
+}
+
+void ReplaySystem::BeginStep(double liveTime)
+{
+	if (this->mode == ReplayMode::REPLAYING && this->readOffset >= this->tape.size())
+		this->EndReplay("Reached the end of the replay");
+
+	Util::SetSimulationTime(this->SyncDouble(liveTime));
+}
+
+void ReplaySystem::EndStep()
+{
+	this->SyncEntry<uint8_t>(EntryType::STEP_END, 0);
+	this->stepCount++;
+
+	if (this->mode == ReplayMode::RECORDING && this->tape.size() >= ReplayGlobals::recordingFlushThreshold)
+		this->FlushRecording();
+}
+
+template<typename Ty> Ty ReplaySystem::SyncEntry(EntryType type, const Ty& liveValue)
+{
+	switch (this->mode)
+	{
+	case ReplayMode::RECORDING:
+	{
+		// Append the entry tag followed by the raw value to the tape
+		const uint8_t* valueBytes = (const uint8_t*)&liveValue;
+		this->tape.push_back((uint8_t)type);
+		this->tape.insert(this->tape.end(), valueBytes, valueBytes + sizeof(Ty));
+		return liveValue;
+	}
+	case ReplayMode::REPLAYING:
+	{
+		// The entry read must be of the same type as the value requested, otherwise the simulation has taken a different path
+		// from the recorded one and the rest of the replay is meaningless
+		if (this->readOffset + 1 + sizeof(Ty) > this->tape.size() || this->tape[this->readOffset] != (uint8_t)type)
+		{
+			this->EndReplay("The replay has desynchronised from the simulation");
+			return liveValue;
+		}
+
+		Ty recordedValue;
+		std::memcpy(&recordedValue, this->tape.data() + this->readOffset + 1, sizeof(Ty));
+		this->readOffset += 1 + sizeof(Ty);
+
+		return recordedValue;
+	}
+	default:
+		return liveValue;
+	}
+}
+
+bool ReplaySystem::SyncBool(bool liveValue)
+{
+	return this->SyncEntry<uint8_t>(EntryType::BOOLEAN, liveValue) != 0;
+}
+
+uint32_t ReplaySystem::SyncUInt(uint32_t liveValue)
+{
+	return this->SyncEntry(EntryType::UNSIGNED_INT, liveValue);
+}
+
+float ReplaySystem::SyncFloat(float liveValue)
+{
+	return this->SyncEntry(EntryType::FLOAT, liveValue);
+}
+
+double ReplaySystem::SyncDouble(double liveValue)
+{
+	return this->SyncEntry(EntryType::DOUBLE, liveValue);
+}
+
+glm::vec2 ReplaySystem::SyncVec2(const glm::vec2& liveValue)
+{
+	return this->SyncEntry(EntryType::VECTOR2, liveValue);
+}
+
+void ReplaySystem::SyncInputEvents(std::vector<InputEvent>& liveEvents)
+{
+	// The events are written as a count followed by the raw events, most steps consume no events at all
+	const uint32_t numEvents = this->SyncEntry(EntryType::INPUT_EVENTS, (uint32_t)liveEvents.size());
+	if (this->mode == ReplayMode::REPLAYING)
+		liveEvents.resize(numEvents);
+
+	for (InputEvent& inputEvent : liveEvents)
+		inputEvent = this->SyncEntry(EntryType::INPUT_EVENTS, inputEvent);
+}
+
+const ReplayMode& ReplaySystem::GetMode() const
+{
+	return this->mode;
+}
+
+const uint64_t& ReplaySystem::GetStepCount() const
+{
+	return this->stepCount;
+}
+
+bool ReplaySystem::IsFinished() const
+{
+	return this->finished;
+}
+
+ReplaySystem& ReplaySystem::GetInstance()
+{
+	static ReplaySystem instance;
+	return instance;
+}
@@ -0,0 +1,103 @@
+#ifndef REPLAY_SYSTEM_H
+#define REPLAY_SYSTEM_H
+
+#include <core/input_system.h>
+#include <glm/glm.hpp>
+#include <string_view>
+#include <string>
+#include <fstream>
+#include <vector>
+
+enum class ReplayMode
+{
+	DISABLED, // Every value is fetched live
+	RECORDING, // Every value is fetched live and written to the replay file
+	REPLAYING // Every value is read back from the replay file instead of being fetched live
+};
+
+class ReplaySystem
+{
+private:
+	// Tags written before every value in the replay file, used to detect when a replay has desynchronised.
+	enum class EntryType : uint8_t
+	{
+		STEP_END,
+		BOOLEAN,
+		UNSIGNED_INT,
+		FLOAT,
+		DOUBLE,
+		VECTOR2,
+		INPUT_EVENTS
+	};
+private:
+	ReplayMode mode;
+	std::string filePath;
+	std::ofstream recordingFile;
+	std::vector<uint8_t> tape;
+	size_t readOffset;
+	uint64_t stepCount;
+	bool finished;
+private:
+	ReplaySystem();
+
+	// Writes the contents of the recording tape to the replay file and empties the tape.
+	void FlushRecording();
+
+	// Ends the replay, consequent values are fetched live.
+	void EndReplay(const std::string_view& reason);
+
+	// Returns the live value given if not replaying, else the value read back from the replay file is returned.
+	// If recording, the live value is also written to the recording tape.
+	template<typename Ty> Ty SyncEntry(EntryType type, const Ty& liveValue);
+public:
+	ReplaySystem(const ReplaySystem& other) = delete;
+	ReplaySystem(ReplaySystem&& temp) noexcept = delete;
+	~ReplaySystem();
+
+	ReplaySystem& operator=(const ReplaySystem& other) = delete;
+	ReplaySystem& operator=(ReplaySystem&& temp) noexcept = delete;
+
+	// Initializes the replay system, if the mode given isn't DISABLED then the replay file at the path given is opened.
+	void Init(ReplayMode mode, const std::string_view& filePath);
+
+	// Stops the recording or replay, flushing any recorded values still pending to the replay file.
+	void Stop();
+
+	// Marks the start of a new simulation step, the simulation time is sampled here so that it stays constant during the step.
+	void BeginStep(double liveTime);
+
+	// Marks the end of the current simulation step.
+	void EndStep();
+
+	// Returns the live boolean given, or the recorded one if replaying.
+	bool SyncBool(bool liveValue);
+
+	// Returns the live unsigned integer given, or the recorded one if replaying.
+	uint32_t SyncUInt(uint32_t liveValue);
+
+	// Returns the live float given, or the recorded one if replaying.
+	float SyncFloat(float liveValue);
+
+	// Returns the live double given, or the recorded one if replaying.
+	double SyncDouble(double liveValue);
+
+	// Returns the live vector given, or the recorded one if replaying.
+	glm::vec2 SyncVec2(const glm::vec2& liveValue);
+
+	// Leaves the live input events given untouched if not replaying, else they're replaced with the recorded ones.
+	void SyncInputEvents(std::vector<InputEvent>& liveEvents);
+
+	// Returns the mode the replay system is running in.
+	const ReplayMode& GetMode() const;
+
+	// Returns the number of simulation steps recorded or replayed so far.
+	const uint64_t& GetStepCount() const;
+
+	// Returns TRUE if the replay has reached the end of the replay file, else FALSE is returned.
+	bool IsFinished() const;
+
+	// Returns singleton instance object of this class.
+	static ReplaySystem& GetInstance();
+};
+
+#endif
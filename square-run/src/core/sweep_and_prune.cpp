@@ -0,0 +1,458 @@
+#include <core/sweep_and_prune.h>
+
+#include <algorithm>
+
+SweepAndPrune::SweepAndPrune() :
+	numRemovedEndpoints(0), numTouchingPairs(0), numSwaps(0)
+{}
+
+uint64_t SweepAndPrune::GetPairKey(ColliderHandle first, ColliderHandle second)
+{
+	return ((uint64_t)std::min(first, second) << 32) | std::max(first, second);
+}
+
+bool SweepAndPrune::IsEndpointBefore(const Endpoint& first, const Endpoint& second)
+{
+	// Of the endpoints with equal values the max endpoints come first, as colliders which only share an edge aren't overlapping
+	return first.value < second.value || (first.value == second.value && !first.isMin && second.isMin);
+}
+
+size_t SweepAndPrune::GetPairSlot(uint64_t pairKey) const
+{
+	// Mix the bits of the key (the splitmix64 finaliser), as the keys of the pairs of a collider only differ in their lower bits
+	pairKey = (pairKey ^ (pairKey >> 30)) * 0xBF58476D1CE4E5B9ull;
+	pairKey = (pairKey ^ (pairKey >> 27)) * 0x94D049BB133111EBull;
+	return (size_t)(pairKey ^ (pairKey >> 31)) & (this->pairTable.size() - 1);
+}
+
+uint32_t SweepAndPrune::FindCandidatePair(ColliderHandle first, ColliderHandle second) const
+{
+	if (this->candidatePairs.empty())
+		return SweepAndPruneGlobals::invalidPair;
+
+	const uint64_t pairKey = SweepAndPrune::GetPairKey(first, second);
+	const size_t slotMask = this->pairTable.size() - 1;
+
+	for (size_t slot = this->GetPairSlot(pairKey);; slot = (slot + 1) & slotMask)
+	{
+		const uint32_t pairIndex = this->pairTable[slot];
+		if (pairIndex == SweepAndPruneGlobals::invalidPair || SweepAndPrune::GetPairKey(this->candidatePairs[pairIndex].first,
+			this->candidatePairs[pairIndex].second) == pairKey)
+		{
+			return pairIndex;
+		}
+	}
+}
+
+void SweepAndPrune::ResizePairTable(size_t tableSize)
+{
+	this->pairTable.assign(tableSize, SweepAndPruneGlobals::invalidPair);
+
+	const size_t slotMask = tableSize - 1;
+	for (uint32_t pairIndex = 0; pairIndex < (uint32_t)this->candidatePairs.size(); pairIndex++)
+	{
+		const CandidatePair& candidatePair = this->candidatePairs[pairIndex];
+		size_t slot = this->GetPairSlot(SweepAndPrune::GetPairKey(candidatePair.first, candidatePair.second));
+		while (this->pairTable[slot] != SweepAndPruneGlobals::invalidPair)
+			slot = (slot + 1) & slotMask;
+
+		this->pairTable[slot] = pairIndex;
+	}
+}
+
+void SweepAndPrune::AddCandidatePair(ColliderHandle first, ColliderHandle second)
+{
+	if (this->FindCandidatePair(first, second) != SweepAndPruneGlobals::invalidPair)
+		return;
+
+	this->candidatePairs.push_back({ first, second, false });
+	if (this->candidatePairs.size() * 2 > this->pairTable.size())
+	{
+		// The new pair is added to the table along with the rest
+		this->ResizePairTable(std::max(this->pairTable.size() * 2, SweepAndPruneGlobals::minPairTableSize));
+		return;
+	}
+
+	const size_t slotMask = this->pairTable.size() - 1;
+	size_t slot = this->GetPairSlot(SweepAndPrune::GetPairKey(first, second));
+	while (this->pairTable[slot] != SweepAndPruneGlobals::invalidPair)
+		slot = (slot + 1) & slotMask;
+
+	this->pairTable[slot] = (uint32_t)(this->candidatePairs.size() - 1);
+}
+
+void SweepAndPrune::RemoveCandidatePair(ColliderHandle first, ColliderHandle second)
+{
+	const uint32_t pairIndex = this->FindCandidatePair(first, second);
+	if (pairIndex != SweepAndPruneGlobals::invalidPair)
+		this->RemoveCandidatePairAt(pairIndex);
+}
+
+void SweepAndPrune::RemoveCandidatePairAt(size_t pairIndex)
+{
+	const CandidatePair removedPair = this->candidatePairs[pairIndex];
+	if (removedPair.touching)
+	{
+		this->pendingEvents.push_back({ PairEventType::EXIT, removedPair.first, removedPair.second, CollidingSide::NONE });
+		this->numTouchingPairs--;
+	}
+
+	const size_t slotMask = this->pairTable.size() - 1;
+	size_t slot = this->GetPairSlot(SweepAndPrune::GetPairKey(removedPair.first, removedPair.second));
+	while (this->pairTable[slot] != (uint32_t)pairIndex)
+		slot = (slot + 1) & slotMask;
+
+	// Shift the pairs after the slot back into it where their search would still find them, so no search is cut short by the gap
+	for (size_t nextSlot = (slot + 1) & slotMask; this->pairTable[nextSlot] != SweepAndPruneGlobals::invalidPair;
+		nextSlot = (nextSlot + 1) & slotMask)
+	{
+		const CandidatePair& nextPair = this->candidatePairs[this->pairTable[nextSlot]];
+		const size_t idealSlot = this->GetPairSlot(SweepAndPrune::GetPairKey(nextPair.first, nextPair.second));
+		if (((nextSlot - idealSlot) & slotMask) >= ((nextSlot - slot) & slotMask))
+		{
+			this->pairTable[slot] = this->pairTable[nextSlot];
+			slot = nextSlot;
+		}
+	}
+
+	this->pairTable[slot] = SweepAndPruneGlobals::invalidPair;
+
+	// Swap the pair with the last one and pop it off, the order of the pairs doesn't matter
+	const uint32_t lastIndex = (uint32_t)(this->candidatePairs.size() - 1);
+	if (pairIndex != lastIndex)
+	{
+		const CandidatePair& lastPair = this->candidatePairs[lastIndex];
+		slot = this->GetPairSlot(SweepAndPrune::GetPairKey(lastPair.first, lastPair.second));
+		while (this->pairTable[slot] != lastIndex)
+			slot = (slot + 1) & slotMask;
+
+		this->pairTable[slot] = (uint32_t)pairIndex;
+		this->candidatePairs[pairIndex] = lastPair;
+	}
+
+	this->candidatePairs.pop_back();
+}
+
+void SweepAndPrune::ReindexEndpoints(size_t beginIndex)
+{
+	for (size_t endpointIndex = beginIndex; endpointIndex < this->endpoints.size(); endpointIndex++)
+	{
+		const Endpoint& endpoint = this->endpoints[endpointIndex];
+		SweepCollider& sweepCollider = this->colliders[endpoint.handle];
+		(endpoint.isMin ? sweepCollider.minEndpoint : sweepCollider.maxEndpoint) = (uint32_t)endpointIndex;
+	}
+}
+
+void SweepAndPrune::SortEndpoints()
+{
+	this->numSwaps = 0;
+
+	for (size_t endpointIndex = 1; endpointIndex < this->endpoints.size(); endpointIndex++)
+	{
+		const Endpoint movingEndpoint = this->endpoints[endpointIndex];
+		size_t insertIndex = endpointIndex;
+
+		// Shift the endpoint left past every endpoint with a greater value, as the world moves coherently between steps this is usually 
+		// only a few swaps (if any)
+		while (insertIndex > 0 && SweepAndPrune::IsEndpointBefore(movingEndpoint, this->endpoints[insertIndex - 1]))
+		{
+			const Endpoint& passedEndpoint = this->endpoints[insertIndex - 1];
+			if (movingEndpoint.handle == passedEndpoint.handle)
+			{
+				// The endpoints of a collider with no width can swap with each other, which never changes any overlaps
+			}
+			else if (movingEndpoint.isMin && !passedEndpoint.isMin)
+			{
+				// The start of a collider passed the end of another, so they may have started overlapping on X. The end of the moving 
+				// collider may not have been sorted yet, so check the actual intervals
+				const RectangleCollider& movingCollider = this->colliders[movingEndpoint.handle].collider;
+				const RectangleCollider& passedCollider = this->colliders[passedEndpoint.handle].collider;
+
+				if (movingCollider.GetLeftSidePosition() < passedCollider.GetRightSidePosition() && 
+					movingCollider.GetRightSidePosition() > passedCollider.GetLeftSidePosition())
+				{
+					this->AddCandidatePair(movingEndpoint.handle, passedEndpoint.handle);
+				}
+			}
+			else if (!movingEndpoint.isMin && passedEndpoint.isMin)
+			{
+				// The end of a collider passed the start of another, so they've stopped overlapping on X
+				this->RemoveCandidatePair(movingEndpoint.handle, passedEndpoint.handle);
+			}
+
+			this->endpoints[insertIndex] = passedEndpoint;
+			SweepCollider& passedCollider = this->colliders[passedEndpoint.handle];
+			(passedEndpoint.isMin ? passedCollider.minEndpoint : passedCollider.maxEndpoint) = (uint32_t)insertIndex;
+
+			insertIndex--;
+			this->numSwaps++;
+		}
+
+		if (insertIndex != endpointIndex)
+		{
+			this->endpoints[insertIndex] = movingEndpoint;
+			SweepCollider& movingCollider = this->colliders[movingEndpoint.handle];
+			(movingEndpoint.isMin ? movingCollider.minEndpoint : movingCollider.maxEndpoint) = (uint32_t)insertIndex;
+		}
+	}
+}
+
+void SweepAndPrune::RemoveDeadEndpoints()
+{
+	if (this->numRemovedEndpoints == 0)
+		return;
+
+	const auto firstDead = std::find_if(this->endpoints.begin(), this->endpoints.end(), 
+		[this](const Endpoint& endpoint) { return !this->colliders[endpoint.handle].active; });
+	const size_t firstIndex = firstDead - this->endpoints.begin();
+
+	this->endpoints.erase(std::remove_if(firstDead, this->endpoints.end(), 
+		[this](const Endpoint& endpoint) { return !this->colliders[endpoint.handle].active; }), this->endpoints.end());
+
+	this->ReindexEndpoints(firstIndex);
+	this->numRemovedEndpoints = 0;
+}
+
+void SweepAndPrune::MergeInsertedColliders()
+{
+	if (this->insertedHandles.empty())
+		return;
+
+	// Sort the endpoints of the inserted colliders, then merge them into the sorted endpoints
+	this->insertedEndpoints.clear();
+	for (const ColliderHandle& handle : this->insertedHandles)
+	{
+		const RectangleCollider& collider = this->colliders[handle].collider;
+		this->insertedEndpoints.push_back({ collider.GetLeftSidePosition(), handle, true });
+		this->insertedEndpoints.push_back({ collider.GetRightSidePosition(), handle, false });
+	}
+
+	std::sort(this->insertedEndpoints.begin(), this->insertedEndpoints.end(), SweepAndPrune::IsEndpointBefore);
+
+	this->mergedEndpoints.resize(this->endpoints.size() + this->insertedEndpoints.size());
+	std::merge(this->endpoints.begin(), this->endpoints.end(), this->insertedEndpoints.begin(), this->insertedEndpoints.end(),
+		this->mergedEndpoints.begin(), SweepAndPrune::IsEndpointBefore);
+
+	this->endpoints.swap(this->mergedEndpoints);
+	this->ReindexEndpoints(0);
+
+	// Sweep the endpoints, keeping track of the colliders open at each endpoint. The inserted colliders overlap every collider open 
+	// as they're opened, and every inserted collider open as the colliders already in the array are opened. Once the last endpoint of 
+	// an inserted collider is passed there are no pairs left to find.
+	size_t numInsertedEndpointsLeft = this->insertedEndpoints.size();
+	for (size_t endpointIndex = 0; endpointIndex < this->endpoints.size() && numInsertedEndpointsLeft > 0; endpointIndex++)
+	{
+		const Endpoint& endpoint = this->endpoints[endpointIndex];
+		SweepCollider& sweepCollider = this->colliders[endpoint.handle];
+		if (sweepCollider.inserted)
+			numInsertedEndpointsLeft--;
+
+		// A collider with no width sorts its max endpoint first, so it's never opened. It overlaps the open colliders it's strictly 
+		// within, which is checked directly as the colliders opened at the same position don't overlap it.
+		const bool hasWidth = sweepCollider.minEndpoint < sweepCollider.maxEndpoint;
+		if (!endpoint.isMin)
+		{
+			if (hasWidth)
+				this->CloseCollider(endpoint.handle);
+
+			continue;
+		}
+
+		const auto addOpenPairs = [&](const std::vector<ColliderHandle>& openList)
+		{
+			for (const ColliderHandle& openHandle : openList)
+			{
+				if (hasWidth || endpoint.value > this->colliders[openHandle].collider.GetLeftSidePosition())
+					this->AddCandidatePair(endpoint.handle, openHandle);
+			}
+		};
+
+		addOpenPairs(this->openInsertedColliders);
+		if (sweepCollider.inserted)
+			addOpenPairs(this->openColliders);
+
+		if (hasWidth)
+		{
+			std::vector<ColliderHandle>& openList = sweepCollider.inserted ? this->openInsertedColliders : this->openColliders;
+			sweepCollider.openIndex = (uint32_t)openList.size();
+			openList.emplace_back(endpoint.handle);
+		}
+	}
+
+	for (const ColliderHandle& handle : this->insertedHandles)
+		this->colliders[handle].inserted = false;
+
+	this->insertedHandles.clear();
+	this->openColliders.clear();
+	this->openInsertedColliders.clear();
+}
+
+void SweepAndPrune::CloseCollider(ColliderHandle handle)
+{
+	const SweepCollider& sweepCollider = this->colliders[handle];
+	std::vector<ColliderHandle>& openList = sweepCollider.inserted ? this->openInsertedColliders : this->openColliders;
+
+	// The order of the open colliders doesn't matter, so swap the collider with the last one and pop it off
+	const ColliderHandle lastHandle = openList.back();
+	openList[sweepCollider.openIndex] = lastHandle;
+	this->colliders[lastHandle].openIndex = sweepCollider.openIndex;
+	openList.pop_back();
+}
+
+ColliderHandle SweepAndPrune::Insert(const RectangleCollider& collider)
+{
+	// Reuse a handle of a removed collider if there are any
+	ColliderHandle handle = 0;
+	if (!this->freeHandles.empty())
+	{
+		handle = this->freeHandles.back();
+		this->freeHandles.pop_back();
+	}
+	else
+	{
+		handle = (ColliderHandle)this->colliders.size();
+		this->colliders.emplace_back();
+	}
+
+	SweepCollider& sweepCollider = this->colliders[handle];
+	sweepCollider.collider = collider;
+	sweepCollider.active = true;
+	sweepCollider.inserted = true;
+
+	// The endpoints are merged into the sorted endpoints along with those of every other collider inserted before the next update
+	this->insertedHandles.emplace_back(handle);
+	return handle;
+}
+
+void SweepAndPrune::Update(ColliderHandle handle, const RectangleCollider& collider)
+{
+	SweepCollider& sweepCollider = this->colliders[handle];
+	if (!sweepCollider.active)
+		return;
+
+	sweepCollider.collider = collider;
+	if (!sweepCollider.inserted)
+	{
+		this->endpoints[sweepCollider.minEndpoint].value = collider.GetLeftSidePosition();
+		this->endpoints[sweepCollider.maxEndpoint].value = collider.GetRightSidePosition();
+	}
+}
+
+void SweepAndPrune::Remove(ColliderHandle handle)
+{
+	SweepCollider& sweepCollider = this->colliders[handle];
+	if (!sweepCollider.active)
+		return;
+
+	sweepCollider.active = false;
+	this->removedHandles.emplace_back(handle);
+
+	// A collider inserted since the last update has no endpoints or pairs yet
+	if (sweepCollider.inserted)
+	{
+		sweepCollider.inserted = false;
+		this->insertedHandles.erase(std::find(this->insertedHandles.begin(), this->insertedHandles.end(), handle));
+		return;
+	}
+
+	// Remove every candidate pair the collider is part of, the exit events of the touching pairs are dispatched on the next update
+	for (size_t pairIndex = this->candidatePairs.size(); pairIndex > 0; pairIndex--)
+	{
+		const CandidatePair& candidatePair = this->candidatePairs[pairIndex - 1];
+		if (candidatePair.first == handle || candidatePair.second == handle)
+			this->RemoveCandidatePairAt(pairIndex - 1);
+	}
+
+	// The endpoints are swept out of the endpoint array on the next update, along with those of every other removed collider
+	this->numRemovedEndpoints += 2;
+}
+
+void SweepAndPrune::UpdatePairs()
+{
+	// The handles removed so far can be reused once their exit events have been dispatched below
+	const size_t numReleasedHandles = this->removedHandles.size();
+
+	this->RemoveDeadEndpoints();
+	this->SortEndpoints();
+	this->MergeInsertedColliders();
+
+	// Test every candidate pair for an actual overlap, recording the events to be dispatched
+	for (CandidatePair& candidatePair : this->candidatePairs)
+	{
+		const CollidingSide side = this->colliders[candidatePair.first].collider.IsColliding(
+			this->colliders[candidatePair.second].collider);
+
+		const bool touching = side != CollidingSide::NONE;
+		if (touching)
+		{
+			this->pendingEvents.push_back({ candidatePair.touching ? PairEventType::STAY : PairEventType::ENTER, 
+				candidatePair.first, candidatePair.second, side });
+		}
+		else if (candidatePair.touching)
+			this->pendingEvents.push_back({ PairEventType::EXIT, candidatePair.first, candidatePair.second, CollidingSide::NONE });
+
+		if (touching != candidatePair.touching)
+		{
+			touching ? this->numTouchingPairs++ : this->numTouchingPairs--;
+			candidatePair.touching = touching;
+		}
+	}
+
+	// Dispatch the events, the event buffer is swapped out first in case the callbacks remove colliders (which records more events)
+	std::vector<PairEvent> dispatchedEvents;
+	dispatchedEvents.swap(this->pendingEvents);
+
+	for (const PairEvent& pairEvent : dispatchedEvents)
+	{
+		const PairCallback& callbackFunc = pairEvent.type == PairEventType::ENTER ? this->onPairEnter :
+			pairEvent.type == PairEventType::STAY ? this->onPairStay : this->onPairExit;
+
+		if (callbackFunc)
+			callbackFunc(pairEvent.first, pairEvent.second, pairEvent.side);
+	}
+
+	// Hand the event buffer back so its memory is reused by the next update
+	dispatchedEvents.clear();
+	if (this->pendingEvents.empty())
+		this->pendingEvents.swap(dispatchedEvents);
+
+	// The colliders removed by the callbacks keep their handles until their exit events are dispatched by the next update
+	this->freeHandles.insert(this->freeHandles.end(), this->removedHandles.begin(), 
+		this->removedHandles.begin() + numReleasedHandles);
+	this->removedHandles.erase(this->removedHandles.begin(), this->removedHandles.begin() + numReleasedHandles);
+}
+
+void SweepAndPrune::SetPairEnterCallback(PairCallback callbackFunc)
+{
+	this->onPairEnter = callbackFunc;
+}
+
+void SweepAndPrune::SetPairStayCallback(PairCallback callbackFunc)
+{
+	this->onPairStay = callbackFunc;
+}
+
+void SweepAndPrune::SetPairExitCallback(PairCallback callbackFunc)
+{
+	this->onPairExit = callbackFunc;
+}
+
+const RectangleCollider& SweepAndPrune::GetCollider(ColliderHandle handle) const
+{
+	return this->colliders[handle].collider;
+}
+
+size_t SweepAndPrune::GetNumCandidatePairs() const
+{
+	return this->candidatePairs.size();
+}
+
+const size_t& SweepAndPrune::GetNumTouchingPairs() const
+{
+	return this->numTouchingPairs;
+}
+
+const size_t& SweepAndPrune::GetNumSwaps() const
+{
+	return this->numSwaps;
+}
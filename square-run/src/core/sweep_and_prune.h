@@ -0,0 +1,165 @@
+#ifndef SWEEP_AND_PRUNE_H
+#define SWEEP_AND_PRUNE_H
+
+#include <core/collision_detection.h>
+#include <core/collision_world.h>
+#include <functional>
+#include <vector>
+#include <cstdint>
+
+namespace SweepAndPruneGlobals
+{
+	constexpr uint32_t invalidPair = UINT32_MAX;
+	constexpr size_t minPairTableSize = 64;
+}
+
+// A sort-and-sweep broadphase along the X axis, suited to worlds that scroll along X where most colliders move little relative to 
+// each other between steps. The collider endpoints are kept sorted between steps with an insertion sort, and only the swaps it makes 
+// add or remove candidate pairs (colliders overlapping on X), so the pairs aren't recomputed every step. The colliders inserted and
+// removed between updates are merged into (and swept out of) the sorted endpoints together on the next update.
+class SweepAndPrune
+{
+public:
+	// The side given is the side of the first collider being collided with by the second collider, and is NONE for exit events.
+	using PairCallback = std::function<void(ColliderHandle first, ColliderHandle second, CollidingSide side)>;
+private:
+	struct Endpoint
+	{
+		float value;
+		ColliderHandle handle;
+		bool isMin;
+	};
+
+	struct SweepCollider
+	{
+		RectangleCollider collider;
+		uint32_t minEndpoint = 0, maxEndpoint = 0; // The indices of the collider endpoints in the sorted endpoint array
+		uint32_t openIndex = 0; // The index of the collider in the open colliders while merging the inserted colliders
+		bool active = false;
+		bool inserted = false; // TRUE until the endpoints of the collider are merged into the endpoint array on the next update
+	};
+
+	struct CandidatePair
+	{
+		ColliderHandle first, second;
+		bool touching; // TRUE if the colliders were overlapping on both axes during the last update
+	};
+
+	enum class PairEventType
+	{
+		ENTER,
+		STAY,
+		EXIT
+	};
+
+	struct PairEvent
+	{
+		PairEventType type;
+		ColliderHandle first, second;
+		CollidingSide side;
+	};
+private:
+	std::vector<SweepCollider> colliders;
+	std::vector<ColliderHandle> freeHandles;
+	std::vector<ColliderHandle> insertedHandles; // The colliders inserted since the last update
+	std::vector<ColliderHandle> removedHandles; // The handles are only reused once the exit events of their colliders are dispatched
+	size_t numRemovedEndpoints; // The endpoints of the colliders removed since the last update, which are still in the endpoint array
+	std::vector<Endpoint> endpoints;
+
+	// Reused while merging the inserted colliders
+	std::vector<Endpoint> insertedEndpoints, mergedEndpoints;
+	std::vector<ColliderHandle> openColliders, openInsertedColliders;
+
+	// The candidate pairs are looked up through an open addressing hash table of indices into the pair array, keyed by the pair key
+	std::vector<CandidatePair> candidatePairs;
+	std::vector<uint32_t> pairTable;
+	size_t numTouchingPairs, numSwaps;
+
+	// The events of an update are only dispatched once the pairs have been updated, so that the callbacks are free to insert and 
+	// remove colliders
+	std::vector<PairEvent> pendingEvents;
+
+	PairCallback onPairEnter, onPairStay, onPairExit;
+private:
+	// Returns the key of the pair of colliders given, the key is the same whichever order the colliders are given in.
+	static uint64_t GetPairKey(ColliderHandle first, ColliderHandle second);
+
+	// Returns TRUE if the first endpoint given belongs before the second endpoint given in the sorted endpoint array.
+	static bool IsEndpointBefore(const Endpoint& first, const Endpoint& second);
+
+	// Returns the slot of the pair table the search for the pair key given starts at.
+	size_t GetPairSlot(uint64_t pairKey) const;
+
+	// Returns the index of the candidate pair of the colliders given, or an invalid index if they're not a candidate pair.
+	uint32_t FindCandidatePair(ColliderHandle first, ColliderHandle second) const;
+
+	// Rebuilds the pair table with the number of slots given, which must be a power of two.
+	void ResizePairTable(size_t tableSize);
+
+	// Adds the pair of colliders given as a candidate pair, if it isn't one already.
+	void AddCandidatePair(ColliderHandle first, ColliderHandle second);
+
+	// Removes the pair of colliders given from the candidate pairs, queueing an exit event if they were touching.
+	void RemoveCandidatePair(ColliderHandle first, ColliderHandle second);
+
+	// Removes the candidate pair at the index given, queueing an exit event if its colliders were touching.
+	void RemoveCandidatePairAt(size_t pairIndex);
+
+	// Updates the endpoint indices stored by the colliders, for the endpoints from the index given onwards.
+	void ReindexEndpoints(size_t beginIndex);
+
+	// Sorts the endpoints with an insertion sort, adding and removing candidate pairs as the endpoints of colliders swap places.
+	void SortEndpoints();
+
+	// Removes the endpoints of the colliders removed since the last update from the endpoint array.
+	void RemoveDeadEndpoints();
+
+	// Merges the endpoints of the colliders inserted since the last update into the sorted endpoints, adding the candidate pairs 
+	// of the inserted colliders in a single sweep over the endpoints.
+	void MergeInsertedColliders();
+
+	// Removes the collider given from the open colliders it was added to while merging.
+	void CloseCollider(ColliderHandle handle);
+public:
+	SweepAndPrune();
+	~SweepAndPrune() = default;
+
+	// Inserts the collider given, its pairs are found on the next call to UpdatePairs.
+	// Returns the handle used to refer to the collider from then on.
+	ColliderHandle Insert(const RectangleCollider& collider);
+
+	// Replaces the collider of the handle given, the pairs are only updated on the next call to UpdatePairs.
+	void Update(ColliderHandle handle, const RectangleCollider& collider);
+
+	// Removes the collider of the handle given. The exit callback is called on the next call to UpdatePairs for every collider it 
+	// was touching, along with the rest of the events, and the handle isn't reused until then.
+	void Remove(ColliderHandle handle);
+
+	// Re-sorts the endpoints and tests the candidate pairs, calling the enter callback for the pairs that started touching, the stay 
+	// callback for the pairs still touching and the exit callback for the pairs that stopped touching since the last update.
+	// Should be called once every simulation step, after the colliders have been updated.
+	void UpdatePairs();
+
+	// Sets the function called when a pair of colliders starts touching.
+	void SetPairEnterCallback(PairCallback callbackFunc);
+
+	// Sets the function called for every pair of colliders still touching.
+	void SetPairStayCallback(PairCallback callbackFunc);
+
+	// Sets the function called when a pair of colliders stops touching.
+	void SetPairExitCallback(PairCallback callbackFunc);
+
+	// Returns the collider of the handle given.
+	const RectangleCollider& GetCollider(ColliderHandle handle) const;
+
+	// Returns the number of pairs of colliders overlapping on the X axis.
+	size_t GetNumCandidatePairs() const;
+
+	// Returns the number of pairs of colliders touching as of the last update.
+	const size_t& GetNumTouchingPairs() const;
+
+	// Returns the number of endpoint swaps made by the insertion sort during the last update.
+	const size_t& GetNumSwaps() const;
+};
+
+#endif
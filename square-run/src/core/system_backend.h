@@ -0,0 +1,11 @@
+#ifndef SYSTEM_BACKEND_H
+#define SYSTEM_BACKEND_H
+
+// Specifies what the engine systems (renderer, audio and input) are backed by, this is selected once at startup.
+enum class SystemBackend
+{
+	HARDWARE, // The system drives the actual device i.e. the window, OpenGL context and audio device
+	NULL_DEVICE // The system drives nothing, used for headless runs where only the simulation matters
+};
+
+#endif
@@ -0,0 +1,110 @@
+#include <core/system_scheduler.h>
+
+#include <algorithm>
+
+namespace SchedulerGlobals
+{
+	constexpr size_t maxWorkerThreads = 3;
+
+	// Handing systems to the worker threads costs a few microseconds, more than systems over fewer entities than this take to run
+	constexpr size_t minParallelEntities = 1024;
+}
+
+SystemAccess& SystemAccess::Exclusive()
+{
+	this->exclusive = true;
+	return *this;
+}
+
+bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+{
+	// Any number of systems may read a component at once, but a system writing a component must be the only one accessing it
+	return this->exclusive || other.exclusive || (this->writes & (other.reads | other.writes)).any() || 
+		(other.writes & this->reads).any();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SystemScheduler::SystemScheduler() :
+	runParallel(true)
+{}
+
+void SystemScheduler::BuildPhases()
+{
+	this->phases.clear();
+	std::vector<size_t> systemPhases(this->systems.size(), 0);
+
+	for (size_t systemIndex = 0; systemIndex < this->systems.size(); systemIndex++)
+	{
+		for (size_t earlierIndex = 0; earlierIndex < systemIndex; earlierIndex++)
+		{
+			if (this->systems[systemIndex].access.ConflictsWith(this->systems[earlierIndex].access))
+				systemPhases[systemIndex] = std::max(systemPhases[systemIndex], systemPhases[earlierIndex] + 1);
+		}
+
+		if (systemPhases[systemIndex] >= this->phases.size())
+			this->phases.resize(systemPhases[systemIndex] + 1);
+
+		this->phases[systemPhases[systemIndex]].emplace_back(systemIndex);
+	}
+}
+
+ThreadPool& SystemScheduler::GetWorkerPool()
+{
+	// The calling thread runs a system of every phase itself, so one less worker thread than there are cores is needed
+	static ThreadPool workerPool(std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 
+		SchedulerGlobals::maxWorkerThreads + 1) - 1);
+	return workerPool;
+}
+
+void SystemScheduler::AddSystem(const std::string_view& name, const SystemAccess& access, SystemFunc func)
+{
+	this->systems.push_back({ std::string(name), access, func });
+	this->BuildPhases();
+}
+
+void SystemScheduler::Clear()
+{
+	this->systems.clear();
+	this->phases.clear();
+}
+
+void SystemScheduler::SetParallel(bool enable)
+{
+	this->runParallel = enable;
+}
+
+void SystemScheduler::Run(EntityRegistry& registry, double deltaTime)
+{
+	// No view of a system can hold more entities than the registry, so small registries always run their systems on this thread
+	const bool parallel = this->runParallel && registry.GetNumEntities() >= SchedulerGlobals::minParallelEntities;
+
+	for (const std::vector<size_t>& phase : this->phases)
+	{
+		if (!parallel || phase.size() == 1)
+		{
+			for (const size_t& systemIndex : phase)
+				this->systems[systemIndex].func(registry, deltaTime);
+
+			continue;
+		}
+
+		// Hand every system but the first to the worker threads, the first is ran on this thread while they run
+		ThreadPool& workerPool = SystemScheduler::GetWorkerPool();
+		for (size_t phaseIndex = 1; phaseIndex < phase.size(); phaseIndex++)
+		{
+			const System& system = this->systems[phase[phaseIndex]];
+			workerPool.Submit([&system, &registry, deltaTime]() { system.func(registry, deltaTime); });
+		}
+
+		this->systems[phase.front()].func(registry, deltaTime);
+		workerPool.WaitIdle();
+	}
+
+	registry.FlushDeferred();
+}
+
+size_t SystemScheduler::GetNumPhases() const
+{
+	return this->phases.size();
+}
@@ -0,0 +1,73 @@
+#ifndef SYSTEM_SCHEDULER_H
+#define SYSTEM_SCHEDULER_H
+
+#include <core/entity_registry.h>
+#include <util/thread_pool.h>
+#include <string_view>
+#include <string>
+
+// The components a system reads and writes, used to work out which systems can run in parallel.
+struct SystemAccess
+{
+	ComponentMask reads, writes;
+	bool exclusive = false; // If TRUE, the system touches state outside the registry and never runs alongside another system
+
+	// Adds the component types given to the components read.
+	template<typename... Components> SystemAccess& Read();
+
+	// Adds the component types given to the components written.
+	template<typename... Components> SystemAccess& Write();
+
+	// Marks the system as exclusive.
+	SystemAccess& Exclusive();
+
+	// Returns TRUE if a system with this access can't run alongside a system with the access given, else FALSE is returned.
+	bool ConflictsWith(const SystemAccess& other) const;
+};
+
+class SystemScheduler
+{
+public:
+	using SystemFunc = std::function<void(EntityRegistry& registry, double deltaTime)>;
+private:
+	struct System
+	{
+		std::string name;
+		SystemAccess access;
+		SystemFunc func;
+	};
+private:
+	std::vector<System> systems;
+	std::vector<std::vector<size_t>> phases; // The systems ran in parallel in each phase, the phases are ran one after the other
+	bool runParallel;
+private:
+	// Assigns every system to the phase after the last phase containing a system, added before it, which it conflicts with.
+	// This way systems which conflict always run in the order they were added.
+	void BuildPhases();
+
+	// Returns the worker threads shared by every scheduler.
+	static ThreadPool& GetWorkerPool();
+public:
+	SystemScheduler();
+	~SystemScheduler() = default;
+
+	// Adds a system, systems run in the order they were added unless they don't conflict (in which case they may run in parallel).
+	void AddSystem(const std::string_view& name, const SystemAccess& access, SystemFunc func);
+
+	// Removes every system.
+	void Clear();
+
+	// Enables or disables running non-conflicting systems in parallel.
+	void SetParallel(bool enable);
+
+	// Runs every system on the registry given, then applies the structural changes they deferred.
+	// The systems of a phase only run in parallel if the registry has enough entities to be worth handing them to the worker threads.
+	void Run(EntityRegistry& registry, double deltaTime);
+
+	// Returns the number of phases the systems are split into, systems in the same phase run in parallel.
+	size_t GetNumPhases() const;
+};
+
+#include <core/system_scheduler.inl>
+
+#endif
@@ -0,0 +1,13 @@
+#include <core/system_scheduler.h>
+
+template<typename... Components> SystemAccess& SystemAccess::Read()
+{
+	this->reads |= ComponentType::GetMask<Components...>();
+	return *this;
+}
+
+template<typename... Components> SystemAccess& SystemAccess::Write()
+{
+	this->writes |= ComponentType::GetMask<Components...>();
+	return *this;
+}
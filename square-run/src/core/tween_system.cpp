@@ -0,0 +1,451 @@
+#include <core/tween_system.h>
+#include <immintrin.h>
+#include <algorithm>
+
+namespace TweenGlobals
+{
+	constexpr float minDuration = 1e-6f;
+
+	// The constants of the back out curve, which overshoots by roughly 10%
+	constexpr float backOvershoot = 1.70158f;
+	constexpr float backCubicFactor = backOvershoot + 1.0f;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TweenSequence& TweenSequence::Append(float* target, float endValue, float duration, EasingType easing)
+{
+	this->steps.emplace_back();
+	return this->Join(target, endValue, duration, easing);
+}
+
+TweenSequence& TweenSequence::Append(glm::vec2* target, const glm::vec2& endValue, float duration, EasingType easing)
+{
+	this->steps.emplace_back();
+	return this->Join(target, endValue, duration, easing);
+}
+
+TweenSequence& TweenSequence::Append(glm::vec4* target, const glm::vec4& endValue, float duration, EasingType easing)
+{
+	this->steps.emplace_back();
+	return this->Join(target, endValue, duration, easing);
+}
+
+TweenSequence& TweenSequence::Join(float* target, float endValue, float duration, EasingType easing)
+{
+	if (this->steps.empty())
+		this->steps.emplace_back();
+
+	this->steps.back().tracks.push_back({ target, endValue, duration, easing });
+	return *this;
+}
+
+TweenSequence& TweenSequence::Join(glm::vec2* target, const glm::vec2& endValue, float duration, EasingType easing)
+{
+	this->Join(&target->x, endValue.x, duration, easing);
+	return this->Join(&target->y, endValue.y, duration, easing);
+}
+
+TweenSequence& TweenSequence::Join(glm::vec4* target, const glm::vec4& endValue, float duration, EasingType easing)
+{
+	for (int component = 0; component < 4; component++)
+		this->Join(&(*target)[component], endValue[component], duration, easing);
+
+	return *this;
+}
+
+TweenSequence& TweenSequence::AppendInterval(float duration)
+{
+	return this->Append((float*)nullptr, 0.0f, duration);
+}
+
+TweenSequence& TweenSequence::AppendCallback(std::function<void()> callbackFunc)
+{
+	this->steps.emplace_back();
+	this->steps.back().callback = callbackFunc;
+	return *this;
+}
+
+TweenSequence& TweenSequence::SetCompleteCallback(std::function<void()> callbackFunc)
+{
+	this->completeCallback = callbackFunc;
+	return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TweenSystem::TweenSystem() :
+	groupLanes(1)
+{}
+
+TweenGroup TweenSystem::CreateGroup()
+{
+	this->groupLanes.emplace_back();
+	return (TweenGroup)(this->groupLanes.size() - 1);
+}
+
+TweenHandle TweenSystem::Play(TweenSequence sequence, TweenGroup group)
+{
+	if (group >= this->groupLanes.size())
+		group = TweenGlobals::defaultGroup;
+
+	uint32_t sequenceIndex = 0;
+	if (!this->freeSequences.empty())
+	{
+		sequenceIndex = this->freeSequences.back();
+		this->freeSequences.pop_back();
+	}
+	else
+	{
+		sequenceIndex = (uint32_t)this->sequences.size();
+		this->sequences.emplace_back();
+	}
+
+	ActiveSequence& activeSequence = this->sequences[sequenceIndex];
+	activeSequence.sequence = std::move(sequence);
+	activeSequence.group = group;
+	activeSequence.currentStep = 0;
+	activeSequence.numLanesLeft = 0;
+	activeSequence.alive = true;
+
+	const TweenHandle handle = { sequenceIndex, activeSequence.generation };
+	this->StartStep(sequenceIndex);
+	return handle;
+}
+
+TweenHandle TweenSystem::To(float* target, float endValue, float duration, EasingType easing, TweenGroup group)
+{
+	return this->Play(TweenSequence().Append(target, endValue, duration, easing), group);
+}
+
+TweenHandle TweenSystem::To(glm::vec2* target, const glm::vec2& endValue, float duration, EasingType easing, TweenGroup group)
+{
+	return this->Play(TweenSequence().Append(target, endValue, duration, easing), group);
+}
+
+TweenHandle TweenSystem::To(glm::vec4* target, const glm::vec4& endValue, float duration, EasingType easing, TweenGroup group)
+{
+	return this->Play(TweenSequence().Append(target, endValue, duration, easing), group);
+}
+
+void TweenSystem::StartStep(uint32_t sequenceIndex)
+{
+	const uint32_t generation = this->sequences[sequenceIndex].generation;
+
+	// The sequences are looked up by index every time, as the callbacks may play new sequences (which can reallocate the storage)
+	// or kill this one
+	while (this->sequences[sequenceIndex].alive && this->sequences[sequenceIndex].generation == generation)
+	{
+		ActiveSequence& activeSequence = this->sequences[sequenceIndex];
+		if (activeSequence.currentStep >= activeSequence.sequence.steps.size())
+		{
+			// Every step has finished, so free the sequence before calling the complete callback so that it can play it again
+			const std::function<void()> completeCallback = std::move(activeSequence.sequence.completeCallback);
+			activeSequence.sequence = TweenSequence();
+			activeSequence.alive = false;
+			activeSequence.generation++;
+			this->freeSequences.emplace_back(sequenceIndex);
+
+			if (completeCallback)
+				completeCallback();
+
+			return;
+		}
+
+		if (activeSequence.sequence.steps[activeSequence.currentStep].callback)
+		{
+			const std::function<void()> stepCallback = activeSequence.sequence.steps[activeSequence.currentStep].callback;
+			stepCallback();
+
+			if (!this->sequences[sequenceIndex].alive || this->sequences[sequenceIndex].generation != generation)
+				return;
+		}
+
+		// Add a lane for every track of the step, starting from the value the target holds right now
+		ActiveSequence& currentSequence = this->sequences[sequenceIndex];
+		const std::vector<TweenSequence::TweenTrack>& tracks = currentSequence.sequence.steps[currentSequence.currentStep].tracks;
+
+		for (const TweenSequence::TweenTrack& track : tracks)
+		{
+			const float startValue = track.target ? *track.target : 0.0f;
+
+			TweenLanes& easingLanes = this->groupLanes[currentSequence.group][(size_t)track.easing];
+			easingLanes.targets.emplace_back(track.target);
+			easingLanes.startValues.emplace_back(startValue);
+			easingLanes.endValues.emplace_back(track.endValue);
+			easingLanes.elapsedTimes.emplace_back(0.0f);
+			easingLanes.inverseDurations.emplace_back(1.0f / std::max(track.duration, TweenGlobals::minDuration));
+			easingLanes.values.emplace_back(startValue);
+			easingLanes.sequenceIndices.emplace_back(sequenceIndex);
+		}
+
+		currentSequence.numLanesLeft = tracks.size();
+		if (currentSequence.numLanesLeft > 0)
+			return;
+
+		currentSequence.currentStep++;
+	}
+}
+
+void TweenSystem::EvaluateLanesScalar(TweenLanes& easingLanes, EasingType easing, size_t beginIndex, float deltaTime)
+{
+	for (size_t laneIndex = beginIndex; laneIndex < easingLanes.targets.size(); laneIndex++)
+	{
+		const float elapsedTime = easingLanes.elapsedTimes[laneIndex] + deltaTime;
+		const float easedProgress = TweenSystem::Ease(easing, std::min(elapsedTime * easingLanes.inverseDurations[laneIndex], 1.0f));
+
+		easingLanes.elapsedTimes[laneIndex] = elapsedTime;
+		easingLanes.values[laneIndex] = (easingLanes.startValues[laneIndex] * (1.0f - easedProgress)) +
+			(easingLanes.endValues[laneIndex] * easedProgress);
+	}
+}
+
+void TweenSystem::EvaluateLanesSSE2(TweenLanes& easingLanes, EasingType easing, float deltaTime)
+{
+	const __m128 timeStep = _mm_set1_ps(deltaTime), one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f), four = _mm_set1_ps(4.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 backOvershoot = _mm_set1_ps(TweenGlobals::backOvershoot);
+	const __m128 backCubicFactor = _mm_set1_ps(TweenGlobals::backCubicFactor);
+
+	const size_t numVectorLanes = easingLanes.targets.size() / 4 * 4;
+	for (size_t laneIndex = 0; laneIndex < numVectorLanes; laneIndex += 4)
+	{
+		const __m128 elapsedTime = _mm_add_ps(_mm_loadu_ps(&easingLanes.elapsedTimes[laneIndex]), timeStep);
+		const __m128 progress = _mm_min_ps(_mm_mul_ps(elapsedTime, _mm_loadu_ps(&easingLanes.inverseDurations[laneIndex])), one);
+		const __m128 remaining = _mm_sub_ps(one, progress);
+
+		// The curves match TweenSystem::Ease operation for operation, so both paths produce the same values
+		__m128 easedProgress = progress;
+		switch (easing)
+		{
+		case EasingType::QUAD_IN:
+			easedProgress = _mm_mul_ps(progress, progress);
+			break;
+		case EasingType::QUAD_OUT:
+			easedProgress = _mm_mul_ps(progress, _mm_sub_ps(two, progress));
+			break;
+		case EasingType::QUAD_IN_OUT:
+		{
+			const __m128 firstHalf = _mm_mul_ps(two, _mm_mul_ps(progress, progress));
+			const __m128 secondHalf = _mm_sub_ps(one, _mm_mul_ps(two, _mm_mul_ps(remaining, remaining)));
+			const __m128 inFirstHalf = _mm_cmplt_ps(progress, half);
+			easedProgress = _mm_or_ps(_mm_and_ps(inFirstHalf, firstHalf), _mm_andnot_ps(inFirstHalf, secondHalf));
+			break;
+		}
+		case EasingType::CUBIC_IN:
+			easedProgress = _mm_mul_ps(_mm_mul_ps(progress, progress), progress);
+			break;
+		case EasingType::CUBIC_OUT:
+			easedProgress = _mm_sub_ps(one, _mm_mul_ps(_mm_mul_ps(remaining, remaining), remaining));
+			break;
+		case EasingType::CUBIC_IN_OUT:
+		{
+			const __m128 firstHalf = _mm_mul_ps(four, _mm_mul_ps(_mm_mul_ps(progress, progress), progress));
+			const __m128 secondHalf = _mm_sub_ps(one, _mm_mul_ps(four, _mm_mul_ps(_mm_mul_ps(remaining, remaining), remaining)));
+			const __m128 inFirstHalf = _mm_cmplt_ps(progress, half);
+			easedProgress = _mm_or_ps(_mm_and_ps(inFirstHalf, firstHalf), _mm_andnot_ps(inFirstHalf, secondHalf));
+			break;
+		}
+		case EasingType::BACK_OUT:
+		{
+			const __m128 offset = _mm_sub_ps(progress, one);
+			const __m128 offsetSquared = _mm_mul_ps(offset, offset);
+			easedProgress = _mm_add_ps(_mm_add_ps(one, _mm_mul_ps(backCubicFactor, _mm_mul_ps(offsetSquared, offset))),
+				_mm_mul_ps(backOvershoot, offsetSquared));
+			break;
+		}
+		default:
+			break;
+		}
+
+		_mm_storeu_ps(&easingLanes.elapsedTimes[laneIndex], elapsedTime);
+		_mm_storeu_ps(&easingLanes.values[laneIndex], _mm_add_ps(
+			_mm_mul_ps(_mm_loadu_ps(&easingLanes.startValues[laneIndex]), _mm_sub_ps(one, easedProgress)),
+			_mm_mul_ps(_mm_loadu_ps(&easingLanes.endValues[laneIndex]), easedProgress)));
+	}
+
+	this->EvaluateLanesScalar(easingLanes, easing, numVectorLanes, deltaTime);
+}
+
+void TweenSystem::RemoveLane(TweenLanes& easingLanes, size_t laneIndex)
+{
+	const size_t lastIndex = easingLanes.targets.size() - 1;
+	easingLanes.targets[laneIndex] = easingLanes.targets[lastIndex];
+	easingLanes.startValues[laneIndex] = easingLanes.startValues[lastIndex];
+	easingLanes.endValues[laneIndex] = easingLanes.endValues[lastIndex];
+	easingLanes.elapsedTimes[laneIndex] = easingLanes.elapsedTimes[lastIndex];
+	easingLanes.inverseDurations[laneIndex] = easingLanes.inverseDurations[lastIndex];
+	easingLanes.values[laneIndex] = easingLanes.values[lastIndex];
+	easingLanes.sequenceIndices[laneIndex] = easingLanes.sequenceIndices[lastIndex];
+
+	easingLanes.targets.pop_back();
+	easingLanes.startValues.pop_back();
+	easingLanes.endValues.pop_back();
+	easingLanes.elapsedTimes.pop_back();
+	easingLanes.inverseDurations.pop_back();
+	easingLanes.values.pop_back();
+	easingLanes.sequenceIndices.pop_back();
+}
+
+void TweenSystem::Kill(TweenHandle& handle)
+{
+	if (!this->IsPlaying(handle))
+	{
+		handle = TweenHandle();
+		return;
+	}
+
+	for (TweenLanes& easingLanes : this->groupLanes[this->sequences[handle.index].group])
+	{
+		for (size_t laneIndex = 0; laneIndex < easingLanes.targets.size();)
+		{
+			if (easingLanes.sequenceIndices[laneIndex] == handle.index)
+				TweenSystem::RemoveLane(easingLanes, laneIndex);
+			else
+				laneIndex++;
+		}
+	}
+
+	ActiveSequence& activeSequence = this->sequences[handle.index];
+	activeSequence.sequence = TweenSequence();
+	activeSequence.alive = false;
+	activeSequence.generation++;
+	this->freeSequences.emplace_back(handle.index);
+
+	handle = TweenHandle();
+}
+
+void TweenSystem::KillAll()
+{
+	for (GroupLanes& lanes : this->groupLanes)
+	{
+		for (TweenLanes& easingLanes : lanes)
+		{
+			easingLanes.targets.clear();
+			easingLanes.startValues.clear();
+			easingLanes.endValues.clear();
+			easingLanes.elapsedTimes.clear();
+			easingLanes.inverseDurations.clear();
+			easingLanes.values.clear();
+			easingLanes.sequenceIndices.clear();
+		}
+	}
+
+	this->freeSequences.clear();
+	for (uint32_t sequenceIndex = 0; sequenceIndex < (uint32_t)this->sequences.size(); sequenceIndex++)
+	{
+		ActiveSequence& activeSequence = this->sequences[sequenceIndex];
+		if (activeSequence.alive)
+		{
+			activeSequence.sequence = TweenSequence();
+			activeSequence.alive = false;
+			activeSequence.generation++;
+		}
+
+		this->freeSequences.emplace_back(sequenceIndex);
+	}
+}
+
+void TweenSystem::Update(const double& deltaTime, TweenGroup group)
+{
+	if (group >= this->groupLanes.size())
+		return;
+
+	this->finishedLanes.clear();
+	GroupLanes& lanes = this->groupLanes[group];
+
+	for (size_t easingIndex = 0; easingIndex < lanes.size(); easingIndex++)
+	{
+		TweenLanes& easingLanes = lanes[easingIndex];
+		if (easingLanes.targets.empty())
+			continue;
+
+		this->EvaluateLanesSSE2(easingLanes, (EasingType)easingIndex, (float)deltaTime);
+
+		// Write the values out to their targets, and remove the lanes which have reached their end value
+		for (size_t laneIndex = 0; laneIndex < easingLanes.targets.size(); laneIndex++)
+		{
+			if (easingLanes.targets[laneIndex])
+				*easingLanes.targets[laneIndex] = easingLanes.values[laneIndex];
+		}
+
+		for (size_t laneIndex = 0; laneIndex < easingLanes.targets.size();)
+		{
+			if (easingLanes.elapsedTimes[laneIndex] * easingLanes.inverseDurations[laneIndex] >= 1.0f)
+			{
+				const uint32_t sequenceIndex = easingLanes.sequenceIndices[laneIndex];
+				this->finishedLanes.push_back({ sequenceIndex, this->sequences[sequenceIndex].generation });
+				TweenSystem::RemoveLane(easingLanes, laneIndex);
+			}
+			else
+				laneIndex++;
+		}
+	}
+
+	// Move the sequences whose current step has finished onto their next step, this is done once every lane has been evaluated as
+	// the callbacks may play or kill tweens
+	for (const TweenHandle& finishedLane : this->finishedLanes)
+	{
+		ActiveSequence& activeSequence = this->sequences[finishedLane.index];
+		if (!activeSequence.alive || activeSequence.generation != finishedLane.generation)
+			continue;
+
+		if (--activeSequence.numLanesLeft == 0)
+		{
+			activeSequence.currentStep++;
+			this->StartStep(finishedLane.index);
+		}
+	}
+}
+
+bool TweenSystem::IsPlaying(const TweenHandle& handle) const
+{
+	return handle.index < this->sequences.size() && this->sequences[handle.index].alive &&
+		this->sequences[handle.index].generation == handle.generation;
+}
+
+size_t TweenSystem::GetNumLiveLanes() const
+{
+	size_t numLiveLanes = 0;
+	for (const GroupLanes& lanes : this->groupLanes)
+	{
+		for (const TweenLanes& easingLanes : lanes)
+			numLiveLanes += easingLanes.targets.size();
+	}
+
+	return numLiveLanes;
+}
+
+float TweenSystem::Ease(EasingType easing, float progress)
+{
+	const float remaining = 1.0f - progress;
+
+	switch (easing)
+	{
+	case EasingType::QUAD_IN:
+		return progress * progress;
+	case EasingType::QUAD_OUT:
+		return progress * (2.0f - progress);
+	case EasingType::QUAD_IN_OUT:
+		return progress < 0.5f ? 2.0f * (progress * progress) : 1.0f - (2.0f * (remaining * remaining));
+	case EasingType::CUBIC_IN:
+		return (progress * progress) * progress;
+	case EasingType::CUBIC_OUT:
+		return 1.0f - ((remaining * remaining) * remaining);
+	case EasingType::CUBIC_IN_OUT:
+		return progress < 0.5f ? 4.0f * ((progress * progress) * progress) : 1.0f - (4.0f * ((remaining * remaining) * remaining));
+	case EasingType::BACK_OUT:
+	{
+		const float offset = progress - 1.0f, offsetSquared = offset * offset;
+		return (1.0f + (TweenGlobals::backCubicFactor * (offsetSquared * offset))) + (TweenGlobals::backOvershoot * offsetSquared);
+	}
+	default:
+		return progress;
+	}
+}
+
+TweenSystem& TweenSystem::GetInstance()
+{
+	static TweenSystem instance;
+	return instance;
+}
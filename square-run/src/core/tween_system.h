@@ -0,0 +1,175 @@
+#ifndef TWEEN_SYSTEM_H
+#define TWEEN_SYSTEM_H
+
+#include <glm/glm.hpp>
+#include <functional>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+// The curves a tween can follow between its start and end values, they're all polynomials so they can be evaluated with SIMD.
+enum class EasingType
+{
+	LINEAR,
+	QUAD_IN,
+	QUAD_OUT,
+	QUAD_IN_OUT,
+	CUBIC_IN,
+	CUBIC_OUT,
+	CUBIC_IN_OUT,
+	BACK_OUT, // Overshoots the end value slightly before settling on it
+	COUNT
+};
+
+// Tweens are played in a group, and each group is advanced on its own. So the tweens of a game state can be advanced only while the
+// game state is being updated.
+using TweenGroup = uint32_t;
+
+namespace TweenGlobals
+{
+	constexpr uint32_t invalidIndex = UINT32_MAX;
+	constexpr TweenGroup defaultGroup = 0; // For the tweens which aren't owned by a game state, such as the interface's
+}
+
+// Identifies a playing tween (or sequence of tweens), it goes stale once the tween finishes or is killed.
+struct TweenHandle
+{
+	uint32_t index = TweenGlobals::invalidIndex, generation = 0;
+};
+
+// A list of tween steps which are played one after another, the tweens within the same step are played alongside each other.
+// Each tween starts from whatever value its target holds when its step starts, so a sequence carries on from the previous step.
+class TweenSequence
+{
+	friend class TweenSystem;
+private:
+	// A single float being animated, or a wait if the target is null.
+	struct TweenTrack
+	{
+		float* target;
+		float endValue, duration;
+		EasingType easing;
+	};
+
+	struct TweenStep
+	{
+		std::vector<TweenTrack> tracks;
+		std::function<void()> callback; // Called as the step starts
+	};
+private:
+	std::vector<TweenStep> steps;
+	std::function<void()> completeCallback;
+public:
+	TweenSequence() = default;
+	~TweenSequence() = default;
+
+	// Appends a step animating the target given to the end value given.
+	TweenSequence& Append(float* target, float endValue, float duration, EasingType easing = EasingType::LINEAR);
+	TweenSequence& Append(glm::vec2* target, const glm::vec2& endValue, float duration, EasingType easing = EasingType::LINEAR);
+	TweenSequence& Append(glm::vec4* target, const glm::vec4& endValue, float duration, EasingType easing = EasingType::LINEAR);
+
+	// Animates the target given to the end value given alongside the tweens of the last appended step.
+	TweenSequence& Join(float* target, float endValue, float duration, EasingType easing = EasingType::LINEAR);
+	TweenSequence& Join(glm::vec2* target, const glm::vec2& endValue, float duration, EasingType easing = EasingType::LINEAR);
+	TweenSequence& Join(glm::vec4* target, const glm::vec4& endValue, float duration, EasingType easing = EasingType::LINEAR);
+
+	// Appends a step which does nothing for the duration given.
+	TweenSequence& AppendInterval(float duration);
+
+	// Appends a step which calls the function given, then moves straight onto the next step.
+	TweenSequence& AppendCallback(std::function<void()> callbackFunc);
+
+	// Sets the function called once every step has finished.
+	TweenSequence& SetCompleteCallback(std::function<void()> callbackFunc);
+};
+
+// Plays tweens, the values of every live tween are stored contiguously (grouped by easing curve) and evaluated together in one
+// SIMD pass every step. Finished tweens are removed straight away, so nothing is evaluated while nothing is animating.
+// The targets of a tween must outlive it, or the tween must be killed before they're destroyed.
+class TweenSystem
+{
+private:
+	// The live tracks following the same easing curve, stored as a structure of arrays.
+	struct TweenLanes
+	{
+		std::vector<float*> targets;
+		std::vector<float> startValues, endValues, elapsedTimes, inverseDurations, values;
+		std::vector<uint32_t> sequenceIndices;
+	};
+
+	using GroupLanes = std::array<TweenLanes, (size_t)EasingType::COUNT>;
+
+	struct ActiveSequence
+	{
+		TweenSequence sequence;
+		TweenGroup group = TweenGlobals::defaultGroup;
+		size_t currentStep = 0, numLanesLeft = 0;
+		uint32_t generation = 0;
+		bool alive = false;
+	};
+private:
+	std::vector<GroupLanes> groupLanes; // Indexed by the group
+
+	std::vector<ActiveSequence> sequences;
+	std::vector<uint32_t> freeSequences;
+	std::vector<TweenHandle> finishedLanes;
+private:
+	TweenSystem();
+
+	// Starts the current step of the sequence at the index given, skipping past any steps which finish straight away.
+	void StartStep(uint32_t sequenceIndex);
+
+	// Evaluates the lanes given over the time step given.
+	void EvaluateLanesScalar(TweenLanes& easingLanes, EasingType easing, size_t beginIndex, float deltaTime);
+	void EvaluateLanesSSE2(TweenLanes& easingLanes, EasingType easing, float deltaTime);
+
+	// Removes the lane at the index given, the last lane is moved into its place.
+	static void RemoveLane(TweenLanes& easingLanes, size_t laneIndex);
+public:
+	TweenSystem(const TweenSystem& other) = delete;
+	TweenSystem(TweenSystem&& temp) noexcept = delete;
+	~TweenSystem() = default;
+
+	TweenSystem& operator=(const TweenSystem& other) = delete;
+	TweenSystem& operator=(TweenSystem&& temp) noexcept = delete;
+
+	// Adds a group of tweens, which is advanced separately from every other group.
+	// Returns the new group.
+	TweenGroup CreateGroup();
+
+	// Starts playing the sequence given in the group given.
+	// Returns the handle of the playing sequence.
+	TweenHandle Play(TweenSequence sequence, TweenGroup group = TweenGlobals::defaultGroup);
+
+	// Starts animating the target given to the end value given, in the group given.
+	// Returns the handle of the playing tween.
+	TweenHandle To(float* target, float endValue, float duration, EasingType easing = EasingType::LINEAR, 
+		TweenGroup group = TweenGlobals::defaultGroup);
+	TweenHandle To(glm::vec2* target, const glm::vec2& endValue, float duration, EasingType easing = EasingType::LINEAR, 
+		TweenGroup group = TweenGlobals::defaultGroup);
+	TweenHandle To(glm::vec4* target, const glm::vec4& endValue, float duration, EasingType easing = EasingType::LINEAR, 
+		TweenGroup group = TweenGlobals::defaultGroup);
+
+	// Stops the tween (or sequence) given where it is, without calling any of its callbacks.
+	void Kill(TweenHandle& handle);
+
+	// Stops every playing tween.
+	void KillAll();
+
+	// Advances every playing tween of the group given by the time step given.
+	void Update(const double& deltaTime, TweenGroup group = TweenGlobals::defaultGroup);
+
+	// Returns TRUE if the tween (or sequence) given is still playing, else FALSE is returned.
+	bool IsPlaying(const TweenHandle& handle) const;
+
+	// Returns the number of floats being animated.
+	size_t GetNumLiveLanes() const;
+
+	// Returns the easing curve given evaluated at the progress given (in the range 0-1).
+	static float Ease(EasingType easing, float progress);
+
+	// Returns singleton instance object of this class.
+	static TweenSystem& GetInstance();
+};
+
+#endif
@@ -0,0 +1,246 @@
+#include <core/voice_pool.h>
+#include <util/logging_system.h>
+#include <util/directory_system.h>
+
+#include <algorithm>
+#include <string>
+
+VoicePool::VoicePool(irrklang::ISoundEngine* engine, size_t numVoices) :
+	engine(engine), voices(numVoices), stoppedVoices(numVoices * 2), paused(false), numStolenVoices(0), numDroppedTriggers(0)
+{
+	if (numVoices > VoicePoolGlobals::voiceIndexMask)
+		LogSystem::GetInstance().OutputLog("The voice pool was given too many voices", Severity::FATAL);
+
+	this->engine->grab(); // We get a pointer to the engine, so increase the ref count to the engine
+
+	// The free voices are popped from the back, so the voices are handed out in order
+	this->freeVoices.reserve(numVoices);
+	for (size_t voiceIndex = numVoices; voiceIndex-- > 0;)
+		this->freeVoices.push_back((int32_t)voiceIndex);
+}
+
+VoicePool::~VoicePool()
+{
+	for (SoundEffectHandle handle = 0; handle < (SoundEffectHandle)this->effects.size(); handle++)
+	{
+		SoundEffectHandle effectHandle = handle;
+		this->UnregisterEffect(effectHandle);
+	}
+
+	this->engine->drop();
+}
+
+void VoicePool::OnSoundStopped(irrklang::ISound* sound, irrklang::E_STOP_EVENT_CAUSE reason, void* userData)
+{
+	this->stoppedVoices.Push((uint32_t)reinterpret_cast<uintptr_t>(userData));
+}
+
+void VoicePool::ReclaimStoppedVoices()
+{
+	uint32_t stopEvent = 0;
+	while (this->stoppedVoices.Pop(stopEvent))
+	{
+		// The voice may have since been released and played on again, in which case the stop event is for its previous sound
+		const int32_t voiceIndex = (int32_t)(stopEvent & VoicePoolGlobals::voiceIndexMask);
+		const Voice& voice = this->voices[voiceIndex];
+
+		if (voice.sound && voice.generation == stopEvent >> VoicePoolGlobals::voiceIndexBits)
+			this->ReleaseVoice(voiceIndex);
+	}
+}
+
+void VoicePool::ReleaseVoice(int32_t voiceIndex)
+{
+	Voice& voice = this->voices[voiceIndex];
+
+	// The stop event receiver is removed first, so stopping the sound doesn't push a stop event from this thread
+	voice.sound->setSoundStopEventReceiver(nullptr);
+	voice.sound->stop();
+	voice.sound->drop();
+	voice.sound = nullptr;
+
+	SoundEffect& effect = this->effects[voice.effect];
+	this->UnlinkVoice(this->activeVoices[(size_t)effect.priority], voiceIndex, &Voice::previousOfPriority, &Voice::nextOfPriority);
+	this->UnlinkVoice(effect.voices, voiceIndex, &Voice::previousOfEffect, &Voice::nextOfEffect);
+
+	voice.effect = VoicePoolGlobals::invalidHandle;
+	this->freeVoices.push_back(voiceIndex);
+}
+
+void VoicePool::LinkVoice(VoiceList& list, int32_t voiceIndex, int32_t Voice::* previous, int32_t Voice::* next)
+{
+	Voice& voice = this->voices[voiceIndex];
+	voice.*previous = list.tail;
+	voice.*next = -1;
+
+	if (list.tail >= 0)
+		this->voices[list.tail].*next = voiceIndex;
+	else
+		list.head = voiceIndex;
+
+	list.tail = voiceIndex;
+	list.size++;
+}
+
+void VoicePool::UnlinkVoice(VoiceList& list, int32_t voiceIndex, int32_t Voice::* previous, int32_t Voice::* next)
+{
+	Voice& voice = this->voices[voiceIndex];
+
+	if (voice.*previous >= 0)
+		this->voices[voice.*previous].*next = voice.*next;
+	else
+		list.head = voice.*next;
+
+	if (voice.*next >= 0)
+		this->voices[voice.*next].*previous = voice.*previous;
+	else
+		list.tail = voice.*previous;
+
+	voice.*previous = voice.*next = -1;
+	list.size--;
+}
+
+SoundEffectHandle VoicePool::RegisterEffect(const std::string_view& fileName, uint32_t maxInstances, SoundPriority priority,
+	float volume)
+{
+	// Construct the full path to the audio file
+	const std::string filePath = Util::GetGameRequisitesDirectory() + "assets/" + fileName.data();
+
+	// Load the audio file, the sound source is grabbed so it's guaranteed to outlive every voice playing it
+	irrklang::ISoundSource* source = this->engine->addSoundSourceFromFile(filePath.c_str(), irrklang::ESM_NO_STREAMING, true);
+	if (!source)
+	{
+		LogSystem::GetInstance().OutputLog("Failed to load sound effect \"" + filePath + "\"", Severity::WARNING);
+		return VoicePoolGlobals::invalidHandle;
+	}
+
+	source->grab();
+
+	// Reuse a free sound effect slot if there is one, else add a new slot
+	SoundEffectHandle handle = (SoundEffectHandle)this->effects.size();
+	if (!this->freeEffects.empty())
+	{
+		handle = this->freeEffects.back();
+		this->freeEffects.pop_back();
+	}
+	else
+	{
+		this->effects.emplace_back();
+	}
+
+	SoundEffect& effect = this->effects[handle];
+	effect.source = source;
+	effect.maxInstances = std::max(maxInstances, 1u);
+	effect.priority = priority;
+	effect.volume = std::clamp(volume, 0.0f, 1.0f);
+
+	return handle;
+}
+
+void VoicePool::UnregisterEffect(SoundEffectHandle& handle)
+{
+	if (handle < this->effects.size() && this->effects[handle].source)
+	{
+		SoundEffect& effect = this->effects[handle];
+		while (effect.voices.head >= 0)
+			this->ReleaseVoice(effect.voices.head);
+
+		effect.source->drop();
+		this->engine->removeSoundSource(effect.source);
+		effect.source = nullptr;
+
+		this->freeEffects.push_back(handle);
+	}
+
+	handle = VoicePoolGlobals::invalidHandle;
+}
+
+bool VoicePool::Trigger(SoundEffectHandle handle, float volume)
+{
+	if (handle >= this->effects.size() || !this->effects[handle].source)
+		return false;
+
+	this->ReclaimStoppedVoices();
+	SoundEffect& effect = this->effects[handle];
+
+	if (effect.voices.size >= effect.maxInstances)
+	{
+		// Cut off the oldest instance of the sound effect, so the voice goes to the newest instance
+		this->ReleaseVoice(effect.voices.head);
+		this->numStolenVoices++;
+	}
+	else if (this->freeVoices.empty())
+	{
+		// Steal the oldest voice of the lowest priority, as long as it's not of a higher priority than the sound effect
+		int32_t stolenVoice = -1;
+		for (size_t priority = 0; priority <= (size_t)effect.priority && stolenVoice < 0; priority++)
+			stolenVoice = this->activeVoices[priority].head;
+
+		if (stolenVoice < 0)
+		{
+			this->numDroppedTriggers++;
+			return false;
+		}
+
+		this->ReleaseVoice(stolenVoice);
+		this->numStolenVoices++;
+	}
+
+	const int32_t voiceIndex = this->freeVoices.back();
+	Voice& voice = this->voices[voiceIndex];
+
+	// The sound starts paused, so the stop event receiver is set before the sound could possibly finish
+	voice.sound = this->engine->play2D(effect.source, false, true, true, false);
+	if (!voice.sound)
+		return false;
+
+	this->freeVoices.pop_back();
+	voice.effect = handle;
+	voice.generation = (voice.generation + 1) & (UINT32_MAX >> VoicePoolGlobals::voiceIndexBits);
+
+	const uint32_t stopEvent = (voice.generation << VoicePoolGlobals::voiceIndexBits) | (uint32_t)voiceIndex;
+	voice.sound->setSoundStopEventReceiver(this, reinterpret_cast<void*>((uintptr_t)stopEvent));
+	voice.sound->setVolume(std::clamp(effect.volume * volume, 0.0f, 1.0f));
+
+	if (!this->paused)
+		voice.sound->setIsPaused(false);
+
+	this->LinkVoice(this->activeVoices[(size_t)effect.priority], voiceIndex, &Voice::previousOfPriority, &Voice::nextOfPriority);
+	this->LinkVoice(effect.voices, voiceIndex, &Voice::previousOfEffect, &Voice::nextOfEffect);
+	return true;
+}
+
+void VoicePool::StopAll()
+{
+	for (int32_t voiceIndex = 0; voiceIndex < (int32_t)this->voices.size(); voiceIndex++)
+	{
+		if (this->voices[voiceIndex].sound)
+			this->ReleaseVoice(voiceIndex);
+	}
+}
+
+void VoicePool::SetPaused(bool paused)
+{
+	this->paused = paused;
+
+	for (const Voice& voice : this->voices)
+	{
+		if (voice.sound)
+			voice.sound->setIsPaused(paused);
+	}
+}
+
+size_t VoicePool::GetNumActiveVoices() const
+{
+	return this->voices.size() - this->freeVoices.size();
+}
+
+const size_t& VoicePool::GetNumStolenVoices() const
+{
+	return this->numStolenVoices;
+}
+
+const size_t& VoicePool::GetNumDroppedTriggers() const
+{
+	return this->numDroppedTriggers;
+}
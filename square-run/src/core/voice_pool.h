@@ -0,0 +1,132 @@
+#ifndef VOICE_POOL_H
+#define VOICE_POOL_H
+
+#include <util/ring_buffer.h>
+#include <irrKlang.h>
+
+#include <string_view>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+using SoundEffectHandle = uint32_t;
+
+// The priority of a sound effect decides which voices it may steal once every voice is in use, it can only steal the voices of sound
+// effects of the same or a lower priority.
+enum class SoundPriority
+{
+	LOW,
+	MEDIUM,
+	HIGH,
+	CRITICAL
+};
+
+namespace VoicePoolGlobals
+{
+	constexpr SoundEffectHandle invalidHandle = UINT32_MAX;
+	constexpr size_t numVoices = 32;
+	constexpr size_t numPriorities = (size_t)SoundPriority::CRITICAL + 1;
+
+	// The stop events identify the voice by its index in the low bits and its generation in the high bits
+	constexpr uint32_t voiceIndexBits = 16;
+	constexpr uint32_t voiceIndexMask = (1u << voiceIndexBits) - 1;
+}
+
+// Plays preloaded sound effects on a fixed number of voices, so any number of effects can be triggered without the number of sounds
+// playing at once growing unbounded. Each sound effect is limited to a number of instances, and once every voice is in use the oldest
+// voice of the lowest priority is stolen. The sound sources are grabbed when registered, and the voices are linked into lists through
+// the voices themselves, so triggering a sound effect is a constant time call which doesn't allocate (beyond what irrKlang allocates
+// internally to play the sound).
+class VoicePool : private irrklang::ISoundStopEventReceiver
+{
+private:
+	// A list of voices, oldest first, linked through the voices themselves so moving voices between lists never allocates.
+	struct VoiceList
+	{
+		int32_t head = -1, tail = -1;
+		uint32_t size = 0;
+	};
+
+	struct Voice
+	{
+		irrklang::ISound* sound = nullptr; // Null while the voice is free
+		SoundEffectHandle effect = VoicePoolGlobals::invalidHandle;
+		uint32_t generation = 0; // Bumped every time the voice is played on, so stop events of its previous sounds can be told apart
+		int32_t previousOfPriority = -1, nextOfPriority = -1; // Links in the list of voices of the same priority
+		int32_t previousOfEffect = -1, nextOfEffect = -1; // Links in the list of voices playing the same sound effect
+	};
+
+	struct SoundEffect
+	{
+		irrklang::ISoundSource* source = nullptr; // Null while the sound effect slot is free
+		uint32_t maxInstances = 0;
+		SoundPriority priority = SoundPriority::MEDIUM;
+		float volume = 1.0f;
+		VoiceList voices;
+	};
+private:
+	irrklang::ISoundEngine* engine;
+	std::vector<Voice> voices;
+	std::vector<int32_t> freeVoices;
+	std::array<VoiceList, VoicePoolGlobals::numPriorities> activeVoices;
+
+	std::vector<SoundEffect> effects;
+	std::vector<SoundEffectHandle> freeEffects;
+
+	// The voices whose sounds have stopped, pushed by irrKlang's thread and reclaimed every step (and on the next trigger)
+	RingBuffer<uint32_t> stoppedVoices;
+	bool paused;
+
+	size_t numStolenVoices, numDroppedTriggers;
+private:
+	// Called by irrKlang (on its own thread) when a sound played on a voice stops.
+	void OnSoundStopped(irrklang::ISound* sound, irrklang::E_STOP_EVENT_CAUSE reason, void* userData) override;
+
+	// Stops the sound of the voice given (if it's still playing) and returns the voice to the free voices.
+	void ReleaseVoice(int32_t voiceIndex);
+
+	// Adds the voice given to the back of the list given, using the link members given.
+	void LinkVoice(VoiceList& list, int32_t voiceIndex, int32_t Voice::* previous, int32_t Voice::* next);
+
+	// Removes the voice given from the list given, using the link members given.
+	void UnlinkVoice(VoiceList& list, int32_t voiceIndex, int32_t Voice::* previous, int32_t Voice::* next);
+public:
+	VoicePool(irrklang::ISoundEngine* engine, size_t numVoices = VoicePoolGlobals::numVoices);
+	~VoicePool();
+
+	VoicePool(const VoicePool& other) = delete;
+	VoicePool& operator=(const VoicePool& other) = delete;
+
+	// Loads the sound effect from the specified audio file, which is decoded fully into memory.
+	// Returns the handle of the sound effect, or an invalid handle if the file failed to load.
+	SoundEffectHandle RegisterEffect(const std::string_view& fileName, uint32_t maxInstances = 4,
+		SoundPriority priority = SoundPriority::MEDIUM, float volume = 1.0f);
+
+	// Stops every instance of the sound effect given, unloads it and resets the handle.
+	void UnregisterEffect(SoundEffectHandle& handle);
+
+	// Plays the sound effect given at the volume given (scaled by the volume of the sound effect).
+	// If the sound effect is at its instance limit its oldest instance is cut off, else if every voice is in use the oldest voice of
+	// the lowest priority is stolen. Returns FALSE if every voice is playing a sound effect of a higher priority, else TRUE.
+	bool Trigger(SoundEffectHandle handle, float volume = 1.0f);
+
+	// Returns the voices whose sounds have stopped to the free voices, this is done by the audio system every step.
+	void ReclaimStoppedVoices();
+
+	// Stops every sound effect being played.
+	void StopAll();
+
+	// Pauses or resumes every sound effect being played, and sets whether the sound effects triggered from now on start paused.
+	void SetPaused(bool paused);
+
+	// Returns the number of voices in use, as of the last time the stopped voices were reclaimed.
+	size_t GetNumActiveVoices() const;
+
+	// Returns the number of voices which were stolen from a playing sound effect, including instances cut off by their limit.
+	const size_t& GetNumStolenVoices() const;
+
+	// Returns the number of triggers which were dropped, as every voice was playing a sound effect of a higher priority.
+	const size_t& GetNumDroppedTriggers() const;
+};
+
+#endif
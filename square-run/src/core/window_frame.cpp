@@ -1,27 +1,53 @@
 #include <core/window_frame.h>
+#include <core/latency_tracker.h>
 #include <util/logging_system.h>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+
+namespace WindowGlobals
+{
+	// The number of frame fences kept at most when the number of frames in flight isn't limited, this caps the queue depth reported
+	constexpr size_t maxTrackedFrames = 8;
+}
+
 namespace Callback
 {
 	int* width = nullptr;
 	int* height = nullptr;
+	bool* focused = nullptr;
+	bool* iconified = nullptr;
 
 	void WindowResizeCallback(GLFWwindow* frame, int width, int height)
 	{
 		*Callback::width = width;
 		*Callback::height = height;
 	}
+
+	void WindowFocusCallback(GLFWwindow* frame, int focused)
+	{
+		*Callback::focused = focused;
+	}
+
+	void WindowIconifyCallback(GLFWwindow* frame, int iconified)
+	{
+		*Callback::iconified = iconified;
+	}
 }
 
-WindowFrame::WindowFrame(const std::string_view& title, int width, int height, bool fullscreen, bool resizable, bool enableVsync) :
-	width(width), height(height), fullscreen(fullscreen), resizable(resizable), vsyncEnabled(enableVsync)
+WindowFrame::WindowFrame(const std::string_view& title, int width, int height, bool fullscreen, bool resizable, bool enableVsync, 
+	bool enableAdaptiveVsync, int maxFramesInFlight) :
+	width(width), height(height), fullscreen(fullscreen), resizable(resizable), vsyncEnabled(enableVsync), 
+	adaptiveVsyncEnabled(false), focused(true), iconified(false), maxFramesInFlight(std::max(maxFramesInFlight, 0)), 
+	frameQueueDepth(0), totalFrameQueueDepth(0), numFramesPresented(0)
 {
 	// Initialize callback member pointers
 	Callback::width = &this->width;
 	Callback::height = &this->height;
+	Callback::focused = &this->focused;
+	Callback::iconified = &this->iconified;
 
 	// Initialize the GLFW library
 	if (!glfwInit())
@@ -44,10 +70,21 @@ WindowFrame::WindowFrame(const std::string_view& title, int width, int height, b
 	const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
 	glfwSetWindowPos(this->framePtr, (videoMode->width / 2) - (width / 2), (videoMode->height / 2) - (height / 2));
 	glfwSetWindowSizeCallback(this->framePtr, Callback::WindowResizeCallback);
+	glfwSetWindowFocusCallback(this->framePtr, Callback::WindowFocusCallback);
+	glfwSetWindowIconifyCallback(this->framePtr, Callback::WindowIconifyCallback);
 	glfwMakeContextCurrent(this->framePtr);
 
 	if (enableVsync)
-		glfwSwapInterval(1);
+	{
+		// Adaptive vsync is requested with a negative swap interval, which is only allowed if the swap control tear extension exists
+		this->adaptiveVsyncEnabled = enableAdaptiveVsync && (glfwExtensionSupported("WGL_EXT_swap_control_tear") || 
+			glfwExtensionSupported("GLX_EXT_swap_control_tear"));
+
+		if (enableAdaptiveVsync && !this->adaptiveVsyncEnabled)
+			LogSystem::GetInstance().OutputLog("Adaptive vsync isn't supported, falling back to regular vsync", Severity::WARNING);
+
+		glfwSwapInterval(this->adaptiveVsyncEnabled ? -1 : 1);
+	}
 
 	// Load the OpenGL function implementations via GLAD
 	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
@@ -58,6 +95,9 @@ WindowFrame::WindowFrame(const std::string_view& title, int width, int height, b
 
 WindowFrame::~WindowFrame()
 {
+	for (GLsync frameFence : this->frameFences)
+		glDeleteSync(frameFence);
+
 	glfwTerminate();
 }
 
@@ -71,10 +111,51 @@ void WindowFrame::RequestExit() const
 	glfwSetWindowShouldClose(this->framePtr, true);
 }
 
-void WindowFrame::Refresh() const
+void WindowFrame::Refresh()
 {
 	glfwPollEvents();
+
+	LatencyTracker::GetInstance().OnPresentBegin();
 	glfwSwapBuffers(this->framePtr);
+	this->LimitFramesInFlight();
+	LatencyTracker::GetInstance().OnPresentEnd();
+}
+
+void WindowFrame::LimitFramesInFlight()
+{
+	this->frameFences.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+	// Drop the fences of the frames which the GPU has already finished
+	while (!this->frameFences.empty())
+	{
+		const GLenum waitResult = glClientWaitSync(this->frameFences.front(), 0, 0);
+		if (waitResult == GL_TIMEOUT_EXPIRED)
+			break;
+
+		glDeleteSync(this->frameFences.front());
+		this->frameFences.pop_front();
+	}
+
+	// The frame just presented is excluded from the queue depth, since it was only just submitted
+	this->frameQueueDepth = (int)this->frameFences.size() - (this->frameFences.empty() ? 0 : 1);
+	this->totalFrameQueueDepth += this->frameQueueDepth;
+	this->numFramesPresented++;
+
+	// Block until the oldest frames are finished, the commands are flushed so that the fence is guaranteed to be signalled
+	const size_t maxFences = this->maxFramesInFlight > 0 ? (size_t)this->maxFramesInFlight : WindowGlobals::maxTrackedFrames;
+	while (this->frameFences.size() > maxFences)
+	{
+		if (this->maxFramesInFlight > 0)
+			glClientWaitSync(this->frameFences.front(), GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+
+		glDeleteSync(this->frameFences.front());
+		this->frameFences.pop_front();
+	}
+}
+
+void WindowFrame::WaitEvents(double timeout) const
+{
+	glfwWaitEventsTimeout(timeout);
 }
 
 bool WindowFrame::WasRequestedExit() const
@@ -97,6 +178,36 @@ bool WindowFrame::IsVsyncEnabled() const
 	return this->vsyncEnabled;
 }
 
+bool WindowFrame::IsAdaptiveVsyncEnabled() const
+{
+	return this->adaptiveVsyncEnabled;
+}
+
+bool WindowFrame::IsFocused() const
+{
+	return this->focused;
+}
+
+bool WindowFrame::IsIconified() const
+{
+	return this->iconified;
+}
+
+const int& WindowFrame::GetMaxFramesInFlight() const
+{
+	return this->maxFramesInFlight;
+}
+
+const int& WindowFrame::GetFrameQueueDepth() const
+{
+	return this->frameQueueDepth;
+}
+
+double WindowFrame::GetAverageFrameQueueDepth() const
+{
+	return this->numFramesPresented > 0 ? (double)this->totalFrameQueueDepth / this->numFramesPresented : 0.0;
+}
+
 const int& WindowFrame::GetWidth() const
 {
 	return this->width;
@@ -113,7 +224,8 @@ GLFWwindow* WindowFrame::GetFramePtr() const
 }
 
 WindowFramePtr Memory::CreateWindowFrame(const std::string_view& title, int width, int height, bool fullscreen, bool resizable, 
-	bool enableVsync)
+	bool enableVsync, bool enableAdaptiveVsync, int maxFramesInFlight)
 {
-	return std::make_shared<WindowFrame>(title, width, height, fullscreen, resizable, enableVsync);
+	return std::make_shared<WindowFrame>(title, width, height, fullscreen, resizable, enableVsync, enableAdaptiveVsync, 
+		maxFramesInFlight);
 }
@@ -3,17 +3,30 @@
 
 #include <string_view>
 #include <memory>
+#include <deque>
+#include <cstdint>
 
 struct GLFWwindow;
+struct __GLsync;
 
 class WindowFrame
 {
 private:
 	GLFWwindow* framePtr;
 	int width, height;
-	bool fullscreen, resizable, vsyncEnabled;
+	bool fullscreen, resizable, vsyncEnabled, adaptiveVsyncEnabled, focused, iconified;
+
+	int maxFramesInFlight; // If zero, the number of frames queued up by the driver isn't limited
+	std::deque<__GLsync*> frameFences; // The fences of the presented frames which the GPU may not have finished yet, oldest first
+	int frameQueueDepth;
+	uint64_t totalFrameQueueDepth, numFramesPresented;
+private:
+	// Fences the frame just presented, and waits for the older frames to be finished until at most the maximum number of frames 
+	// are in flight. The number of frames still in flight before waiting is recorded as the frame queue depth.
+	void LimitFramesInFlight();
 public:
-	WindowFrame(const std::string_view& title, int width, int height, bool fullscreen, bool resizable, bool enableVsync);
+	WindowFrame(const std::string_view& title, int width, int height, bool fullscreen, bool resizable, bool enableVsync, 
+		bool enableAdaptiveVsync, int maxFramesInFlight);
 	~WindowFrame();
 
 	// Sets the size of the window.
@@ -23,7 +36,12 @@ public:
 	void RequestExit() const;
 
 	// Polls for new pending events from the window, and swaps the rendering buffers.
-	void Refresh() const;
+	// If a maximum number of frames in flight was given, this blocks until the GPU has caught up enough.
+	void Refresh();
+
+	// Puts the calling thread to sleep until an event arrives from the window or the timeout (in seconds) given runs out, then 
+	// processes the pending events. Used instead of refreshing the window while nothing is being rendered.
+	void WaitEvents(double timeout) const;
 
 	// Returns TRUE if the window was requested to be closed, else FALSE is returned.
 	bool WasRequestedExit() const;
@@ -37,6 +55,25 @@ public:
 	// Returns TRUE if the window is in vsync mode, else FALSE is returned.
 	bool IsVsyncEnabled() const;
 
+	// Returns TRUE if the window is in adaptive vsync mode (late frames are presented straight away and tear instead of waiting 
+	// for the next vertical blank), else FALSE is returned.
+	bool IsAdaptiveVsyncEnabled() const;
+
+	// Returns TRUE if the window has input focus, else FALSE is returned.
+	bool IsFocused() const;
+
+	// Returns TRUE if the window is minimised, else FALSE is returned.
+	bool IsIconified() const;
+
+	// Returns the maximum number of frames allowed to be in flight, zero if the number isn't limited.
+	const int& GetMaxFramesInFlight() const;
+
+	// Returns the number of previously presented frames the GPU was still working on when the last frame was presented.
+	const int& GetFrameQueueDepth() const;
+
+	// Returns the average frame queue depth over every frame presented so far.
+	double GetAverageFrameQueueDepth() const;
+
 	// Returns the width of the window.
 	const int& GetWidth() const;
 
@@ -53,7 +90,7 @@ namespace Memory
 {
 	// Returns a shared pointer to the new created window frame.
 	extern WindowFramePtr CreateWindowFrame(const std::string_view& title, int width, int height, bool fullscreen = false, 
-		bool resizable = false, bool enableVsync = false);
+		bool resizable = false, bool enableVsync = false, bool enableAdaptiveVsync = false, int maxFramesInFlight = 0);
 }
 
 #endif
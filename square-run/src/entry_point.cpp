@@ -2,6 +2,6 @@
 
 int main(int argc, char** argv)
 {
-	ApplicationCore gameCore;
+	ApplicationCore gameCore(argc, argv);
 	return 0;
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <graphics/buffer_objects.h>
+#include <graphics/renderer.h>
 #include <util/directory_system.h>
 #include <util/logging_system.h>
 
@@ -258,6 +259,10 @@ TextureBufferPtr Memory::CreateTextureBuffer(uint32_t target, int numSamples, ui
 
 TextureBufferPtr Memory::LoadTextureFromFile(const std::string_view& fileName, bool flipOnLoad)
 {
+	// Textures are never sampled by the null renderer, so there's no need to load anything
+	if (Renderer::GetInstance().IsNullBackend())
+		return nullptr;
+
 	int width = 0, height = 0, channels = 0;
 	uint32_t textureFormat = 0;
 
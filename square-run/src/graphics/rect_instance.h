@@ -0,0 +1,15 @@
+#ifndef RECT_INSTANCE_H
+#define RECT_INSTANCE_H
+
+#include <glm/glm.hpp>
+
+// A rectangle drawn as part of an instanced batch, laid out exactly as the instance attributes are read by the instanced shader.
+// It's kept apart from the renderer so that render data can be baked without pulling in any OpenGL headers.
+struct RectInstance
+{
+	glm::vec2 position, size;
+	float rotationAngle = 0.0f; // In degrees
+	glm::vec4 color = glm::vec4(255); // In the range 0-255, used as the color modifier if the batch is textured
+};
+
+#endif
@@ -0,0 +1,188 @@
+#include <graphics/render_target_pool.h>
+#include <util/logging_system.h>
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <string>
+
+namespace RenderTargetGlobals
+{
+	// The number of frames a free render target is kept around for before it's destroyed
+	constexpr uint64_t maxUnusedFrames = 120;
+
+	// Returns the estimated number of bytes each pixel of the internal format given takes up.
+	size_t GetBytesPerPixel(uint32_t internalFormat)
+	{
+		switch (internalFormat)
+		{
+		case GL_RED:
+		case GL_R8:
+			return 1;
+		case GL_RG:
+		case GL_RG8:
+		case GL_R16F:
+			return 2;
+		case GL_RG16F:
+		case GL_R32F:
+			return 4;
+		case GL_RGBA16F:
+		case GL_RG32F:
+			return 8;
+		case GL_RGBA32F:
+			return 16;
+		default: // Three channel formats are padded to four bytes by the drivers anyway
+			return 4;
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool RenderTargetDesc::operator==(const RenderTargetDesc& other) const
+{
+	return this->width == other.width && this->height == other.height && this->internalFormat == other.internalFormat && 
+		std::max(this->numSamples, 1) == std::max(other.numSamples, 1);
+}
+
+bool RenderTargetDesc::operator!=(const RenderTargetDesc& other) const
+{
+	return !(*this == other);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+PooledRenderTarget::PooledRenderTarget(const RenderTargetDesc& desc) :
+	desc(desc), lastUsedFrame(0)
+{
+	// Allocate the color texture, only multisampled if more than one sample per pixel is requested
+	if (desc.numSamples > 1)
+	{
+		this->texture = Memory::CreateTextureBuffer(GL_TEXTURE_2D_MULTISAMPLE, desc.numSamples, desc.internalFormat, desc.width, 
+			desc.height);
+	}
+	else
+	{
+		this->texture = Memory::CreateTextureBuffer(GL_TEXTURE_2D, 0, desc.internalFormat, desc.width, desc.height, GL_RGBA, 
+			GL_UNSIGNED_BYTE, nullptr);
+
+		this->texture->SetWrapMode(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+	}
+
+	this->fbo = Memory::CreateFrameBuffer();
+	this->fbo->AttachTextureBuffer(GL_COLOR_ATTACHMENT0, this->texture);
+
+	this->memoryUsage = (size_t)desc.width * desc.height * RenderTargetGlobals::GetBytesPerPixel(desc.internalFormat) * 
+		std::max(desc.numSamples, 1);
+}
+
+const RenderTargetDesc& PooledRenderTarget::GetDesc() const
+{
+	return this->desc;
+}
+
+const FrameBufferPtr& PooledRenderTarget::GetFrameBuffer() const
+{
+	return this->fbo;
+}
+
+const TextureBufferPtr& PooledRenderTarget::GetTexture() const
+{
+	return this->texture;
+}
+
+const size_t& PooledRenderTarget::GetMemoryUsage() const
+{
+	return this->memoryUsage;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+RenderTargetPool::RenderTargetPool() :
+	currentFrame(0), totalMemoryUsage(0)
+{}
+
+PooledRenderTargetPtr RenderTargetPool::Acquire(const RenderTargetDesc& desc)
+{
+	if (desc.width <= 0 || desc.height <= 0)
+		LogSystem::GetInstance().OutputLog("Render targets must have a non-zero size", Severity::FATAL);
+
+	// A render target is free when the pool holds the only pointer to it
+	for (const PooledRenderTargetPtr& renderTarget : this->renderTargets)
+	{
+		if (renderTarget.use_count() == 1 && renderTarget->desc == desc)
+		{
+			renderTarget->lastUsedFrame = this->currentFrame;
+			return renderTarget;
+		}
+	}
+
+	// No free render target matches, so allocate a new one
+	PooledRenderTargetPtr renderTarget = std::make_shared<PooledRenderTarget>(desc);
+	renderTarget->lastUsedFrame = this->currentFrame;
+
+	this->renderTargets.emplace_back(renderTarget);
+	this->totalMemoryUsage += renderTarget->memoryUsage;
+
+	LogSystem::GetInstance().OutputLog("Allocated a " + std::to_string(desc.width) + "x" + std::to_string(desc.height) + 
+		" render target, the render target pool now holds " + std::to_string(this->totalMemoryUsage / (1024 * 1024)) + "MB", 
+		Severity::INFO);
+
+	return renderTarget;
+}
+
+void RenderTargetPool::EndFrame()
+{
+	// The render targets still handed out count as being used this frame
+	for (const PooledRenderTargetPtr& renderTarget : this->renderTargets)
+	{
+		if (renderTarget.use_count() > 1)
+			renderTarget->lastUsedFrame = this->currentFrame;
+	}
+
+	this->currentFrame++;
+
+	auto isExpired = [&](const PooledRenderTargetPtr& renderTarget)
+	{
+		return renderTarget.use_count() == 1 && 
+			this->currentFrame - renderTarget->lastUsedFrame > RenderTargetGlobals::maxUnusedFrames;
+	};
+
+	for (const PooledRenderTargetPtr& renderTarget : this->renderTargets)
+	{
+		if (isExpired(renderTarget))
+			this->totalMemoryUsage -= renderTarget->memoryUsage;
+	}
+
+	this->renderTargets.erase(std::remove_if(this->renderTargets.begin(), this->renderTargets.end(), isExpired), 
+		this->renderTargets.end());
+}
+
+void RenderTargetPool::Trim()
+{
+	auto isFree = [](const PooledRenderTargetPtr& renderTarget) { return renderTarget.use_count() == 1; };
+
+	for (const PooledRenderTargetPtr& renderTarget : this->renderTargets)
+	{
+		if (isFree(renderTarget))
+			this->totalMemoryUsage -= renderTarget->memoryUsage;
+	}
+
+	this->renderTargets.erase(std::remove_if(this->renderTargets.begin(), this->renderTargets.end(), isFree),
+		this->renderTargets.end());
+}
+
+size_t RenderTargetPool::GetNumRenderTargets() const
+{
+	return this->renderTargets.size();
+}
+
+const size_t& RenderTargetPool::GetMemoryUsage() const
+{
+	return this->totalMemoryUsage;
+}
+
+RenderTargetPool& RenderTargetPool::GetInstance()
+{
+	static RenderTargetPool instance;
+	return instance;
+}
@@ -0,0 +1,85 @@
+#ifndef RENDER_TARGET_POOL_H
+#define RENDER_TARGET_POOL_H
+
+#include <graphics/buffer_objects.h>
+#include <vector>
+#include <cstdint>
+
+// Describes the size, format and number of samples of a render target, render targets with equal descriptions are interchangeable.
+struct RenderTargetDesc
+{
+	int width = 0, height = 0;
+	uint32_t internalFormat = 0;
+	int numSamples = 0; // If less than two, the render target isn't multisampled
+
+	bool operator==(const RenderTargetDesc& other) const;
+	bool operator!=(const RenderTargetDesc& other) const;
+};
+
+class PooledRenderTarget
+{
+private:
+	RenderTargetDesc desc;
+	FrameBufferPtr fbo;
+	TextureBufferPtr texture;
+	uint64_t lastUsedFrame;
+	size_t memoryUsage;
+
+	friend class RenderTargetPool;
+public:
+	PooledRenderTarget(const RenderTargetDesc& desc);
+	~PooledRenderTarget() = default;
+
+	// Returns the description of the render target.
+	const RenderTargetDesc& GetDesc() const;
+
+	// Returns the framebuffer of the render target.
+	const FrameBufferPtr& GetFrameBuffer() const;
+
+	// Returns the color texture attached to the render target framebuffer.
+	const TextureBufferPtr& GetTexture() const;
+
+	// Returns the estimated amount of video memory used by the render target (in bytes).
+	const size_t& GetMemoryUsage() const;
+};
+
+using PooledRenderTargetPtr = std::shared_ptr<PooledRenderTarget>;
+
+class RenderTargetPool
+{
+private:
+	std::vector<PooledRenderTargetPtr> renderTargets;
+	uint64_t currentFrame;
+	size_t totalMemoryUsage;
+private:
+	RenderTargetPool();
+public:
+	RenderTargetPool(const RenderTargetPool& other) = delete;
+	RenderTargetPool(RenderTargetPool&& temp) noexcept = delete;
+	~RenderTargetPool() = default;
+
+	RenderTargetPool& operator=(const RenderTargetPool& other) = delete;
+	RenderTargetPool& operator=(RenderTargetPool&& temp) noexcept = delete;
+
+	// Returns a render target matching the description given, a free render target in the pool is reused if possible, else a new one 
+	// is allocated. The render target stays out of the pool for as long as a pointer to it is held, so transient render targets 
+	// should only be held onto for the frame they're used in.
+	PooledRenderTargetPtr Acquire(const RenderTargetDesc& desc);
+
+	// Marks the end of the current frame, the free render targets that haven't been used for a while are destroyed.
+	void EndFrame();
+
+	// Destroys every free render target in the pool.
+	void Trim();
+
+	// Returns the number of render targets allocated by the pool, including the ones currently handed out.
+	size_t GetNumRenderTargets() const;
+
+	// Returns the estimated amount of video memory held by the pool (in bytes), including the render targets currently handed out.
+	const size_t& GetMemoryUsage() const;
+
+	// Returns singleton instance object of this class.
+	static RenderTargetPool& GetInstance();
+};
+
+#endif
@@ -1,26 +1,49 @@
 #include <graphics/renderer.h>
+#include <graphics/resource_registry.h>
+#include <core/particle_system.h>
+#include <core/entity_registry.h>
+#include <core/components.h>
 #include <serialization/config.h>
 #include <util/logging_system.h>
 
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstddef>
+
+namespace RenderingGlobals
+{
+	constexpr size_t minInstanceCapacity = 256;
+	constexpr size_t minTextGlyphCapacity = 64;
+}
+
+static_assert(sizeof(RectInstance) == 9 * sizeof(float), "The rectangle instances must be tightly packed for the instanced shader");
 
 Renderer::Renderer() :
-	gammaFactor(0.0)
+	backend(SystemBackend::HARDWARE), instanceCapacity(0), textGlyphCapacity(0), numSamplesMSAA(0), gammaFactor(0.0)
 {}
 
-void Renderer::Init(WindowFramePtr window)
+void Renderer::Init(WindowFramePtr window, SystemBackend backend)
 {
 	this->window = window;
+	this->backend = backend;
+
+	// There is no OpenGL context to setup anything in
+	if (this->IsNullBackend())
+		return;
 
 	// Enable blending mode for rendering partial/fully transparent objects
+	// The alpha is blended separately so that layers rendered into transparent render targets end up with premultiplied colors and 
+	// the correct coverage, which lets them be composited onto the scene later on
 	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Load the renderer shaders
-	this->geometryShader = Memory::CreateShaderProgram("geometry.glsl.vsh", "geometry.glsl.fsh");
-	this->textShader = Memory::CreateShaderProgram("text.glsl.vsh", "text.glsl.fsh");
-	this->postProcessShader = Memory::CreateShaderProgram("post_process.glsl.vsh", "post_process.glsl.fsh");
+	this->geometryShader = ResourceRegistry::GetInstance().LoadShader("geometry.glsl.vsh", "geometry.glsl.fsh");
+	this->textShader = ResourceRegistry::GetInstance().LoadShader("text.glsl.vsh", "text.glsl.fsh");
+	this->postProcessShader = ResourceRegistry::GetInstance().LoadShader("post_process.glsl.vsh", "post_process.glsl.fsh");
+	this->instancedGeometryShader = ResourceRegistry::GetInstance().LoadShader("instanced_geometry.glsl.vsh", 
+		"instanced_geometry.glsl.fsh");
 
 	// Create and setup the rectangle VBO and VAO
 	const std::vector<float> rectVertexData =
@@ -60,19 +83,80 @@ void Renderer::Init(WindowFramePtr window)
 	this->triangleVAO->PushVertexLayout<float>(1, 2, 4 * sizeof(float), 2 * sizeof(float));
 	this->triangleVAO->AttachBuffers(this->triangleVBO);
 
-	// Create and setup the post-processing requisites (the framebuffer, output texture and shader program)
-	const int numSamplesMSAA = std::max(Serialization::GetConfigElement<int>("graphics", "numSamplesMSAA"), 2);
+	// Retrieve the post-processing settings, the scene render target itself is acquired from the render target pool when the scene 
+	// is first rendered to
+	this->numSamplesMSAA = std::max(Serialization::GetConfigElement<int>("graphics", "numSamplesMSAA"), 2);
 
 	this->gammaFactor = Serialization::GetConfigElement<float>("graphics", "gamma");
 	const std::vector<int> resolution = Serialization::GetConfigElement<std::vector<int>>("graphics", "resolution");
 	if (resolution.size() < 2)
 		LogSystem::GetInstance().OutputLog("The json setting 'resolution' is invalid", Severity::FATAL);
 
-	this->postProcessTexture = Memory::CreateTextureBuffer(GL_TEXTURE_2D_MULTISAMPLE, numSamplesMSAA, GL_SRGB,
-		resolution[0], resolution[1]);
-	
-	this->postProcessFBO = Memory::CreateFrameBuffer();
-	this->postProcessFBO->AttachTextureBuffer(GL_COLOR_ATTACHMENT0, this->postProcessTexture);
+	this->SetSceneResolution({ resolution[0], resolution[1] });
+	this->UpdateSceneTarget();
+}
+
+void Renderer::UpdateSceneTarget()
+{
+	const bool followWindow = this->sceneResolution.x <= 0 || this->sceneResolution.y <= 0;
+	RenderTargetDesc sceneDesc;
+	sceneDesc.width = followWindow ? this->window->GetWidth() : this->sceneResolution.x;
+	sceneDesc.height = followWindow ? this->window->GetHeight() : this->sceneResolution.y;
+	sceneDesc.internalFormat = GL_SRGB;
+	sceneDesc.numSamples = this->numSamplesMSAA;
+
+	// The window has no size while minimised, so keep the current scene render target until it's restored
+	if (sceneDesc.width <= 0 || sceneDesc.height <= 0 || (this->sceneTarget && this->sceneTarget->GetDesc() == sceneDesc))
+		return;
+
+	// Hand the old scene render target back before acquiring the new one, so that it can be reused if the resolution changes back
+	this->sceneTarget.reset();
+	this->sceneTarget = RenderTargetPool::GetInstance().Acquire(sceneDesc);
+}
+
+void Renderer::ReserveInstances(size_t numInstances)
+{
+	if (numInstances <= this->instanceCapacity)
+		return;
+
+	// Grow the capacity to the next power of two, so that a batch growing a little every frame doesn't reallocate every frame
+	size_t newCapacity = std::max(this->instanceCapacity, RenderingGlobals::minInstanceCapacity);
+	while (newCapacity < numInstances)
+		newCapacity *= 2;
+
+	this->instanceCapacity = newCapacity;
+	this->instanceVBO = Memory::CreateVertexBuffer(nullptr, (uint32_t)(newCapacity * sizeof(RectInstance)), GL_DYNAMIC_DRAW);
+
+	// The per vertex attributes come from the rectangle VBO, the per instance attributes from the instance VBO
+	this->instancedRectVAO = Memory::CreateVertexArray();
+	this->instancedRectVAO->PushVertexLayout<float>(0, 2, 4 * sizeof(float));
+	this->instancedRectVAO->PushVertexLayout<float>(1, 2, 4 * sizeof(float), 2 * sizeof(float));
+	this->instancedRectVAO->AttachBuffers(this->rectangleVBO);
+
+	this->instancedRectVAO->PushVertexLayout<float>(2, 4, sizeof(RectInstance), offsetof(RectInstance, position), 1);
+	this->instancedRectVAO->PushVertexLayout<float>(3, 1, sizeof(RectInstance), offsetof(RectInstance, rotationAngle), 1);
+	this->instancedRectVAO->PushVertexLayout<float>(4, 4, sizeof(RectInstance), offsetof(RectInstance, color), 1);
+	this->instancedRectVAO->AttachBuffers(this->instanceVBO);
+}
+
+void Renderer::ReserveTextGlyphs(size_t numGlyphs)
+{
+	if (numGlyphs <= this->textGlyphCapacity)
+		return;
+
+	size_t newCapacity = std::max(this->textGlyphCapacity, RenderingGlobals::minTextGlyphCapacity);
+	while (newCapacity < numGlyphs)
+		newCapacity *= 2;
+
+	// Every glyph is a quad made of 4 vertices (2 floats for the position and 2 for the UV coords) and 6 indices
+	this->textGlyphCapacity = newCapacity;
+	this->textVBO = Memory::CreateVertexBuffer(nullptr, (uint32_t)(newCapacity * 16 * sizeof(float)), GL_DYNAMIC_DRAW);
+	this->textIBO = Memory::CreateIndexBuffer(nullptr, (uint32_t)(newCapacity * 6 * sizeof(uint32_t)), GL_DYNAMIC_DRAW);
+
+	this->textVAO = Memory::CreateVertexArray();
+	this->textVAO->PushVertexLayout<float>(0, 2, 4 * sizeof(float));
+	this->textVAO->PushVertexLayout<float>(1, 2, 4 * sizeof(float), 2 * sizeof(float));
+	this->textVAO->AttachBuffers(this->textVBO, this->textIBO);
 }
 
 glm::mat4 Renderer::GenerateModelMatrix(const glm::vec2& pos, const glm::vec2& size, float rotationAngle) const
@@ -85,11 +169,13 @@ glm::mat4 Renderer::GenerateModelMatrix(const glm::vec2& pos, const glm::vec2& s
 	return modelMatrix;
 }
 
-BatchedData Renderer::GenerateBatchedTextData(const FontPtr font, const std::string_view& text) const
+BatchedData Renderer::GenerateBatchedTextData(const Font& font, const std::string_view& text) const
 {
-	std::vector<float> vertexData;
-	std::vector<uint32_t> indexData;
+	LinearArena& frameArena = LinearArena::GetFrameArena();
+	ArenaVector<float> vertexData(frameArena);
+	ArenaVector<uint32_t> indexData(frameArena);
 
+	const float bitmapWidth = (float)font.GetBitmap()->GetWidth(), bitmapHeight = (float)font.GetBitmap()->GetHeight();
 	glm::vec2 originPosition;
 	uint32_t indexingOffset = 0;
 	bool firstCharacter = false;
@@ -101,7 +187,7 @@ BatchedData Renderer::GenerateBatchedTextData(const FontPtr font, const std::str
 	for (const char& character : text)
 	{
 		// Generate the vertex coords
-		const GlyphData& glyph = font->GetGlyphs().at(character);
+		const GlyphData& glyph = font.GetGlyphs().at(character);
 
 		glm::vec2 topLeftVertex;
 		firstCharacter ?
@@ -119,15 +205,15 @@ BatchedData Renderer::GenerateBatchedTextData(const FontPtr font, const std::str
 		glm::vec2 bottomRightUV = { topRightUV.x, glyph.size.y };
 
 		// Normalize the UV coords, they must be within the bounds of -1.0f to 1.0f.
-		topLeftUV.x /= (float)font->GetBitmap()->GetWidth();
-		topRightUV.x /= (float)font->GetBitmap()->GetWidth();
-		bottomLeftUV.x /= (float)font->GetBitmap()->GetWidth();
-		bottomRightUV.x /= (float)font->GetBitmap()->GetWidth();
+		topLeftUV.x /= bitmapWidth;
+		topRightUV.x /= bitmapWidth;
+		bottomLeftUV.x /= bitmapWidth;
+		bottomRightUV.x /= bitmapWidth;
 
-		topLeftUV.y /= (float)font->GetBitmap()->GetHeight();
-		topRightUV.y /= (float)font->GetBitmap()->GetHeight();
-		bottomLeftUV.y /= (float)font->GetBitmap()->GetHeight();
-		bottomRightUV.y /= (float)font->GetBitmap()->GetHeight();
+		topLeftUV.y /= bitmapHeight;
+		topRightUV.y /= bitmapHeight;
+		bottomLeftUV.y /= bitmapHeight;
+		bottomRightUV.y /= bitmapHeight;
 
 		// Push the generated vertex data into the vector array
 		std::array<float, 16> generatedVertexData =
@@ -161,29 +247,53 @@ BatchedData Renderer::GenerateBatchedTextData(const FontPtr font, const std::str
 		indexingOffset += 4;
 	}
 
-	return { vertexData, indexData };
+	return { std::move(vertexData), std::move(indexData) };
 }
 
 void Renderer::SetExternalRenderTarget(FrameBufferPtr fbo)
 {
 	this->externalFBO = fbo;
+	this->externalTarget.reset();
+	this->externalTargetSize = glm::ivec2(0);
 }
 
-void Renderer::SetRenderTarget(RenderTarget target) const
+void Renderer::SetExternalRenderTarget(PooledRenderTargetPtr renderTarget)
 {
+	this->externalFBO = renderTarget ? renderTarget->GetFrameBuffer() : nullptr;
+	this->externalTargetSize = renderTarget ? glm::ivec2(renderTarget->GetDesc().width, renderTarget->GetDesc().height) : 
+		glm::ivec2(0);
+
+	this->externalTarget = std::move(renderTarget);
+}
+
+void Renderer::SetSceneResolution(const glm::ivec2& resolution)
+{
+	this->sceneResolution = resolution;
+}
+
+void Renderer::SetRenderTarget(RenderTarget target)
+{
+	if (this->IsNullBackend())
+		return;
+
 	switch (target)
 	{
 	case RenderTarget::DEFAULT_FRAMEBUFFER:
-		this->postProcessFBO->UnbindBuffer();
+		this->sceneTarget->GetFrameBuffer()->UnbindBuffer();
 		glViewport(0, 0, this->window->GetWidth(), this->window->GetHeight());
 		break;
 	case RenderTarget::SCENE_FRAMEBUFFER:
-		this->postProcessFBO->BindBuffer();
-		glViewport(0, 0, this->postProcessTexture->GetWidth(), this->postProcessTexture->GetHeight());
+		this->UpdateSceneTarget();
+		this->sceneTarget->GetFrameBuffer()->BindBuffer();
+		glViewport(0, 0, this->sceneTarget->GetDesc().width, this->sceneTarget->GetDesc().height);
 		break;
 	case RenderTarget::EXTERNAL_FRAMEBUFFER:
 		if (this->externalFBO)
+		{
 			this->externalFBO->BindBuffer();
+			if (this->externalTargetSize.x > 0 && this->externalTargetSize.y > 0)
+				glViewport(0, 0, this->externalTargetSize.x, this->externalTargetSize.y);
+		}
 		break;
 	}
 }
@@ -195,25 +305,66 @@ void Renderer::SetClearColor(const glm::vec4& color)
 
 void Renderer::Clear() const
 {
+	if (this->IsNullBackend())
+		return;
+
 	glClearColor(this->clearColor.r, this->clearColor.g, this->clearColor.b, this->clearColor.a);
 	glClear(GL_COLOR_BUFFER_BIT);
 }
 
+void Renderer::Clear(const glm::vec4& color) const
+{
+	if (this->IsNullBackend())
+		return;
+
+	glClearColor(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void Renderer::SetClipRegion(const OrthogonalCamera& sceneCamera, const glm::vec2& pos, const glm::vec2& size)
+{
+	if (this->IsNullBackend())
+		return;
+
+	if (size.x <= 0.0f || size.y <= 0.0f)
+	{
+		glDisable(GL_SCISSOR_TEST);
+		return;
+	}
+
+	// Map the region from the camera's coordinates onto the pixels of the viewport, the scissor box's origin is the bottom left 
+	// corner of the viewport while the camera's is the top left corner
+	int viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	const glm::vec2 pixelScale = glm::vec2(viewport[2], viewport[3]) / sceneCamera.GetSize();
+	const glm::vec2 minPixel = glm::floor((pos - sceneCamera.GetPosition()) * pixelScale);
+	const glm::vec2 maxPixel = glm::ceil((pos + size - sceneCamera.GetPosition()) * pixelScale);
+
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(viewport[0] + (int)minPixel.x, viewport[1] + viewport[3] - (int)maxPixel.y, (int)(maxPixel.x - minPixel.x), 
+		(int)(maxPixel.y - minPixel.y));
+}
+
 void Renderer::RenderRect(const OrthogonalCamera& sceneCamera, const glm::vec4& color, const glm::vec2& pos, 
 	const glm::vec2& size, float rotationAngle) const
 {
+	if (this->IsNullBackend())
+		return;
+
 	// Bind the shader and the rectangle vao
-	this->geometryShader->BindProgram();
+	const ShaderProgram& geometryShader = ResourceRegistry::GetInstance().GetShaders().Get(this->geometryShader);
+	geometryShader.BindProgram();
 	this->rectangleVAO->BindObject();
 
 	// Generate the model matrix
 	const glm::mat4 modelMatrix = this->GenerateModelMatrix(pos, size, rotationAngle);
 
 	// Assign required shader uniform values
-	this->geometryShader->SetUniform("material.useTexture", false);
-	this->geometryShader->SetUniformGLM("material.color", color / 255.0f);
-	this->geometryShader->SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
-	this->geometryShader->SetUniformGLM("modelMatrix", modelMatrix);
+	geometryShader.SetUniform("material.useTexture", false);
+	geometryShader.SetUniformGLM("material.color", color / 255.0f);
+	geometryShader.SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
+	geometryShader.SetUniformGLM("modelMatrix", modelMatrix);
 
 	// Render the rectangle
 	glDrawArrays(GL_TRIANGLES, 0, 6);
@@ -222,136 +373,280 @@ void Renderer::RenderRect(const OrthogonalCamera& sceneCamera, const glm::vec4&
 void Renderer::RenderTriangle(const OrthogonalCamera& sceneCamera, const glm::vec4& color, const glm::vec2& pos, 
 	const glm::vec2& size, float rotationAngle) const
 {
+	if (this->IsNullBackend())
+		return;
+
 	// Bind the shader and the triangle vao
-	this->geometryShader->BindProgram();
+	const ShaderProgram& geometryShader = ResourceRegistry::GetInstance().GetShaders().Get(this->geometryShader);
+	geometryShader.BindProgram();
 	this->triangleVAO->BindObject();
 
 	// Generate the model matrix
 	const glm::mat4 modelMatrix = this->GenerateModelMatrix(pos, size, rotationAngle);
 
 	// Assign required shader uniform values
-	this->geometryShader->SetUniform("material.useTexture", false);
-	this->geometryShader->SetUniformGLM("material.color", color / 255.0f);
-	this->geometryShader->SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
-	this->geometryShader->SetUniformGLM("modelMatrix", modelMatrix);
+	geometryShader.SetUniform("material.useTexture", false);
+	geometryShader.SetUniformGLM("material.color", color / 255.0f);
+	geometryShader.SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
+	geometryShader.SetUniformGLM("modelMatrix", modelMatrix);
 
 	// Render the triangle
 	glDrawArrays(GL_TRIANGLES, 0, 3);
 }
 
-void Renderer::RenderTexturedRect(const OrthogonalCamera& sceneCamera, const TextureBufferPtr texture, const glm::vec2& pos,
+void Renderer::RenderTexturedRect(const OrthogonalCamera& sceneCamera, TextureHandle texture, const glm::vec2& pos,
 	const glm::vec2& size, float rotationAngle, const glm::vec4& colorMod) const
 {
+	if (this->IsNullBackend())
+		return;
+
 	// Bind the shader, rectangle's VAO and texture
-	this->geometryShader->BindProgram();
+	const ShaderProgram& geometryShader = ResourceRegistry::GetInstance().GetShaders().Get(this->geometryShader);
+	geometryShader.BindProgram();
 	this->rectangleVAO->BindObject();
-	texture->BindBuffer(0);
+	ResourceRegistry::GetInstance().GetTextures().Get(texture).BindBuffer(0);
 
 	// Generate the model matrix
 	const glm::mat4 modelMatrix = this->GenerateModelMatrix(pos, size, rotationAngle);
 
 	// Assign required shader uniform values
-	this->geometryShader->SetUniform("material.texture", 0);
-	this->geometryShader->SetUniform("material.useTexture", true);
-	this->geometryShader->SetUniformGLM("material.color", colorMod / 255.0f);
-	this->geometryShader->SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
-	this->geometryShader->SetUniformGLM("modelMatrix", modelMatrix);
+	geometryShader.SetUniform("material.texture", 0);
+	geometryShader.SetUniform("material.useTexture", true);
+	geometryShader.SetUniformGLM("material.color", colorMod / 255.0f);
+	geometryShader.SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
+	geometryShader.SetUniformGLM("modelMatrix", modelMatrix);
 
 	// Render the textured rectangle
 	glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
-void Renderer::RenderTexturedTriangle(const OrthogonalCamera& sceneCamera, const TextureBufferPtr texture, const glm::vec2& pos, 
+void Renderer::RenderTexturedTriangle(const OrthogonalCamera& sceneCamera, TextureHandle texture, const glm::vec2& pos, 
 	const glm::vec2& size, float rotationAngle, const glm::vec4& colorMod) const
 {
+	if (this->IsNullBackend())
+		return;
+
 	// Bind the shader, triangle's VAO and texture
-	this->geometryShader->BindProgram();
+	const ShaderProgram& geometryShader = ResourceRegistry::GetInstance().GetShaders().Get(this->geometryShader);
+	geometryShader.BindProgram();
 	this->triangleVAO->BindObject();
-	texture->BindBuffer(0);
+	ResourceRegistry::GetInstance().GetTextures().Get(texture).BindBuffer(0);
 
 	// Generate the model matrix
 	const glm::mat4 modelMatrix = this->GenerateModelMatrix(pos, size, rotationAngle);
 
 	// Assign required shader uniform values
-	this->geometryShader->SetUniform("material.texture", 0);
-	this->geometryShader->SetUniform("material.useTexture", true);
-	this->geometryShader->SetUniformGLM("material.color", colorMod / 255.0f);
-	this->geometryShader->SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
-	this->geometryShader->SetUniformGLM("modelMatrix", modelMatrix);
+	geometryShader.SetUniform("material.texture", 0);
+	geometryShader.SetUniform("material.useTexture", true);
+	geometryShader.SetUniformGLM("material.color", colorMod / 255.0f);
+	geometryShader.SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
+	geometryShader.SetUniformGLM("modelMatrix", modelMatrix);
 
 	// Render the textured triangle
 	glDrawArrays(GL_TRIANGLES, 0, 3);
 }
 
-void Renderer::RenderText(const OrthogonalCamera& sceneCamera, const FontPtr font, uint32_t fontSize, const std::string_view& text, 
-	const glm::vec4& color, const glm::vec2& pos, float rotationAngle) const
+void Renderer::RenderRectInstances(const OrthogonalCamera& sceneCamera, const RectInstance* instances, size_t numInstances, 
+	TextureHandle texture)
 {
-	// Generate the text's batched vertex and index data
-	const BatchedData renderData = this->GenerateBatchedTextData(font, text);
+	if (this->IsNullBackend() || numInstances == 0)
+		return;
+
+	// Upload the instances
+	this->ReserveInstances(numInstances);
+	this->instanceVBO->UpdateBuffer(instances, (uint32_t)(numInstances * sizeof(RectInstance)), 0);
+
+	// Bind the shader, instanced rectangle VAO and texture (if given)
+	const ShaderProgram& instancedGeometryShader = ResourceRegistry::GetInstance().GetShaders().Get(this->instancedGeometryShader);
+	instancedGeometryShader.BindProgram();
+	this->instancedRectVAO->BindObject();
+	if (texture.IsValid())
+		ResourceRegistry::GetInstance().GetTextures().Get(texture).BindBuffer(0);
+
+	// Assign required shader uniform values
+	instancedGeometryShader.SetUniform("instanceTexture", 0);
+	instancedGeometryShader.SetUniform("useTexture", texture.IsValid());
+	instancedGeometryShader.SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
+
+	// Render every rectangle instance
+	glDrawArraysInstanced(GL_TRIANGLES, 0, 6, (GLsizei)numInstances);
+}
+
+void Renderer::RenderParticles(const OrthogonalCamera& sceneCamera, const ParticleEmitter& emitter, TextureHandle texture)
+{
+	if (this->IsNullBackend() || emitter.GetNumParticles() == 0)
+		return;
+
+	const float* positionX = emitter.GetChannel(ParticleChannel::POSITION_X);
+	const float* positionY = emitter.GetChannel(ParticleChannel::POSITION_Y);
+	const float* size = emitter.GetChannel(ParticleChannel::SIZE);
+	const float* red = emitter.GetChannel(ParticleChannel::RED), *green = emitter.GetChannel(ParticleChannel::GREEN);
+	const float* blue = emitter.GetChannel(ParticleChannel::BLUE), *alpha = emitter.GetChannel(ParticleChannel::ALPHA);
+
+	// Interleave the particle arrays into the instance layout, the buffer is kept so it only allocates as the particle count grows
+	this->particleInstances.resize(emitter.GetNumParticles());
+	for (size_t index = 0; index < this->particleInstances.size(); index++)
+	{
+		RectInstance& instance = this->particleInstances[index];
+		instance.position = { positionX[index], positionY[index] };
+		instance.size = glm::vec2(size[index]);
+		instance.rotationAngle = 0.0f;
+		instance.color = { red[index], green[index], blue[index], std::max(alpha[index], 0.0f) };
+	}
+
+	this->RenderRectInstances(sceneCamera, this->particleInstances.data(), this->particleInstances.size(), texture);
+}
 
-	// Create and setup the text VBO, IBO and VAO
-	VertexBufferPtr textVertexBuffer = Memory::CreateVertexBuffer(renderData.first.data(), 
-		(uint32_t)renderData.first.size() * sizeof(float), GL_STATIC_DRAW);
+void Renderer::RenderRectEntities(const OrthogonalCamera& sceneCamera, const EntityRegistry& registry)
+{
+	const ComponentPool<RectRenderComponent>* renderPool = registry.FindPool<RectRenderComponent>();
+	const ComponentPool<TransformComponent>* transformPool = registry.FindPool<TransformComponent>();
+	if (this->IsNullBackend() || !renderPool || !transformPool)
+		return;
+
+	// The render components are stored contiguously, so they're walked in order and their transforms looked up.
+	// The buffer is kept so it only allocates as the entity count grows.
+	const std::vector<uint32_t>& entities = renderPool->GetEntities();
+	const std::vector<RectRenderComponent>& renderComponents = renderPool->GetComponents();
+	this->entityInstances.clear();
+
+	for (size_t componentIndex = 0; componentIndex < renderComponents.size(); componentIndex++)
+	{
+		if (!transformPool->Has(entities[componentIndex]))
+			continue;
 
-	IndexBufferPtr textIndexBuffer = Memory::CreateIndexBuffer(renderData.second.data(), 
-		(uint32_t)renderData.second.size() * sizeof(float), GL_STATIC_DRAW);
+		const TransformComponent& transform = transformPool->Get(entities[componentIndex]);
+		const RectRenderComponent& renderComponent = renderComponents[componentIndex];
+		this->entityInstances.push_back({ transform.position, transform.size, transform.rotationAngle, renderComponent.color });
+	}
 
-	VertexArrayPtr textVertexArray = Memory::CreateVertexArray();
-	textVertexArray->PushVertexLayout<float>(0, 2, 4 * sizeof(float));
-	textVertexArray->PushVertexLayout<float>(1, 2, 4 * sizeof(float), 2 * sizeof(float));
-	textVertexArray->AttachBuffers(textVertexBuffer, textIndexBuffer);
+	this->RenderRectInstances(sceneCamera, this->entityInstances.data(), this->entityInstances.size());
+}
+
+void Renderer::RenderLayer(const OrthogonalCamera& sceneCamera, const PooledRenderTarget& layer, const glm::vec2& pos, 
+	const glm::vec2& size) const
+{
+	if (this->IsNullBackend())
+		return;
+
+	// Bind the shader, rectangle's VAO and the layer texture
+	const ShaderProgram& geometryShader = ResourceRegistry::GetInstance().GetShaders().Get(this->geometryShader);
+	geometryShader.BindProgram();
+	this->rectangleVAO->BindObject();
+	layer.GetTexture()->BindBuffer(0);
+
+	// The layer was rendered with its top row at the top of the render target, unlike loaded textures which are flipped on load, 
+	// so the rectangle is flipped vertically to match
+	const glm::mat4 modelMatrix = this->GenerateModelMatrix(pos, { size.x, -size.y }, 0.0f);
+
+	// Assign required shader uniform values
+	geometryShader.SetUniform("material.texture", 0);
+	geometryShader.SetUniform("material.useTexture", true);
+	geometryShader.SetUniformGLM("material.color", glm::vec4(1.0f));
+	geometryShader.SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
+	geometryShader.SetUniformGLM("modelMatrix", modelMatrix);
+
+	// Render the layer, its colors are already multiplied by their alpha
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void Renderer::RenderText(const OrthogonalCamera& sceneCamera, FontHandle fontHandle, uint32_t fontSize, const std::string_view& text, 
+	const glm::vec4& color, const glm::vec2& pos, float rotationAngle)
+{
+	if (this->IsNullBackend() || text.empty())
+		return;
+
+	// Generate the text's batched vertex and index data
+	const Font& font = ResourceRegistry::GetInstance().GetFonts().Get(fontHandle);
+	const BatchedData renderData = this->GenerateBatchedTextData(font, text);
+
+	// Upload the text into the text VBO and IBO, which are reused by every text rendered
+	// The VAO is unbound first, as updating the IBO while a VAO is bound would detach the IBO bound to that VAO
+	this->ReserveTextGlyphs(text.size());
+	this->textVAO->UnbindObject();
+	this->textVBO->UpdateBuffer(renderData.first.data(), (uint32_t)(renderData.first.size() * sizeof(float)), 0);
+	this->textIBO->UpdateBuffer(renderData.second.data(), (uint32_t)(renderData.second.size() * sizeof(uint32_t)), 0);
 
 	// Bind the shader, text's VAO and font bitmap texture
-	this->textShader->BindProgram();
-	textVertexArray->BindObject();
-	font->GetBitmap()->BindBuffer(0);
+	const ShaderProgram& textShader = ResourceRegistry::GetInstance().GetShaders().Get(this->textShader);
+	textShader.BindProgram();
+	this->textVAO->BindObject();
+	font.GetBitmap()->BindBuffer(0);
 
 	// Generate the model matrix
-	const glm::mat4 modelMatrix = this->GenerateModelMatrix(pos, glm::vec2((float)fontSize / (float)font->GetResolution()),
+	const glm::mat4 modelMatrix = this->GenerateModelMatrix(pos, glm::vec2((float)fontSize / (float)font.GetResolution()),
 		rotationAngle);
 
 	// Assign required shader uniform values
-	this->textShader->SetUniform("fontBitmapTexture", 0);
-	this->textShader->SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
-	this->textShader->SetUniformGLM("modelMatrix", modelMatrix);
-	this->textShader->SetUniformGLM("textColor", color / 255.0f);
+	textShader.SetUniform("fontBitmapTexture", 0);
+	textShader.SetUniformGLM("cameraMatrix", sceneCamera.GetMatrix());
+	textShader.SetUniformGLM("modelMatrix", modelMatrix);
+	textShader.SetUniformGLM("textColor", color / 255.0f);
 
 	// Render the text
 	glDrawElements(GL_TRIANGLES, (uint32_t)renderData.second.size(), GL_UNSIGNED_INT, nullptr);
 }
 
-void Renderer::FlushRenderedScene() const
+void Renderer::FlushRenderedScene()
 {
+	if (this->IsNullBackend())
+		return;
+
 	// Bind the default framebuffer and clear it
 	this->SetRenderTarget(RenderTarget::DEFAULT_FRAMEBUFFER);
 	Renderer::GetInstance().Clear();
 
 	// Bind the post-process shader, texture and rectangle VAO
-	this->postProcessShader->BindProgram();
-	this->postProcessTexture->BindBuffer(0);
+	const ShaderProgram& postProcessShader = ResourceRegistry::GetInstance().GetShaders().Get(this->postProcessShader);
+	postProcessShader.BindProgram();
+	const TextureBufferPtr& sceneTexture = this->sceneTarget->GetTexture();
+	sceneTexture->BindBuffer(0);
 	this->rectangleVAO->BindObject();
 
 	// Assign required shader uniform values
-	this->postProcessShader->SetUniform("renderedTexture", 0);
-	this->postProcessShader->SetUniform("gammaFactor", this->gammaFactor);
-	this->postProcessShader->SetUniform("numSamples", this->postProcessTexture->GetNumSamples());
+	postProcessShader.SetUniform("renderedTexture", 0);
+	postProcessShader.SetUniform("gammaFactor", this->gammaFactor);
+	postProcessShader.SetUniform("numSamples", sceneTexture->GetNumSamples());
 
-	this->postProcessShader->SetUniformGLM("framebufferSize", { this->postProcessTexture->GetWidth(),
-		this->postProcessTexture->GetHeight() });
+	postProcessShader.SetUniformGLM("framebufferSize", { sceneTexture->GetWidth(), sceneTexture->GetHeight() });
 
 	// Render the processed texture
 	glDrawArrays(GL_TRIANGLES, 0, 6);
+
+	// Every transient render target used this frame should have been handed back by now
+	RenderTargetPool::GetInstance().EndFrame();
+}
+
+PooledRenderTargetPtr Renderer::AcquireLayerTarget(const glm::ivec2& size) const
+{
+	if (this->IsNullBackend())
+		return nullptr;
+
+	RenderTargetDesc layerDesc;
+	layerDesc.width = size.x;
+	layerDesc.height = size.y;
+	layerDesc.internalFormat = GL_RGBA8;
+
+	return RenderTargetPool::GetInstance().Acquire(layerDesc);
+}
+
+bool Renderer::IsNullBackend() const
+{
+	return this->backend == SystemBackend::NULL_DEVICE;
 }
 
-glm::vec2 Renderer::GetTextSize(const FontPtr font, uint32_t fontSize, const std::string_view& text) const
+glm::vec2 Renderer::GetTextSize(FontHandle fontHandle, uint32_t fontSize, const std::string_view& text) const
 {
+	const Font& font = ResourceRegistry::GetInstance().GetFonts().Get(fontHandle);
 	glm::vec2 totalSize;
 	float minY = 0.0f, maxY = 0.0f;
 	bool firstCharacter = true;
 
 	for (uint32_t i = 0; i < text.size(); i++)
 	{
-		const GlyphData& glyphMetrics = font->GetGlyphs().at(text[i]);
+		const GlyphData& glyphMetrics = font.GetGlyphs().at(text[i]);
 
 		// WIDTH
 		if (firstCharacter)
@@ -374,7 +669,7 @@ glm::vec2 Renderer::GetTextSize(const FontPtr font, uint32_t fontSize, const std
 	}
 
 	totalSize.y = maxY - minY;
-	totalSize *= glm::vec2(static_cast<float>(fontSize) / static_cast<float>(font->GetResolution()));
+	totalSize *= glm::vec2(static_cast<float>(fontSize) / static_cast<float>(font.GetResolution()));
 
 	return totalSize;
 }
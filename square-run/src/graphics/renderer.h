@@ -2,15 +2,23 @@
 #define RENDERER_H
 
 #include <core/window_frame.h>
+#include <core/system_backend.h>
 #include <graphics/shader_program.h>
 #include <graphics/vertex_array.h>
 #include <graphics/orthogonal_camera.h>
 #include <graphics/ttf_font_loader.h>
+#include <graphics/render_target_pool.h>
+#include <graphics/rect_instance.h>
+#include <graphics/resource_registry.h>
+#include <util/linear_allocator.h>
 
 #include <glm/glm.hpp>
 #include <vector>
 
-using BatchedData = std::pair<std::vector<float>, std::vector<uint32_t>>;
+class ParticleEmitter;
+class EntityRegistry;
+
+using BatchedData = std::pair<ArenaVector<float>, ArenaVector<uint32_t>>;
 
 namespace RenderingGlobals
 {
@@ -29,12 +37,21 @@ class Renderer
 {
 private:
 	WindowFramePtr window;
-	ShaderProgramPtr geometryShader, textShader, postProcessShader;
-	VertexBufferPtr rectangleVBO, triangleVBO;
-	VertexArrayPtr rectangleVAO, triangleVAO;
-
-	FrameBufferPtr postProcessFBO, externalFBO;
-	TextureBufferPtr postProcessTexture;
+	SystemBackend backend;
+	ShaderHandle geometryShader, textShader, postProcessShader, instancedGeometryShader;
+	VertexBufferPtr rectangleVBO, triangleVBO, instanceVBO, textVBO;
+	IndexBufferPtr textIBO;
+	VertexArrayPtr rectangleVAO, triangleVAO, instancedRectVAO, textVAO;
+	size_t instanceCapacity, textGlyphCapacity;
+	std::vector<RectInstance> particleInstances, entityInstances;
+
+	PooledRenderTargetPtr sceneTarget;
+	glm::ivec2 sceneResolution; // If zero, the scene is rendered at the window resolution
+	int numSamplesMSAA;
+
+	FrameBufferPtr externalFBO;
+	PooledRenderTargetPtr externalTarget; // Held while set, so the pool doesn't hand the render target out or free it while it's bound
+	glm::ivec2 externalTargetSize; // If zero, the viewport is left untouched when binding the external render target
 	float gammaFactor;
 
 	glm::vec4 clearColor;
@@ -45,7 +62,18 @@ private:
 	// Returns a pair of vectors, one containing vertex data and the other containing index data.
 	// The vertex and index data inside the vectors are the result of all the glyphs in the text given having their
 	// vertex and index data all batched into their respective vector containers.
-	BatchedData GenerateBatchedTextData(const FontPtr font, const std::string_view& text) const;
+	// The vectors are allocated from the frame arena, so they must not be kept past the end of the frame.
+	BatchedData GenerateBatchedTextData(const Font& font, const std::string_view& text) const;
+
+	// Acquires a new scene render target from the render target pool if the scene resolution (or the window resolution, if the scene 
+	// follows it) no longer matches the current scene render target.
+	void UpdateSceneTarget();
+
+	// Reallocates the instance buffer (and the VAO reading from it) if it can't hold the number of instances given.
+	void ReserveInstances(size_t numInstances);
+
+	// Reallocates the text vertex and index buffers (and the VAO reading from them) if they can't hold the number of glyphs given.
+	void ReserveTextGlyphs(size_t numGlyphs);
 private:
 	Renderer();
 public:
@@ -57,14 +85,23 @@ public:
 	Renderer& operator=(Renderer&& temp) = delete;
 
 	// Initializes the graphics renderer.
-	void Init(WindowFramePtr window);
+	// When the null device backend is selected, no window or OpenGL context is needed and every render call does nothing.
+	void Init(WindowFramePtr window, SystemBackend backend = SystemBackend::HARDWARE);
 
 	// Sets the external render target (aka framebuffer).
 	// This allows for framebuffers, defined outside the renderer, to be rendered to by the renderer.
 	void SetExternalRenderTarget(FrameBufferPtr fbo);
 
+	// Sets the external render target to the pooled render target given, the viewport is sized to it when bound.
+	// The render target is kept in use until another external render target is set.
+	void SetExternalRenderTarget(PooledRenderTargetPtr renderTarget);
+
+	// Sets the resolution the scene is rendered at, if zero then the scene is rendered at the window resolution.
+	// The scene render target is only reallocated once the scene is next rendered to.
+	void SetSceneResolution(const glm::ivec2& resolution);
+
 	// Sets the current render target (aka framebuffer), consequent render calls will only modify the contents of this render target.
-	void SetRenderTarget(RenderTarget target) const;
+	void SetRenderTarget(RenderTarget target);
 
 	// Sets the color that the screen is cleared with.
 	void SetClearColor(const glm::vec4& color);
@@ -72,6 +109,13 @@ public:
 	// Clears the screen and fills the screen with the stored clear color.
 	void Clear() const;
 
+	// Clears the screen and fills the screen with the color given.
+	void Clear(const glm::vec4& color) const;
+
+	// Restricts rendering (and clearing) to the region of the current render target covered by the rectangle given, the rectangle is
+	// positioned by its top left corner in the coordinates of the camera given. Pass a zero size to lift the restriction.
+	void SetClipRegion(const OrthogonalCamera& sceneCamera, const glm::vec2& pos, const glm::vec2& size);
+
 	// Renders a colored rectangle of specified size to the position specified on the screen.
 	void RenderRect(const OrthogonalCamera& sceneCamera, const glm::vec4& color, const glm::vec2& pos,
 		const glm::vec2& size, float rotationAngle = 0.0f) const;
@@ -81,22 +125,46 @@ public:
 		const glm::vec2& size, float rotationAngle = 0.0f) const;
 
 	// Renders a textured rectangle of specified size to the position specified on the screen.
-	void RenderTexturedRect(const OrthogonalCamera& sceneCamera, const TextureBufferPtr texture,
+	void RenderTexturedRect(const OrthogonalCamera& sceneCamera, TextureHandle texture,
 		const glm::vec2& pos, const glm::vec2& size, float rotationAngle = 0.0f, const glm::vec4& colorMod = glm::vec4(255)) const;
 
 	// Renders a textured triangle of specified size to the position specified on the screen. 
-	void RenderTexturedTriangle(const OrthogonalCamera& sceneCamera, const TextureBufferPtr texture,
+	void RenderTexturedTriangle(const OrthogonalCamera& sceneCamera, TextureHandle texture,
 		const glm::vec2& pos, const glm::vec2& size, float rotationAngle = 0.0f, const glm::vec4& colorMod = glm::vec4(255)) const;
 
+	// Renders every rectangle instance given with a single draw call, textured with the texture given (if any).
+	// This is far cheaper than rendering the rectangles one by one, as the uniforms and buffers are only set up once.
+	void RenderRectInstances(const OrthogonalCamera& sceneCamera, const RectInstance* instances, size_t numInstances, 
+		TextureHandle texture = TextureHandle());
+
+	// Renders every alive particle of the emitter given as a textured rectangle instance, with a single draw call.
+	void RenderParticles(const OrthogonalCamera& sceneCamera, const ParticleEmitter& emitter, TextureHandle texture);
+
+	// Renders every entity of the registry given with a rectangle render component and a transform, with a single draw call.
+	void RenderRectEntities(const OrthogonalCamera& sceneCamera, const EntityRegistry& registry);
+
+	// Renders the texture of the layer given as a rectangle of specified size to the position specified on the screen.
+	// The layer is expected to have been rendered to by the renderer, so its colors are blended in as premultiplied by their alpha.
+	void RenderLayer(const OrthogonalCamera& sceneCamera, const PooledRenderTarget& layer, const glm::vec2& pos, 
+		const glm::vec2& size) const;
+
 	// Renders a colored text of specified size to the position specified on the screen.
-	void RenderText(const OrthogonalCamera& sceneCamera, const FontPtr font, uint32_t fontSize,
-		const std::string_view& text, const glm::vec4& color, const glm::vec2& pos, float rotationAngle = 0.0f) const;
+	void RenderText(const OrthogonalCamera& sceneCamera, FontHandle font, uint32_t fontSize,
+		const std::string_view& text, const glm::vec4& color, const glm::vec2& pos, float rotationAngle = 0.0f);
 
 	// Renders and displays the final rendered and post-processed scene.
-	void FlushRenderedScene() const;
+	// This also marks the end of the frame for the render target pool.
+	void FlushRenderedScene();
+
+	// Returns a render target with an alpha channel, of the size given, for a layer of the scene to be cached in.
+	// Note that nullptr is returned when the null device backend is selected.
+	PooledRenderTargetPtr AcquireLayerTarget(const glm::ivec2& size) const;
+
+	// Returns TRUE if the renderer is backed by the null device (i.e. nothing is rendered), else FALSE is returned.
+	bool IsNullBackend() const;
 
 	// Returns the size of the given text string when rendered.
-	glm::vec2 GetTextSize(const FontPtr font, uint32_t fontSize, const std::string_view& text) const;
+	glm::vec2 GetTextSize(FontHandle font, uint32_t fontSize, const std::string_view& text) const;
 
 	// Returns singleton instance object of this class.
 	static Renderer& GetInstance();
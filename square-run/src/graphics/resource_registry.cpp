@@ -0,0 +1,64 @@
+#include <graphics/resource_registry.h>
+
+ResourceRegistry::ResourceRegistry() :
+	textures("texture"), fonts("font"), shaders("shader program")
+{}
+
+TextureHandle ResourceRegistry::LoadTexture(const std::string_view& fileName, bool flipOnLoad)
+{
+	return this->textures.Add(Memory::LoadTextureFromFile(fileName, flipOnLoad));
+}
+
+FontHandle ResourceRegistry::LoadFont(const std::string_view& fileName)
+{
+	return this->fonts.Add(Memory::LoadFontFromFile(fileName));
+}
+
+ShaderHandle ResourceRegistry::LoadShader(const std::string_view& vertexFileName, const std::string_view& fragmentFileName,
+	const std::string_view& geometryFileName)
+{
+	return this->shaders.Add(Memory::CreateShaderProgram(vertexFileName, fragmentFileName, geometryFileName));
+}
+
+void ResourceRegistry::Clear()
+{
+	this->textures.Clear();
+	this->fonts.Clear();
+	this->shaders.Clear();
+}
+
+ResourcePool<TextureBuffer>& ResourceRegistry::GetTextures()
+{
+	return this->textures;
+}
+
+const ResourcePool<TextureBuffer>& ResourceRegistry::GetTextures() const
+{
+	return this->textures;
+}
+
+ResourcePool<Font>& ResourceRegistry::GetFonts()
+{
+	return this->fonts;
+}
+
+const ResourcePool<Font>& ResourceRegistry::GetFonts() const
+{
+	return this->fonts;
+}
+
+ResourcePool<ShaderProgram>& ResourceRegistry::GetShaders()
+{
+	return this->shaders;
+}
+
+const ResourcePool<ShaderProgram>& ResourceRegistry::GetShaders() const
+{
+	return this->shaders;
+}
+
+ResourceRegistry& ResourceRegistry::GetInstance()
+{
+	static ResourceRegistry instance;
+	return instance;
+}
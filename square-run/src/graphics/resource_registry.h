@@ -0,0 +1,138 @@
+#ifndef RESOURCE_REGISTRY_H
+#define RESOURCE_REGISTRY_H
+
+#include <graphics/buffer_objects.h>
+#include <graphics/shader_program.h>
+#include <graphics/ttf_font_loader.h>
+
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace ResourceGlobals
+{
+	constexpr uint32_t indexBits = 20; // Leaves 12 bits for the generation
+	constexpr uint32_t indexMask = (1u << indexBits) - 1;
+	constexpr uint32_t maxGeneration = UINT32_MAX >> indexBits;
+}
+
+// Identifies a resource in a resource pool, the low bits are the index of its slot and the high bits the generation of the slot when
+// the resource was added. The generation of a slot is bumped every time its resource is destroyed, so a handle to a destroyed
+// resource goes stale rather than pointing at whatever resource reuses the slot. The generation starts at 1, so a zero handle is never
+// valid.
+template<typename Ty> struct ResourceHandle
+{
+	uint32_t value = 0;
+
+	// Returns TRUE if the handle was given out by a resource pool (it may have gone stale since), else FALSE is returned.
+	bool IsValid() const;
+
+	// Returns the index of the slot the handle points to.
+	uint32_t GetIndex() const;
+
+	// Returns the generation of the slot when the handle was given out.
+	uint32_t GetGeneration() const;
+
+	bool operator==(const ResourceHandle& other) const;
+	bool operator!=(const ResourceHandle& other) const;
+};
+
+using TextureHandle = ResourceHandle<TextureBuffer>;
+using FontHandle = ResourceHandle<Font>;
+using ShaderHandle = ResourceHandle<ShaderProgram>;
+
+// Owns the resources of a single type, stored in slots indexed by their handles. Looking up a resource is an index into a dense array
+// of pointers, so passing handles around and resolving them never touches a reference count.
+// The resources stay alive until they're destroyed through the pool, or the pool is cleared.
+template<typename Ty> class ResourcePool
+{
+private:
+	std::vector<Ty*> resources; // Null for the free slots
+	std::vector<uint32_t> generations;
+	std::vector<std::shared_ptr<Ty>> owners;
+	std::vector<uint32_t> freeSlots;
+	std::string_view typeName;
+public:
+	ResourcePool(const std::string_view& typeName);
+	~ResourcePool() = default;
+
+	ResourcePool(const ResourcePool& other) = delete;
+	ResourcePool& operator=(const ResourcePool& other) = delete;
+
+	// Takes ownership of the resource given.
+	// Returns the handle of the resource, or an invalid handle if the resource given is null.
+	ResourceHandle<Ty> Add(std::shared_ptr<Ty> resource);
+
+	// Destroys the resource of the handle given (if it's still alive) and resets the handle.
+	void Destroy(ResourceHandle<Ty>& handle);
+
+	// Destroys every resource in the pool, every handle given out so far goes stale.
+	void Clear();
+
+	// Returns the resource of the handle given.
+	// Note that in debug builds a stale or invalid handle is a fatal error, while in release builds the handle isn't checked at all.
+	Ty& Get(ResourceHandle<Ty> handle) const;
+
+	// Returns the resource of the handle given, or nullptr if the handle is stale or invalid.
+	Ty* TryGet(ResourceHandle<Ty> handle) const;
+
+	// Returns TRUE if the resource of the handle given hasn't been destroyed, else FALSE is returned.
+	bool IsAlive(ResourceHandle<Ty> handle) const;
+
+	// Returns the number of resources alive in the pool.
+	size_t GetNumResources() const;
+};
+
+// The pools of the resources passed into render calls, so that the render calls can take handles rather than shared pointers.
+class ResourceRegistry
+{
+private:
+	ResourcePool<TextureBuffer> textures;
+	ResourcePool<Font> fonts;
+	ResourcePool<ShaderProgram> shaders;
+private:
+	ResourceRegistry();
+public:
+	ResourceRegistry(const ResourceRegistry& other) = delete;
+	ResourceRegistry(ResourceRegistry&& temp) noexcept = delete;
+	~ResourceRegistry() = default;
+
+	ResourceRegistry& operator=(const ResourceRegistry& other) = delete;
+	ResourceRegistry& operator=(ResourceRegistry&& temp) noexcept = delete;
+
+	// Loads the texture from the specified image file into the texture pool.
+	// Returns the handle of the loaded texture.
+	TextureHandle LoadTexture(const std::string_view& fileName, bool flipOnLoad = true);
+
+	// Loads the font from the specified true type font file into the font pool.
+	// Returns the handle of the loaded font.
+	FontHandle LoadFont(const std::string_view& fileName);
+
+	// Creates the shader program from the specified shader files in the shader pool.
+	// Returns the handle of the created shader program.
+	ShaderHandle LoadShader(const std::string_view& vertexFileName, const std::string_view& fragmentFileName,
+		const std::string_view& geometryFileName = "");
+
+	// Destroys every resource in every pool.
+	void Clear();
+
+	// Returns the pool of textures.
+	ResourcePool<TextureBuffer>& GetTextures();
+	const ResourcePool<TextureBuffer>& GetTextures() const;
+
+	// Returns the pool of fonts.
+	ResourcePool<Font>& GetFonts();
+	const ResourcePool<Font>& GetFonts() const;
+
+	// Returns the pool of shader programs.
+	ResourcePool<ShaderProgram>& GetShaders();
+	const ResourcePool<ShaderProgram>& GetShaders() const;
+
+	// Returns singleton instance object of this class.
+	static ResourceRegistry& GetInstance();
+};
+
+#include <graphics/resource_registry.inl>
+
+#endif
@@ -0,0 +1,129 @@
+#include <graphics/resource_registry.h>
+#include <util/logging_system.h>
+
+#include <string>
+
+template<typename Ty> bool ResourceHandle<Ty>::IsValid() const
+{
+	return this->value != 0;
+}
+
+template<typename Ty> uint32_t ResourceHandle<Ty>::GetIndex() const
+{
+	return this->value & ResourceGlobals::indexMask;
+}
+
+template<typename Ty> uint32_t ResourceHandle<Ty>::GetGeneration() const
+{
+	return this->value >> ResourceGlobals::indexBits;
+}
+
+template<typename Ty> bool ResourceHandle<Ty>::operator==(const ResourceHandle& other) const
+{
+	return this->value == other.value;
+}
+
+template<typename Ty> bool ResourceHandle<Ty>::operator!=(const ResourceHandle& other) const
+{
+	return this->value != other.value;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename Ty> ResourcePool<Ty>::ResourcePool(const std::string_view& typeName) :
+	typeName(typeName)
+{}
+
+template<typename Ty> ResourceHandle<Ty> ResourcePool<Ty>::Add(std::shared_ptr<Ty> resource)
+{
+	if (!resource)
+		return ResourceHandle<Ty>();
+
+	// Reuse a free slot if there is one, else add a new slot
+	uint32_t slotIndex = 0;
+	if (!this->freeSlots.empty())
+	{
+		slotIndex = this->freeSlots.back();
+		this->freeSlots.pop_back();
+	}
+	else
+	{
+		if (this->resources.size() > ResourceGlobals::indexMask)
+		{
+			LogSystem::GetInstance().OutputLog("Too many " + std::string(this->typeName) + " resources have been created",
+				Severity::FATAL);
+		}
+
+		slotIndex = (uint32_t)this->resources.size();
+		this->resources.push_back(nullptr);
+		this->generations.push_back(1);
+		this->owners.emplace_back();
+	}
+
+	this->resources[slotIndex] = resource.get();
+	this->owners[slotIndex] = std::move(resource);
+
+	ResourceHandle<Ty> handle;
+	handle.value = (this->generations[slotIndex] << ResourceGlobals::indexBits) | slotIndex;
+	return handle;
+}
+
+template<typename Ty> void ResourcePool<Ty>::Destroy(ResourceHandle<Ty>& handle)
+{
+	if (this->IsAlive(handle))
+	{
+		const uint32_t slotIndex = handle.GetIndex();
+		this->resources[slotIndex] = nullptr;
+		this->owners[slotIndex].reset();
+
+		// Bump the generation so the handles to the destroyed resource go stale, skipping zero once it wraps around
+		uint32_t& generation = this->generations[slotIndex];
+		generation = generation == ResourceGlobals::maxGeneration ? 1 : generation + 1;
+		this->freeSlots.push_back(slotIndex);
+	}
+
+	handle = ResourceHandle<Ty>();
+}
+
+template<typename Ty> void ResourcePool<Ty>::Clear()
+{
+	for (uint32_t slotIndex = 0; slotIndex < (uint32_t)this->resources.size(); slotIndex++)
+	{
+		if (this->resources[slotIndex])
+		{
+			ResourceHandle<Ty> handle;
+			handle.value = (this->generations[slotIndex] << ResourceGlobals::indexBits) | slotIndex;
+			this->Destroy(handle);
+		}
+	}
+}
+
+template<typename Ty> Ty& ResourcePool<Ty>::Get(ResourceHandle<Ty> handle) const
+{
+#ifdef _DEBUG
+	if (!this->IsAlive(handle))
+	{
+		LogSystem::GetInstance().OutputLog("A stale or invalid " + std::string(this->typeName) + " handle was used (index " +
+			std::to_string(handle.GetIndex()) + ", generation " + std::to_string(handle.GetGeneration()) + ")", Severity::FATAL);
+	}
+#endif
+
+	return *this->resources[handle.GetIndex()];
+}
+
+template<typename Ty> Ty* ResourcePool<Ty>::TryGet(ResourceHandle<Ty> handle) const
+{
+	return this->IsAlive(handle) ? this->resources[handle.GetIndex()] : nullptr;
+}
+
+template<typename Ty> bool ResourcePool<Ty>::IsAlive(ResourceHandle<Ty> handle) const
+{
+	const uint32_t slotIndex = handle.GetIndex();
+	return handle.IsValid() && slotIndex < this->resources.size() && this->resources[slotIndex] &&
+		this->generations[slotIndex] == handle.GetGeneration();
+}
+
+template<typename Ty> size_t ResourcePool<Ty>::GetNumResources() const
+{
+	return this->resources.size() - this->freeSlots.size();
+}
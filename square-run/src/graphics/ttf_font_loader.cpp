@@ -1,4 +1,5 @@
 #include <graphics/ttf_font_loader.h>
+#include <graphics/renderer.h>
 #include <serialization/config.h>
 #include <util/logging_system.h>
 #include <util/directory_system.h>
@@ -51,6 +52,14 @@ Font::Font(const std::string_view& fileName, uint32_t resolution) :
 			totalBitmapHeight = (uint32_t)glyphMetrics.size.y;
 	}
 
+	// Only the glyph metrics are needed by the null renderer (to calculate text sizes), so skip generating the bitmap texture
+	if (Renderer::GetInstance().IsNullBackend())
+	{
+		FT_Done_Face(fontFace);
+		FT_Done_FreeType(freeTypeLib);
+		return;
+	}
+
 	// Allocate an empty texture buffer consisting of enough space to store all glypth bitmaps
 	this->bitmapTexture = Memory::CreateTextureBuffer(GL_TEXTURE_2D, 0, GL_RED, totalBitmapWidth, totalBitmapHeight, GL_RED, 
 		GL_UNSIGNED_BYTE, nullptr, true);
@@ -83,7 +92,7 @@ const GlyphMap& Font::GetGlyphs() const
 	return this->glyphs;
 }
 
-const TextureBufferPtr Font::GetBitmap() const
+const TextureBufferPtr& Font::GetBitmap() const
 {
 	return this->bitmapTexture;
 }
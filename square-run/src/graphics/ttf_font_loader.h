@@ -36,7 +36,7 @@ public:
 	const GlyphMap& GetGlyphs() const;
 
 	// Returns the generated bitmap texture loaded from the font file.
-	const TextureBufferPtr GetBitmap() const;
+	const TextureBufferPtr& GetBitmap() const;
 
 	// Returns the resolution of the the loaded glyphs in the font bitmap texture.
 	const uint32_t& GetResolution() const;
@@ -1,38 +1,53 @@
 #include <interface/button.h>
+#include <interface/user_interface.h>
 #include <graphics/renderer.h>
-#include <core/input_system.h>
+
+#include <cmath>
 
 namespace ButtonGlobal
 {
-	static FontPtr font = nullptr;
+	static FontHandle font;
 }
 
 Button::Button(const OrthogonalCamera& camera, const std::string_view& text, const glm::vec4& textColor, const uint32_t& fontSize, 
 	const glm::vec2& pos, const glm::vec2& size, const glm::vec4& buttonColor, HoverReactionType type, const glm::vec4& shadowColor, 
 	float shadowThickness, float opacity) :
-	viewportCamera(&camera), position(pos), baseSize(size), currentSize(size), buttonColor(buttonColor), shadowColor(shadowColor), 
+	viewportCamera(&camera), owner(nullptr), position(pos), baseSize(size), currentSize(size), buttonColor(buttonColor), shadowColor(shadowColor), 
 	shadowThickness(shadowThickness), hoverType(type), text(text), fontSize(fontSize), textColor(textColor), borderColor({ 0, 0, 0, 255 }),
-	opacity(opacity), clicked(false), outOfFocus(false)
+	opacity(opacity), hovered(false), pressed(false), textVersion(0), renderedToLayer(false)
 {
 	// Load the font for the button if it hasn't been loaded yet
-	if (!ButtonGlobal::font)
+	if (!ButtonGlobal::font.IsValid())
 	{
-		ButtonGlobal::font = Memory::LoadFontFromFile("fff_forwa.ttf");
+		ButtonGlobal::font = ResourceRegistry::GetInstance().LoadFont("fff_forwa.ttf");
 	}
 
 	// Calculate the size of the text to be rendered on the button
 	this->textSize = Renderer::GetInstance().GetTextSize(ButtonGlobal::font, fontSize, text);
 }
 
+Button::~Button()
+{
+	// The tweens animate the button's size and border color, so they can't outlive it
+	TweenSystem::GetInstance().Kill(this->sizeTween);
+	TweenSystem::GetInstance().Kill(this->borderTween);
+}
+
 void Button::SetPosition(const glm::vec2 & pos)
 {
 	this->position = pos;
+	if (this->owner)
+		this->owner->MarkLayoutChanged();
 }
 
 void Button::SetSize(const glm::vec2& size)
 {
+	TweenSystem::GetInstance().Kill(this->sizeTween);
 	this->baseSize = size;
 	this->currentSize = size;
+
+	if (this->owner)
+		this->owner->MarkLayoutChanged();
 }
 
 void Button::SetOpacity(float opacity)
@@ -40,85 +55,66 @@ void Button::SetOpacity(float opacity)
 	this->opacity = opacity;
 }
 
+void Button::SetText(const std::string_view& text)
+{
+	this->text = text;
+	this->textSize = Renderer::GetInstance().GetTextSize(ButtonGlobal::font, this->fontSize, text);
+	this->textVersion++;
+}
+
 void Button::SetClickEventCallback(std::function<void()> callbackFunc)
 {
 	this->onClickEventFunction = callbackFunc;
 }
 
-void Button::Update(const double& deltaTime)
+void Button::OnCursorEnter()
+{
+	this->hovered = true;
+	this->AnimateHover();
+}
+
+void Button::OnCursorLeave()
+{
+	this->hovered = false;
+	this->AnimateHover();
+}
+
+void Button::OnPress()
+{
+	this->pressed = true;
+}
+
+void Button::OnRelease(bool cursorOnButton)
+{
+	this->pressed = false;
+	if (cursorOnButton && this->onClickEventFunction)
+		this->onClickEventFunction();
+}
+
+void Button::AnimateHover()
 {
-	// Check if the cursor is currently hovering over the button
-	const glm::vec2 cursorPos = InputSystem::GetInstance().GetCursorPosition(this->viewportCamera);
 	constexpr float hoverAnimationSpeed = 500.0f;
 
-	// Check if i.e the user has stopped interacting with something else
-	if (!InputSystem::GetInstance().WasMouseButtonPressed(MouseCode::MOUSE_BUTTON_LEFT) && this->outOfFocus)
+	if (this->hoverType == HoverReactionType::HIGHLIGHT_ENLARGE_ALL_ROUND)
 	{
-		this->outOfFocus = false;
-	}
+		const glm::vec2 targetSize = this->GetTargetSize();
+		const float targetBorderColor = this->hovered ? 255.0f : 0.0f;
 
-	if (cursorPos.x >= this->position.x - (this->currentSize.x / 2.0f) && cursorPos.x <= this->position.x + (this->currentSize.x / 2.0f) &&
-		cursorPos.y >= this->position.y - (this->currentSize.y / 2.0f) && cursorPos.y <= this->position.y + (this->currentSize.y / 2.0f))
-	{
-		// Handle button hover animation
-		if (this->hoverType == HoverReactionType::HIGHLIGHT_ENLARGE_ALL_ROUND)
-		{
-			// Animate button size
-			this->currentSize.x = std::min(this->currentSize.x + (hoverAnimationSpeed * (float)deltaTime), this->baseSize.x + 50.0f);
-			this->currentSize.y = std::min(this->currentSize.y + (hoverAnimationSpeed * (float)deltaTime), this->baseSize.y + 50.0f);
-
-			// Animate border color change
-			this->borderColor.g = std::min(this->borderColor.g + ((hoverAnimationSpeed * 2.0f) * (float)deltaTime), 255.0f);
-			this->borderColor.b = std::min(this->borderColor.b + ((hoverAnimationSpeed * 2.0f) * (float)deltaTime), 255.0f);
-		}
-		else if (this->hoverType == HoverReactionType::HIGHLIGHT_ENLARGE_TO_THE_RIGHT)
-		{
-			// TO BE IMPLEMENTED SOON
-		}
-
-		// Check if the cursor clicked on the button
-		if (InputSystem::GetInstance().WasMouseButtonPressed(MouseCode::MOUSE_BUTTON_LEFT) && this->onClickEventFunction && !this->outOfFocus)
-		{
-			this->clicked = true;
-		}
-	}
-	else
-	{
-		// Handle button un-hover animation
-		if (this->hoverType == HoverReactionType::HIGHLIGHT_ENLARGE_ALL_ROUND)
-		{
-			// Animate button size
-			this->currentSize.x = std::max(this->currentSize.x - (hoverAnimationSpeed * (float)deltaTime), this->baseSize.x);
-			this->currentSize.y = std::max(this->currentSize.y - (hoverAnimationSpeed * (float)deltaTime), this->baseSize.y);
-
-			// Animate border color change
-			this->borderColor.g = std::max(this->borderColor.g - ((hoverAnimationSpeed * 2.0f) * (float)deltaTime), 0.0f);
-			this->borderColor.b = std::max(this->borderColor.b - ((hoverAnimationSpeed * 2.0f) * (float)deltaTime), 0.0f);
-		}
-		else if (this->hoverType == HoverReactionType::HIGHLIGHT_ENLARGE_TO_THE_RIGHT)
-		{
-			// TO BE IMPLEMENTED SOON
-		}
-
-		// Check if this button is not in focus (i.e the user is interacting with something else)
-		if (InputSystem::GetInstance().WasMouseButtonPressed(MouseCode::MOUSE_BUTTON_LEFT) && !this->clicked)
-		{
-			this->outOfFocus = true;
-		}
-	}
+		// The durations are scaled by the distance left, so reversing an animation halfway through keeps the same speed
+		const float sizeDuration = std::abs(targetSize.x - this->currentSize.x) / hoverAnimationSpeed;
+		const float borderDuration = std::abs(targetBorderColor - this->borderColor.g) / (hoverAnimationSpeed * 2.0f);
 
-	// Run the on-click event callback function after the left mouse button has been released after clicking the button
-	if (!InputSystem::GetInstance().WasMouseButtonPressed(MouseCode::MOUSE_BUTTON_LEFT) && this->clicked)
+		TweenSystem::GetInstance().Kill(this->sizeTween);
+		TweenSystem::GetInstance().Kill(this->borderTween);
+
+		this->sizeTween = TweenSystem::GetInstance().To(&this->currentSize, targetSize, sizeDuration);
+		this->borderTween = TweenSystem::GetInstance().Play(TweenSequence()
+			.Append(&this->borderColor.g, targetBorderColor, borderDuration)
+			.Join(&this->borderColor.b, targetBorderColor, borderDuration));
+	}
+	else if (this->hoverType == HoverReactionType::HIGHLIGHT_ENLARGE_TO_THE_RIGHT)
 	{
-		if (cursorPos.x >= this->position.x - (this->currentSize.x / 2.0f) && cursorPos.x <= this->position.x + (this->currentSize.x / 2.0f) &&
-			cursorPos.y >= this->position.y - (this->currentSize.y / 2.0f) && cursorPos.y <= this->position.y + (this->currentSize.y / 2.0f))
-		{
-			this->onClickEventFunction(); // Run the on-click event callback function
-		}
-		else
-		{
-			this->clicked = false;
-		}
+		// TO BE IMPLEMENTED SOON
 	}
 }
 
@@ -139,6 +135,53 @@ void Button::Render() const
 		(this->textColor * 255.0f) / 255.0f, { this->position.x - (this->textSize.x / 2.0f), this->position.y + (this->textSize.y / 2.0f) });
 }
 
+glm::vec2 Button::GetTargetSize() const
+{
+	if (this->hovered && this->hoverType == HoverReactionType::HIGHLIGHT_ENLARGE_ALL_ROUND)
+		return this->baseSize + 50.0f;
+
+	return this->baseSize;
+}
+
+glm::vec4 Button::GetHitBounds() const
+{
+	const glm::vec2 halfSize = this->GetTargetSize() / 2.0f;
+	return { this->position - halfSize, this->position + halfSize };
+}
+
+ButtonVisuals Button::GetVisuals() const
+{
+	ButtonVisuals visuals;
+	visuals.position = this->position;
+	visuals.size = this->currentSize;
+	visuals.textColor = this->textColor;
+	visuals.buttonColor = this->buttonColor;
+	visuals.shadowColor = this->shadowColor;
+	visuals.borderColor = this->borderColor;
+	visuals.shadowThickness = this->shadowThickness;
+	visuals.opacity = this->opacity;
+	visuals.textVersion = this->textVersion;
+
+	return visuals;
+}
+
+glm::vec4 Button::GetBounds() const
+{
+	// The body is centered on the button position and the shadow is offset from it, the text is centered on the button position 
+	// too but may stick out of the body if it's wider than it
+	const glm::vec2 halfSize = this->currentSize / 2.0f;
+	const glm::vec2 shadowOffset = glm::vec2(this->shadowThickness * 2.0f);
+	const glm::vec2 halfTextSize = this->textSize / 2.0f;
+
+	const glm::vec2 minPoint = glm::min(glm::min(this->position - halfSize, this->position - halfSize + shadowOffset), 
+		this->position - halfTextSize);
+	const glm::vec2 maxPoint = glm::max(glm::max(this->position + halfSize, this->position + halfSize + shadowOffset), 
+		this->position + halfTextSize);
+
+	// Pad the bounds by a pixel, so the edges of the button are always covered after rounding
+	return { minPoint - 1.0f, maxPoint + 1.0f };
+}
+
 const glm::vec2& Button::GetPosition() const
 {
 	return this->position;
@@ -153,3 +196,20 @@ const float& Button::GetOpacity() const
 {
 	return this->opacity;
 }
+
+bool Button::IsFocused() const
+{
+	return this->pressed;
+}
+
+bool ButtonVisuals::operator==(const ButtonVisuals& other) const
+{
+	return this->position == other.position && this->size == other.size && this->textColor == other.textColor && 
+		this->buttonColor == other.buttonColor && this->shadowColor == other.shadowColor && this->borderColor == other.borderColor && 
+		this->shadowThickness == other.shadowThickness && this->opacity == other.opacity && this->textVersion == other.textVersion;
+}
+
+bool ButtonVisuals::operator!=(const ButtonVisuals& other) const
+{
+	return !(*this == other);
+}
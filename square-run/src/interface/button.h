@@ -1,12 +1,14 @@
 #ifndef BUTTON_H
 #define BUTTON_H
 
+#include <core/tween_system.h>
 #include <glm/glm.hpp>
 #include <functional>
 #include <string_view>
 #include <string>
 
 class OrthogonalCamera;
+class UserInterface;
 
 enum class HoverReactionType
 {
@@ -14,11 +16,25 @@ enum class HoverReactionType
 	HIGHLIGHT_ENLARGE_TO_THE_RIGHT
 };
 
+// The look of a button, the look a button was last rendered with is kept so that a retained user interface can tell when the button
+// needs redrawing (including while it's being animated by a tween).
+struct ButtonVisuals
+{
+	glm::vec2 position, size;
+	glm::vec4 textColor, buttonColor, shadowColor, borderColor;
+	float shadowThickness = 0.0f, opacity = 0.0f;
+	uint32_t textVersion = 0;
+
+	bool operator==(const ButtonVisuals& other) const;
+	bool operator!=(const ButtonVisuals& other) const;
+};
+
 class Button
 {
 	friend class UserInterface;
 private:
 	const OrthogonalCamera* viewportCamera;
+	UserInterface* owner; // Notified when the button's hit bounds change
 
 	std::string text;
 	glm::vec2 position, baseSize, currentSize, textSize;
@@ -28,19 +44,62 @@ private:
 
 	HoverReactionType hoverType;
 	std::function<void()> onClickEventFunction;
-	bool clicked, outOfFocus;
+	TweenHandle sizeTween, borderTween;
+	bool hovered, pressed;
+
+	// Retained rendering
+	uint32_t textVersion; // Bumped every time the text changes, so the text doesn't have to be compared
+	ButtonVisuals renderedVisuals;
+	glm::vec4 renderedBounds;
+	bool renderedToLayer;
 private:
 	Button(const OrthogonalCamera& viewportCamera, const std::string_view& text, const glm::vec4& textColor, const uint32_t& fontSize,
 		const glm::vec2& pos, const glm::vec2& size, const glm::vec4& buttonColor, HoverReactionType type,
 		const glm::vec4& shadowColor = { 0, 0, 0, 100 }, float shadowThickness = 7.5f, float opacity = 255.0f);
 
-	// Polls button events and updates button graphics accordingly.
-	void Update(const double& deltaTime);
+	// Called by the user interface when the cursor moves onto the button, starts the hover animation.
+	void OnCursorEnter();
+
+	// Called by the user interface when the cursor moves off the button, reverses the hover animation.
+	void OnCursorLeave();
+
+	// Called by the user interface when the left mouse button is pressed down on the button.
+	void OnPress();
+
+	// Called by the user interface when the left mouse button is released after being pressed down on the button.
+	// The click event callback function is called if the cursor is still on the button.
+	void OnRelease(bool cursorOnButton);
+
+	// Starts animating the button towards its hovered (or unhovered) look, from wherever the previous animation left it.
+	void AnimateHover();
 
 	// Renders the button.
 	void Render() const;
+
+	// Returns the size the button is (or is being animated towards) for its current hover state.
+	glm::vec2 GetTargetSize() const;
+
+	// Returns the rectangle the cursor has to be within to hover over the button, as its minimum x, minimum y, maximum x and 
+	// maximum y in the viewport camera's coordinates. The hovered size is used while hovered, so the button doesn't flicker between
+	// hovered and unhovered as it grows.
+	glm::vec4 GetHitBounds() const;
+
+	// Returns the current look of the button.
+	ButtonVisuals GetVisuals() const;
+
+	// Returns the rectangle covering everything rendered for the button (its shadow, body and text), as its minimum x, minimum y,
+	// maximum x and maximum y in the viewport camera's coordinates.
+	glm::vec4 GetBounds() const;
 public:
-	~Button() = default;
+	~Button();
+
+	// The tweens of a button animate its own members, so a copy can't share them. Moving a button leaves its tweens with the button
+	// moved from, which kills them when it's destroyed.
+	Button(const Button& other) = delete;
+	Button(Button&& temp) noexcept = default;
+
+	Button& operator=(const Button& other) = delete;
+	Button& operator=(Button&& temp) noexcept = delete;
 
 	// Sets the position of the button.
 	void SetPosition(const glm::vec2& pos);
@@ -51,6 +110,9 @@ public:
 	// Sets the opacity of the button.
 	void SetOpacity(float opacity);
 
+	// Sets the text shown on the button.
+	void SetText(const std::string_view& text);
+
 	// Sets the function called when the button is clicked.
 	void SetClickEventCallback(std::function<void()> callbackFunc);
 
@@ -63,7 +125,7 @@ public:
 	// Returns the opacity of the button.
 	const float& GetOpacity() const;
 
-	// Returns whether the user is interacting with the button (i.e in focus)
+	// Returns whether the user is interacting with the button (i.e in focus), which is while it's being pressed down.
 	bool IsFocused() const;
 };
 
@@ -1,11 +1,30 @@
 #include <interface/user_interface.h>
+#include <graphics/renderer.h>
+#include <core/input_system.h>
+
+#include <cmath>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 UserInterface::UserInterface(const OrthogonalCamera& camera) :
-	viewportCamera(&camera)
+	viewportCamera(&camera), hitGridOrigin(0.0f), hoveredButton(nullptr), pressedButton(nullptr), layoutChanged(true), retained(false)
 {}
 
+void UserInterface::MarkLayoutChanged()
+{
+	this->layoutChanged = true;
+}
+
+void UserInterface::SetRetainedMode(bool enable)
+{
+	this->retained = enable;
+	this->dirtyRegions.clear();
+
+	// The layer is handed back to the pool when leaving retained mode, it's redrawn from scratch once retained mode is entered again
+	if (!enable)
+		this->layer.reset();
+}
+
 void UserInterface::AddButtonElement(const std::string_view& id, const std::string_view& text, const glm::vec4& textColor, 
 	const uint32_t& fontSize, const glm::vec2& pos, const glm::vec2& size, const glm::vec4& buttonColor, HoverReactionType type, 
 	const glm::vec4& shadowColor, float shadowThickness, float opacity)
@@ -20,27 +39,264 @@ void UserInterface::AddButtonElement(const std::string_view& id, const std::stri
 		}
 	}
 
-	this->buttonElements.push_back({ id.data(), 
-		std::move(Button(*this->viewportCamera, text, textColor, fontSize, pos, size, buttonColor, type, shadowColor, shadowThickness, 
-			opacity)) });
+	// The element is constructed in place from the ID and the button, so the button (and its text) is moved rather than copied
+	// Note that the ID is copied from its length, as the string view given doesn't have to be null terminated
+	this->buttonElements.emplace_back(std::string(id), Button(*this->viewportCamera, text, textColor, fontSize, pos, size, 
+		buttonColor, type, shadowColor, shadowThickness, opacity));
+
+	this->buttonElements.back().second.owner = this;
+	this->layoutChanged = true;
 }
 
 void UserInterface::UpdateInterface(const double& deltaTime)
 {
-	for (auto& button : this->buttonElements)
+	const InputSystem& input = InputSystem::GetInstance();
+	const bool leftPressed = input.WasMouseButtonJustPressed(MouseCode::MOUSE_BUTTON_LEFT);
+	const bool leftReleased = input.WasMouseButtonJustReleased(MouseCode::MOUSE_BUTTON_LEFT);
+
+	// The elements are placed relative to the viewport camera, so they move under the cursor along with the camera
+	if (this->viewportCamera->GetPosition() != this->hitGridOrigin)
+		this->layoutChanged = true;
+
+	// Whatever is under the cursor can only change if the cursor or the elements have moved
+	if (!input.HasCursorMoved() && !leftPressed && !leftReleased && !this->layoutChanged)
+		return;
+
+	if (this->layoutChanged)
 	{
-		button.second.Update(deltaTime);
+		this->RebuildHitGrid();
+		this->layoutChanged = false;
+	}
+
+	Button* cursorButton = this->FindButtonAt(input.GetCursorPosition(this->viewportCamera));
+	if (cursorButton != this->hoveredButton)
+	{
+		if (this->hoveredButton)
+			this->hoveredButton->OnCursorLeave();
+
+		if (cursorButton)
+			cursorButton->OnCursorEnter();
+
+		// The hit bounds of the buttons change with their hover state
+		this->hoveredButton = cursorButton;
+		this->layoutChanged = true;
+	}
+
+	// A button is only clicked if the left mouse button is both pressed and released on it
+	if (leftPressed)
+	{
+		this->pressedButton = cursorButton;
+		if (cursorButton)
+			cursorButton->OnPress();
+	}
+
+	if (leftReleased && this->pressedButton)
+	{
+		Button* releasedButton = this->pressedButton;
+		this->pressedButton = nullptr;
+		releasedButton->OnRelease(releasedButton == cursorButton);
 	}
 }
 
-void UserInterface::RenderInterface() const
+void UserInterface::RebuildHitGrid()
 {
+	constexpr uint32_t numCells = InterfaceGlobals::hitGridSize * InterfaceGlobals::hitGridSize;
+	const glm::vec2 cellScale = glm::vec2((float)InterfaceGlobals::hitGridSize) / this->viewportCamera->GetSize();
+	this->hitGridOrigin = this->viewportCamera->GetPosition();
+
+	// Returns the range of cells (clamped to the grid) overlapped by the bounds given, as min x, min y, max x and max y
+	auto getCellRange = [this, &cellScale](const glm::vec4& bounds)
+	{
+		const auto toCell = [](float coord) 
+			{ return (uint32_t)glm::clamp((int)std::floor(coord), 0, (int)InterfaceGlobals::hitGridSize - 1); };
+
+		return glm::uvec4(toCell((bounds.x - this->hitGridOrigin.x) * cellScale.x), toCell((bounds.y - this->hitGridOrigin.y) * 
+			cellScale.y), toCell((bounds.z - this->hitGridOrigin.x) * cellScale.x), toCell((bounds.w - this->hitGridOrigin.y) * 
+			cellScale.y));
+	};
+
+	// Count the elements overlapping each cell, then turn the counts into the starting offset of each cell
+	this->hitCellStarts.assign(numCells + 1, 0);
 	for (const auto& button : this->buttonElements)
 	{
-		button.second.Render();
+		const glm::uvec4 cellRange = getCellRange(button.second.GetHitBounds());
+		for (uint32_t cellY = cellRange.y; cellY <= cellRange.w; cellY++)
+		{
+			for (uint32_t cellX = cellRange.x; cellX <= cellRange.z; cellX++)
+				this->hitCellStarts[(cellY * InterfaceGlobals::hitGridSize) + cellX + 1]++;
+		}
+	}
+
+	for (uint32_t cellIndex = 0; cellIndex < numCells; cellIndex++)
+		this->hitCellStarts[cellIndex + 1] += this->hitCellStarts[cellIndex];
+
+	// Fill in the elements of each cell, in the order they're rendered in
+	this->hitCellElements.resize(this->hitCellStarts[numCells]);
+	this->hitCellFill.assign(this->hitCellStarts.begin(), this->hitCellStarts.end() - 1);
+
+	for (uint32_t elementIndex = 0; elementIndex < (uint32_t)this->buttonElements.size(); elementIndex++)
+	{
+		const glm::uvec4 cellRange = getCellRange(this->buttonElements[elementIndex].second.GetHitBounds());
+		for (uint32_t cellY = cellRange.y; cellY <= cellRange.w; cellY++)
+		{
+			for (uint32_t cellX = cellRange.x; cellX <= cellRange.z; cellX++)
+				this->hitCellElements[this->hitCellFill[(cellY * InterfaceGlobals::hitGridSize) + cellX]++] = elementIndex;
+		}
 	}
 }
 
+Button* UserInterface::FindButtonAt(const glm::vec2& position)
+{
+	const glm::vec2 viewportSize = this->viewportCamera->GetSize();
+	if (this->hitCellStarts.empty() || position.x < 0.0f || position.y < 0.0f || position.x >= viewportSize.x || 
+		position.y >= viewportSize.y)
+	{
+		return nullptr;
+	}
+
+	const glm::vec2 cellPosition = position * (glm::vec2((float)InterfaceGlobals::hitGridSize) / viewportSize);
+	const uint32_t cellIndex = ((uint32_t)cellPosition.y * InterfaceGlobals::hitGridSize) + (uint32_t)cellPosition.x;
+
+	// The elements are rendered through the view of the viewport camera, so test their bounds against the position it views
+	const glm::vec2 viewedPosition = position + this->hitGridOrigin;
+
+	// The elements of a cell are in render order, so search from the back to find the topmost element first
+	for (uint32_t elementOffset = this->hitCellStarts[cellIndex + 1]; elementOffset > this->hitCellStarts[cellIndex]; elementOffset--)
+	{
+		Button& button = this->buttonElements[this->hitCellElements[elementOffset - 1]].second;
+		const glm::vec4 bounds = button.GetHitBounds();
+
+		if (viewedPosition.x >= bounds.x && viewedPosition.x <= bounds.z && viewedPosition.y >= bounds.y && 
+			viewedPosition.y <= bounds.w)
+		{
+			return &button;
+		}
+	}
+
+	return nullptr;
+}
+
+void UserInterface::ResetInteraction()
+{
+	if (this->hoveredButton)
+		this->hoveredButton->OnCursorLeave();
+
+	if (this->pressedButton)
+		this->pressedButton->pressed = false;
+
+	this->hoveredButton = nullptr;
+	this->pressedButton = nullptr;
+	this->layoutChanged = true;
+}
+
+void UserInterface::RenderInterface()
+{
+	const glm::vec2& cameraPosition = this->viewportCamera->GetPosition();
+	const glm::vec2& cameraSize = this->viewportCamera->GetSize();
+
+	// Acquire a layer covering the viewport camera (again if the camera has been resized), every element is redrawn into a new layer
+	if (this->retained && (!this->layer || this->layer->GetDesc().width != (int)cameraSize.x || 
+		this->layer->GetDesc().height != (int)cameraSize.y))
+	{
+		this->layer.reset();
+		this->layer = Renderer::GetInstance().AcquireLayerTarget(glm::ivec2(cameraSize));
+		this->dirtyRegions.clear();
+		this->MarkRegionDirty({ cameraPosition, cameraPosition + cameraSize });
+
+		for (auto& button : this->buttonElements)
+			button.second.renderedToLayer = false;
+	}
+
+	// Without a layer (e.g. when the null device backend is selected) the elements are rendered directly
+	if (!this->retained || !this->layer)
+	{
+		for (const auto& button : this->buttonElements)
+		{
+			button.second.Render();
+		}
+
+		return;
+	}
+
+	this->FindDirtyRegions();
+	if (!this->dirtyRegions.empty())
+		this->RedrawDirtyRegions();
+
+	Renderer::GetInstance().RenderLayer(*this->viewportCamera, *this->layer, cameraPosition + (cameraSize / 2.0f), cameraSize);
+}
+
+void UserInterface::MarkRegionDirty(glm::vec4 region)
+{
+	// Keep merging the region with the regions it overlaps, as once merged it may overlap regions it didn't before
+	for (size_t regionIndex = 0; regionIndex < this->dirtyRegions.size();)
+	{
+		const glm::vec4& dirtyRegion = this->dirtyRegions[regionIndex];
+		if (region.x <= dirtyRegion.z && region.z >= dirtyRegion.x && region.y <= dirtyRegion.w && region.w >= dirtyRegion.y)
+		{
+			region = { glm::min(region.x, dirtyRegion.x), glm::min(region.y, dirtyRegion.y), glm::max(region.z, dirtyRegion.z), 
+				glm::max(region.w, dirtyRegion.w) };
+
+			this->dirtyRegions[regionIndex] = this->dirtyRegions.back();
+			this->dirtyRegions.pop_back();
+			regionIndex = 0;
+		}
+		else
+			regionIndex++;
+	}
+
+	this->dirtyRegions.emplace_back(region);
+}
+
+void UserInterface::FindDirtyRegions()
+{
+	for (auto& button : this->buttonElements)
+	{
+		Button& element = button.second;
+		const ButtonVisuals visuals = element.GetVisuals();
+		if (element.renderedToLayer && visuals == element.renderedVisuals)
+			continue;
+
+		// Both where the element was rendered and where it is now need redrawing, in case it has moved or shrunk
+		const glm::vec4 bounds = element.GetBounds();
+		if (element.renderedToLayer)
+			this->MarkRegionDirty(element.renderedBounds);
+
+		this->MarkRegionDirty(bounds);
+
+		element.renderedVisuals = visuals;
+		element.renderedBounds = bounds;
+		element.renderedToLayer = true;
+	}
+}
+
+void UserInterface::RedrawDirtyRegions()
+{
+	Renderer& renderer = Renderer::GetInstance();
+	renderer.SetExternalRenderTarget(this->layer);
+	renderer.SetRenderTarget(RenderTarget::EXTERNAL_FRAMEBUFFER);
+
+	for (const glm::vec4& region : this->dirtyRegions)
+	{
+		renderer.SetClipRegion(*this->viewportCamera, { region.x, region.y }, { region.z - region.x, region.w - region.y });
+		renderer.Clear(glm::vec4(0.0f));
+
+		// Redraw every element overlapping the region in their usual order, so they overlap each other as they normally would
+		for (const auto& button : this->buttonElements)
+		{
+			const glm::vec4 bounds = button.second.GetBounds();
+			if (bounds.x < region.z && bounds.z > region.x && bounds.y < region.w && bounds.w > region.y)
+				button.second.Render();
+		}
+	}
+
+	this->dirtyRegions.clear();
+
+	// Go back to rendering the rest of the scene
+	renderer.SetClipRegion(*this->viewportCamera, glm::vec2(0.0f), glm::vec2(0.0f));
+	renderer.SetExternalRenderTarget(PooledRenderTargetPtr());
+	renderer.SetRenderTarget(RenderTarget::SCENE_FRAMEBUFFER);
+}
+
 Button* UserInterface::GetButtonElement(const std::string_view& id)
 {
 	for (auto& button : this->buttonElements)
@@ -54,6 +310,11 @@ Button* UserInterface::GetButtonElement(const std::string_view& id)
 	return nullptr;
 }
 
+bool UserInterface::IsRetained() const
+{
+	return this->retained;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 UserInterfaceManager::UserInterfaceManager() :
@@ -81,11 +342,17 @@ void UserInterfaceManager::SetActiveUI(const std::string_view& id)
 	{
 		if (userInterface.first == id)
 		{
+			if (this->activeUserInterface && this->activeUserInterface != &userInterface.second)
+				this->activeUserInterface->ResetInteraction();
+
 			this->activeUserInterface = &userInterface.second;
 			return;
 		}
 	}
 
+	if (this->activeUserInterface)
+		this->activeUserInterface->ResetInteraction();
+
 	this->activeUserInterface = nullptr;
 }
 
@@ -2,30 +2,83 @@
 #define USER_INTERFACE_H
 
 #include <graphics/orthogonal_camera.h>
+#include <graphics/render_target_pool.h>
 #include <interface/button.h>
 
+#include <deque>
 #include <vector>
 #include <string>
 #include <string_view>
 
+namespace InterfaceGlobals
+{
+	constexpr uint32_t hitGridSize = 8; // The number of hit testing grid cells along each axis of the viewport
+}
+
 class UserInterface
 {
 	using ButtonElement = std::pair<std::string, Button>;
 	friend class UserInterfaceManager;
 private:
 	const OrthogonalCamera* viewportCamera;
-	std::vector<ButtonElement> buttonElements;
+	std::deque<ButtonElement> buttonElements; // A deque so the buttons never move, as tweens and callers hold pointers to them
+
+	// Hit testing, the elements overlapping each cell of a grid over the viewport are stored contiguously, those of a cell being
+	// hitCellElements[hitCellStarts[cell]] up to hitCellElements[hitCellStarts[cell + 1]]
+	std::vector<uint32_t> hitCellStarts, hitCellElements;
+	std::vector<uint32_t> hitCellFill; // Scratch space for filling in the cells, kept so rebuilding the grid doesn't allocate
+	glm::vec2 hitGridOrigin; // The viewport camera position the grid was built at, the grid covers the viewport from there
+	Button* hoveredButton, *pressedButton;
+	bool layoutChanged;
+
+	// Retained mode, the elements are cached in the layer and only redrawn where they've changed
+	PooledRenderTargetPtr layer;
+	std::vector<glm::vec4> dirtyRegions; // The minimum x, minimum y, maximum x and maximum y of each region to redraw
+	bool retained;
 private:
 	UserInterface(const OrthogonalCamera& camera);
 
-	// Updates all elements in the user interface object.
+	// Sends the elements their hover, press and release events. Nothing is done unless the cursor moved, the left mouse button was 
+	// pressed or released, or the layout of the elements changed during this step.
 	void UpdateInterface(const double& deltaTime);
 
+	// Rebuilds the hit testing grid from the hit bounds of the elements.
+	void RebuildHitGrid();
+
+	// Returns the topmost button whose hit bounds contain the position given (relative to the viewport camera, as the cursor position 
+	// is), or nullptr if there isn't one.
+	Button* FindButtonAt(const glm::vec2& position);
+
+	// Sends the hovered button its leave event and forgets about any press in progress, for when the user interface stops being
+	// active.
+	void ResetInteraction();
+
 	// Renders all elements in the user interface object.
-	void RenderInterface() const;
+	// In retained mode the elements which changed since the last render are redrawn into the layer, then the layer is rendered.
+	void RenderInterface();
+
+	// Adds the region given to the regions to redraw, merging it with any regions it overlaps.
+	void MarkRegionDirty(glm::vec4 region);
+
+	// Marks the regions covered by every element whose look has changed since it was last rendered into the layer as dirty, both 
+	// where the element was and where it is now.
+	void FindDirtyRegions();
+
+	// Clears the dirty regions of the layer and redraws the elements overlapping them.
+	void RedrawDirtyRegions();
 public:
 	~UserInterface() = default;
 
+	// Only moved into the user interface manager as it's created, before any elements point back at it
+	UserInterface(UserInterface&& temp) = default;
+
+	// Notifies the user interface that the hit bounds of an element have changed, so hit testing is redone during the next step.
+	void MarkLayoutChanged();
+
+	// Enables or disables retained mode. In retained mode the elements are rendered into a cached layer which is redrawn only where
+	// the elements change, rather than every element being redrawn every frame.
+	void SetRetainedMode(bool enable);
+
 	// Adds new button element to the user interface object.
 	void AddButtonElement(const std::string_view& id, const std::string_view& text, const glm::vec4& textColor, const uint32_t& fontSize,
 		const glm::vec2& pos, const glm::vec2& size, const glm::vec4& buttonColor, HoverReactionType type,
@@ -34,6 +87,9 @@ public:
 	// Returns the button element with the corresponding ID given.
 	// Note that if no button element matching the ID is found, then nullptr is returned.
 	Button* GetButtonElement(const std::string_view& id);
+
+	// Returns TRUE if the user interface is in retained mode, else FALSE is returned.
+	bool IsRetained() const;
 };
 
 class UserInterfaceManager
@@ -41,7 +97,7 @@ class UserInterfaceManager
 	using UIObject = std::pair<std::string, UserInterface>;
 	friend class GameStateSystem;
 private:
-	std::vector<UIObject> userInterfaceObjects;
+	std::deque<UIObject> userInterfaceObjects; // A deque so the active user interface pointer stays valid as more are created
 	UserInterface* activeUserInterface;
 private:
 	UserInterfaceManager();
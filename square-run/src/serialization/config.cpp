@@ -18,7 +18,11 @@ namespace Serialization
 					{ "height", 900 },
 					{ "fullscreen", false },
 					{ "resizable", false },
-					{ "vsync", false }
+					{ "vsync", false },
+					{ "adaptiveVsync", true },
+					{ "maxFramesInFlight", 1 },
+					{ "backgroundFrameRate", 10 },
+					{ "pauseAudioInBackground", true }
 				}
 			},
 			{ "graphics",
@@ -28,6 +32,11 @@ namespace Serialization
 					{ "gamma", 2.2f },
 					{ "textQuality", 100 }
 				}
+			},
+			{ "audio",
+				{
+					{ "streamBufferMilliseconds", 500 }
+				}
 			}
 		};
 
@@ -35,4 +44,35 @@ namespace Serialization
 		std::ofstream configFile(directory + "config.json", std::ios::trunc);
 		configFile << std::setw(4) << jsonObject;
 	}
+
+	nlohmann::json LoadConfigFile()
+	{
+		// Make sure that the game data directory exists
+		std::string directory = Util::GetGameRequisitesDirectory() + "data/";
+		if (!Util::IsExistingDirectory(directory))
+			LogSystem::GetInstance().OutputLog("Could not find the game's data directory", Severity::FATAL);
+
+		// Open the json file and load the contents
+		std::ifstream jsonFile(directory + "config.json");
+		if (jsonFile.fail())
+			LogSystem::GetInstance().OutputLog("Couldn't open the game config file", Severity::FATAL);
+
+		std::string jsonData, fileLine;
+		while (std::getline(jsonFile, fileLine))
+			jsonData += fileLine;
+
+		nlohmann::json loadedJSON;
+
+		try
+		{
+			// Parse the loaded json data
+			loadedJSON = nlohmann::json::parse(jsonData, nullptr, true, true);
+		}
+		catch (nlohmann::json::exception& exception) // Catch potential json exceptions thrown
+		{
+			LogSystem::GetInstance().OutputLog(exception.what(), Severity::FATAL);
+		}
+
+		return loadedJSON;
+	}
 }
\ No newline at end of file
@@ -13,8 +13,16 @@ namespace Serialization
 	// Generates a new default config file.
 	extern void GenerateConfigFile();
 
+	// Returns the parsed contents of the config file.
+	extern nlohmann::json LoadConfigFile();
+
 	// Returns the specified json element's value from the config file.
 	template<typename Ty> Ty GetConfigElement(const std::string_view& elementGroupKey, const std::string_view& elementKey);
+
+	// Returns the specified json element's value from the config file, or the default value given if the config file doesn't have 
+	// the element (e.g. it was generated before the element was added).
+	template<typename Ty> Ty GetConfigElement(const std::string_view& elementGroupKey, const std::string_view& elementKey, 
+		const Ty& defaultValue);
 }
 
 #include <serialization/config.inl>
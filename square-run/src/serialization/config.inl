@@ -2,29 +2,43 @@
 
 template<typename Ty> Ty Serialization::GetConfigElement(const std::string_view& elementGroupKey, const std::string_view& elementKey)
 {
-	// Make sure that the game data directory exists
-	std::string directory = Util::GetGameRequisitesDirectory() + "data/";
-	if (!Util::IsExistingDirectory(directory))
-		LogSystem::GetInstance().OutputLog("Could not find the game's data directory", Severity::FATAL);
+	const nlohmann::json loadedJSON = Serialization::LoadConfigFile();
+	Ty elementData; // This will hold the retrieved json element value
+
+	try
+	{
+		// Retrieve and return the requested json element
+		elementData = loadedJSON.at(elementGroupKey.data()).at(elementKey.data()).get<Ty>();
+	}
+	catch (nlohmann::json::exception& exception) // Catch potential json exceptions thrown
+	{
+		LogSystem::GetInstance().OutputLog(exception.what(), Severity::FATAL);
+	}
 
-	// Open the json file and load the contents
-	std::ifstream jsonFile(directory + "config.json");
-	if (jsonFile.fail())
-		LogSystem::GetInstance().OutputLog("Couldn't open the game config file", Severity::FATAL);
+	return elementData;
+}
 
-	std::string jsonData, fileLine;
-	while (std::getline(jsonFile, fileLine))
-		jsonData += fileLine;
+template<typename Ty> Ty Serialization::GetConfigElement(const std::string_view& elementGroupKey, const std::string_view& elementKey, 
+	const Ty& defaultValue)
+{
+	const nlohmann::json loadedJSON = Serialization::LoadConfigFile();
 
-	Ty elementData; // This will hold the retrieved json element value
+	// Fall back to the default value if the element is missing, so config files written by older versions of the game still load
+	const auto groupIterator = loadedJSON.find(elementGroupKey.data());
+	if (groupIterator == loadedJSON.end() || !groupIterator->contains(elementKey.data()))
+	{
+		LogSystem::GetInstance().OutputLog("The config file has no \"" + std::string(elementGroupKey) + "." + std::string(elementKey) + 
+			"\" element, using the default value", Severity::WARNING);
+
+		return defaultValue;
+	}
+
+	Ty elementData = defaultValue; // This will hold the retrieved json element value
 
 	try
 	{
-		// Parse the loaded json data
-		const nlohmann::json loadedJSON = nlohmann::json::parse(jsonData, nullptr, true, true);
-
 		// Retrieve and return the requested json element
-		elementData = loadedJSON.at(elementGroupKey.data()).at(elementKey.data()).get<Ty>();
+		elementData = groupIterator->at(elementKey.data()).get<Ty>();
 	}
 	catch (nlohmann::json::exception& exception) // Catch potential json exceptions thrown
 	{
@@ -21,35 +21,62 @@ void IntroScreen::Init()
 	this->timeWhenTextAppear = 0.0f;
 	this->introComplete = false;
 	this->abortIntro = false;
-
-	this->effectPositions[0] = { -700, 1080 + (700 / this->camera.GetAspectRatio()) };
-	this->effectPositions[1] = { 2620 - (100 / this->camera.GetAspectRatio()), -100 - (700 / this->camera.GetAspectRatio())};
-	this->effectPositions[2] = { 2620 + (100 / this->camera.GetAspectRatio()), 100 - (700 / this->camera.GetAspectRatio()) };
+	this->PlayIntroSequence();
+
+	this->CreateEffects();
+	EntitySystems::AddMotionSystems(this->effectSystems);
+
+	// The sparkles drift up and fade out around the logo once it has moved into view
+	ParticleEmitterDesc sparkleDesc;
+	sparkleDesc.capacity = 512;
+	sparkleDesc.emitRate = 150.0f;
+	sparkleDesc.spawnRadius = 400.0f;
+	sparkleDesc.minLifetime = 1.0f;
+	sparkleDesc.maxLifetime = 2.5f;
+	sparkleDesc.minVelocity = { -40.0f, -160.0f };
+	sparkleDesc.maxVelocity = { 40.0f, -40.0f };
+	sparkleDesc.acceleration = { 0.0f, 30.0f };
+	sparkleDesc.startColor = { 255, 255, 200, 255 };
+	sparkleDesc.endColor = { 255, 220, 120, 0 };
+	sparkleDesc.startSize = 40.0f;
+	sparkleDesc.endSize = 8.0f;
+
+	// The particles live as long as the intro screen, so they're allocated from the state arena
+	this->logoSparkles = Memory::CreateParticleEmitter(sparkleDesc, &this->stateArena);
+	this->logoSparkles->SetEmitting(false);
 
 	// Load the game state textures and font
-	this->borderTexture = Memory::LoadTextureFromFile("state_border.png");
-	this->logoTexture = Memory::LoadTextureFromFile("logo.png", false);
-	this->textFont = Memory::LoadFontFromFile("fff_forwa.ttf");
+	this->borderTexture = ResourceRegistry::GetInstance().LoadTexture("state_border.png");
+	this->logoTexture = ResourceRegistry::GetInstance().LoadTexture("logo.png", false);
+	this->sparkleTexture = ResourceRegistry::GetInstance().LoadTexture("sparkle.png");
+	this->textFont = ResourceRegistry::GetInstance().LoadFont("fff_forwa.ttf");
 	
 	// Load and play the intro music 
-	this->introMusic = AudioSystem::GetInstance().LoadAudioFromFile("title_screen.wav");
+	this->introMusic = AudioSystem::GetInstance().LoadAudioFromFile("title_screen.wav", AudioLoadMode::STREAM);
 	this->introMusic->Play();
 	this->introMusic->SetVolume(1.0f);
 }
 
 void IntroScreen::Destroy() 
 {
-	this->borderTexture.reset();
-	this->logoTexture.reset();
+	TweenSystem::GetInstance().Kill(this->introSequence);
+
+	ResourceRegistry::GetInstance().GetTextures().Destroy(this->borderTexture);
+	ResourceRegistry::GetInstance().GetTextures().Destroy(this->logoTexture);
+	ResourceRegistry::GetInstance().GetTextures().Destroy(this->sparkleTexture);
+	ResourceRegistry::GetInstance().GetFonts().Destroy(this->textFont);
+
+	this->logoSparkles.reset();
 	this->introMusic.reset();
-	this->textFont.reset();
+
+	this->effects.Clear();
+	this->effectSystems.Clear();
 }
 
 void IntroScreen::Update(const double& deltaTime)
 {
-	this->UpdateIntroSequence(deltaTime);
 	this->UpdateEffects(deltaTime);
-	this->CheckUserContinue(deltaTime);
+	this->CheckUserContinue();
 	this->CheckAutoContinue();
 }
 
@@ -64,14 +91,15 @@ void IntroScreen::Render() const
 		this->camera.GetSize(), 0, { 0, 255, 0, this->borderOpacity });
 
 	// Render the effects
-	Renderer::GetInstance().RenderRect(this->camera, { 255, 0, 0, 255 }, this->effectPositions[0], { 700, 50 }, 150);
-	Renderer::GetInstance().RenderRect(this->camera, { 0, 0, 255, 255 }, this->effectPositions[1], { 700, 50 }, 150);
-	Renderer::GetInstance().RenderRect(this->camera, { 255, 255, 0, 255 }, this->effectPositions[2], { 700, 50 }, 150);
+	Renderer::GetInstance().RenderRectEntities(this->camera, this->effects);
 
 	// Render the game logo
 	Renderer::GetInstance().RenderTexturedRect(this->camera, this->logoTexture, this->logoPosition, this->logoSize, 0, 
 		{ 255, 225, 255, 255 });
 
+	// Render the logo sparkles
+	Renderer::GetInstance().RenderParticles(this->camera, *this->logoSparkles, this->sparkleTexture);
+
 	// Render play text
 	const glm::vec2 textSize = Renderer::GetInstance().GetTextSize(this->textFont, 100, "Press Enter To Play");
 	Renderer::GetInstance().RenderText(this->camera, this->textFont, 100, "Press Enter To Play", { 255, 255, 255, this->textOpacity },
@@ -86,56 +114,49 @@ IntroScreen* IntroScreen::GetGameState()
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void IntroScreen::UpdateIntroSequence(const double& deltaTime)
+void IntroScreen::PlayIntroSequence()
+{
+	// The background stretches to fill the screen and changes to a green color, then the border fades in and the logo moves into 
+	// view. The durations keep the speeds (in units per second) each part of the intro has always been animated at.
+	const glm::vec2 screenSize = this->camera.GetSize();
+
+	this->introSequence = TweenSystem::GetInstance().Play(TweenSequence()
+		.Append(&this->bkgSize.x, screenSize.x, (screenSize.x - this->bkgSize.x) / 1500.0f)
+		.Append(&this->bkgSize.y, screenSize.y, (screenSize.y - this->bkgSize.y) / 4500.0f)
+		.Append(&this->bkgColor.r, 0.0f, this->bkgColor.r / 200.0f)
+		.Join(&this->bkgColor.b, 0.0f, this->bkgColor.b / 200.0f)
+		.Append(&this->borderOpacity, 255.0f, (255.0f - this->borderOpacity) / 400.0f)
+		.Append(&this->logoPosition.y, 450.0f, (450.0f - this->logoPosition.y) / 750.0f)
+		.SetCompleteCallback([this]() { this->introComplete = true; }), this->tweenGroup);
+}
+
+void IntroScreen::CreateEffects()
 {
-	// Animate the background stretching to fill the screen
-	if (this->bkgSize.x < this->camera.GetSize().x)
+	const float aspectRatio = this->camera.GetAspectRatio();
+
+	// The effects slide diagonally across the screen, every effect restarts once the first one has slid past the right of the screen
+	const glm::vec2 startPositions[3] = { { -700, 1080 + (700 / aspectRatio) }, 
+		{ 2620 - (100 / aspectRatio), -100 - (700 / aspectRatio) }, { 2620 + (100 / aspectRatio), 100 - (700 / aspectRatio) } };
+
+	const glm::vec4 colors[3] = { { 255, 0, 0, 255 }, { 0, 0, 255, 255 }, { 255, 255, 0, 255 } };
+	const glm::vec2 velocities[3] = { { 700, -700 / aspectRatio }, { -700, 700 / aspectRatio }, { -700, 700 / aspectRatio } };
+	const float loopDuration = ((2620 - (100 / aspectRatio)) - startPositions[0].x) / 700;
+
+	for (int effectIndex = 0; effectIndex < 3; effectIndex++)
 	{
-		this->bkgSize.x = std::min(this->bkgSize.x + (1500 * (float)deltaTime), this->camera.GetSize().x);
-	}
-	else
-	{
-		if (this->bkgSize.y < this->camera.GetSize().y)
-		{
-			this->bkgSize.y = std::min(this->bkgSize.y + (4500 * (float)deltaTime), this->camera.GetSize().y);
-		}
-		else
-		{
-			// Make the background change to a green color
-			if (this->bkgColor.r > 0 && this->bkgColor.b > 0)
-			{
-				this->bkgColor.r = std::min(this->bkgColor.r - (200 * (float)deltaTime), this->bkgColor.r);
-				this->bkgColor.b = std::min(this->bkgColor.b - (200 * (float)deltaTime), this->bkgColor.b);
-			}
-			else
-			{
-				// Make the border gradually opaque (visible)
-				if (this->borderOpacity < 255.0f)
-				{
-					this->borderOpacity = std::min(this->borderOpacity + (400 * (float)deltaTime), 255.0f);
-				}
-				else
-				{
-					// Move the logo of the game into view
-					if (this->logoPosition.y < 450.0f)
-					{
-						this->logoPosition.y = std::min(this->logoPosition.y + (750 * (float)deltaTime), 450.0f);
-					}
-					else
-					{
-						this->introComplete = true;
-					}
-				}
-			}
-		}
+		const Entity effect = this->effects.CreateEntity();
+		this->effects.AddComponent(effect, TransformComponent{ startPositions[effectIndex], { 700, 50 }, 150 });
+		this->effects.AddComponent(effect, VelocityComponent{ velocities[effectIndex] });
+		this->effects.AddComponent(effect, LoopingMotionComponent{ startPositions[effectIndex], loopDuration });
+		this->effects.AddComponent(effect, RectRenderComponent{ colors[effectIndex] });
 	}
 }
 
 void IntroScreen::UpdateEffects(const double& deltaTime)
 {
 	// Update logo bop effect
-	this->logoSize.x = 850 + (float)(std::sin(Util::GetSecondsSinceEpoch() * 10.0f) * 100.0f);
-	this->logoSize.y = 425 + (float)(std::cos(Util::GetSecondsSinceEpoch() * 10.0f) * 100.0f);
+	this->logoSize.x = 850 + (float)(std::sin(Util::GetSimulationTime() * 10.0f) * 100.0f);
+	this->logoSize.y = 425 + (float)(std::cos(Util::GetSimulationTime() * 10.0f) * 100.0f);
 
 
 	if (this->introComplete)
@@ -143,52 +164,36 @@ void IntroScreen::UpdateEffects(const double& deltaTime)
 		// Update the play text opacity
 		if (this->timeWhenTextAppear == 0.0f)
 		{
-			this->timeWhenTextAppear = (float)Util::GetSecondsSinceEpoch();
+			this->timeWhenTextAppear = (float)Util::GetSimulationTime();
 		}
 		else
 		{
-			this->textOpacity = (float)std::abs(std::sin((Util::GetSecondsSinceEpoch() - this->timeWhenTextAppear) * 2.0f)) * 255.0f;
+			this->textOpacity = (float)std::abs(std::sin((Util::GetSimulationTime() - this->timeWhenTextAppear) * 2.0f)) * 255.0f;
 		}
 
-		// Update the effect positions
-		this->effectPositions[0].x += 700 * (float)deltaTime;
-		this->effectPositions[0].y -= (700 / this->camera.GetAspectRatio()) * (float)deltaTime;
-
-		this->effectPositions[1].x -= 700 * (float)deltaTime;
-		this->effectPositions[1].y += (700 / this->camera.GetAspectRatio()) * (float)deltaTime;
-
-		this->effectPositions[2].x -= 700 * (float)deltaTime;
-		this->effectPositions[2].y += (700 / this->camera.GetAspectRatio()) * (float)deltaTime;
+		// Update the effect positions, they're restarted once offscreen
+		this->effectSystems.Run(this->effects, deltaTime);
 
-		// Restart effect positions if they are offscreen
-		if (this->effectPositions[0].x >= 2620 - (100 / this->camera.GetAspectRatio()))
+		if (!this->logoSparkles->IsEmitting())
 		{
-			this->effectPositions[0] = { -700, 1080 + (700 / this->camera.GetAspectRatio()) };
-			this->effectPositions[1] = { 2620 - (100 / this->camera.GetAspectRatio()), -100 - (700 / this->camera.GetAspectRatio()) };
-			this->effectPositions[2] = { 2620 + (100 / this->camera.GetAspectRatio()), 100 - (700 / this->camera.GetAspectRatio()) };
+			this->logoSparkles->SetPosition(this->logoPosition);
+			this->logoSparkles->SetEmitting(true);
 		}
 	}
+
+	this->logoSparkles->Update((float)deltaTime);
 }
 
-void IntroScreen::CheckUserContinue(const double& deltaTime)
+void IntroScreen::CheckUserContinue()
 {
-	// Once the intro is complete and the user presses ENTER, 
-	// then abort the into prematurely and continue onto the next game state
+	// Once the intro is complete and the user presses ENTER, then abort the intro prematurely by fading out the intro music, and
+	// continue onto the next game state once the fade has ended
 	if (this->introComplete && !this->abortIntro)
 	{
 		if (InputSystem::GetInstance().WasKeyPressed(KeyCode::KEY_ENTER))
 		{
 			this->abortIntro = true;
-		}
-	}
-
-	if (this->abortIntro)
-	{
-		this->introMusic->SetVolume(this->introMusic->GetVolume() - (2.0f * (float)deltaTime));
-
-		if (this->introMusic->GetVolume() == 0.0f)
-		{
-			this->SwitchState(MainMenu::GetGameState());
+			this->introMusic->FadeVolume(0.0f, 0.5f, [this]() { this->SwitchState(MainMenu::GetGameState()); });
 		}
 	}
 }
@@ -200,11 +205,11 @@ void IntroScreen::CheckAutoContinue()
 	{
 		if (this->timeWhenIntroMusicEnd == 0.0f)
 		{
-			this->timeWhenIntroMusicEnd = (float)Util::GetSecondsSinceEpoch();
+			this->timeWhenIntroMusicEnd = (float)Util::GetSimulationTime();
 		}
 		else
 		{
-			if (Util::GetSecondsSinceEpoch() - this->timeWhenIntroMusicEnd >= 5.0f)
+			if (Util::GetSimulationTime() - this->timeWhenIntroMusicEnd >= 5.0f)
 			{
 				this->SwitchState(MainMenu::GetGameState());
 			}
@@ -3,29 +3,41 @@
 
 #include <core/game_state.h>
 #include <core/audio_system.h>
+#include <core/entity_systems.h>
+#include <core/particle_system.h>
+#include <core/tween_system.h>
 
 class IntroScreen : public GameState
 {
 private:
 	// Assets
-	TextureBufferPtr borderTexture, logoTexture;
+	TextureHandle borderTexture, logoTexture, sparkleTexture;
 	GlobalAudioPtr introMusic;
-	FontPtr textFont;
+	FontHandle textFont;
+
+	// Effects
+	EntityRegistry effects;
+	SystemScheduler effectSystems;
+	ParticleEmitterPtr logoSparkles;
+	TweenHandle introSequence;
 
 	// Logic variables
-	glm::vec2 bkgSize, logoPosition, logoSize, effectPositions[3];
+	glm::vec2 bkgSize, logoPosition, logoSize;
 	glm::vec4 bkgColor;
 	float borderOpacity, textOpacity, timeWhenIntroMusicEnd, timeWhenTextAppear;
 	bool introComplete, abortIntro;
 private:
-	// Updates the game intro animation sequence.
-	void UpdateIntroSequence(const double& deltaTime);
+	// Starts playing the game intro animation sequence.
+	void PlayIntroSequence();
+
+	// Creates the entities of the sliding effects shown once the intro animation ends.
+	void CreateEffects();
 
 	// Updates the effects in the intro menu screen.
 	void UpdateEffects(const double& deltaTime);
 
-	// Checks if the user pressed enter, if so then the intro music (if playing) is ended and the main menu game state is started.
-	void CheckUserContinue(const double& deltaTime);
+	// Checks if the user pressed enter, if so then the intro music (if playing) is faded out and the main menu game state is started.
+	void CheckUserContinue();
 
 	// Automatically switches to the main menu game state if nothing is pressed for a few seconds after the intro animation ends.
 	void CheckAutoContinue();
@@ -5,17 +5,18 @@
 
 void MainMenu::Init()
 {
-	// Initialize logic variables
+	// Initialize logic variables, the border fades in over the first couple of seconds
 	this->borderOpacity = 0.0f;
+	this->borderFade = TweenSystem::GetInstance().To(&this->borderOpacity, 255.0f, 255.0f / 150.0f, EasingType::LINEAR, 
+		this->tweenGroup);
 
-	this->effectPositions[0] = { -750, (this->camera.GetSize().y / 2.0f) - 10  };
-	this->effectPositions[1] = { 2670, (this->camera.GetSize().y / 2.0f) + 10 };
-	this->effectPositions[2] = { (this->camera.GetSize().x / 2.0f) - 10, -750 };
-	this->effectPositions[3] = { (this->camera.GetSize().x / 2.0f) + 10, 1830 };
+	this->CreateEffects();
+	EntitySystems::AddMotionSystems(this->effectSystems);
 
 	// Initialize main menu user interface
 	UserInterfaceManager::GetInstance().CreateNewUI("main-menu", this->camera);
 	UserInterfaceManager::GetInstance().SetActiveUI("main-menu");
+	UserInterfaceManager::GetInstance().GetUIObject("main-menu")->SetRetainedMode(true);
 
 	UserInterfaceManager::GetInstance().GetUIObject("main-menu")->AddButtonElement("play", "PLAY", { 255, 255, 255, 255 }, 115, 
 		{ 485, 275 }, { 805, 400 }, { 255, 0, 0, 255 }, HoverReactionType::HIGHLIGHT_ENLARGE_ALL_ROUND);
@@ -29,11 +30,14 @@ void MainMenu::Init()
 	UserInterfaceManager::GetInstance().GetUIObject("main-menu")->GetButtonElement("exit")->SetClickEventCallback([=]() { this->PopState(); });
 
 	// Load the game state textures
-	this->borderTexture = Memory::LoadTextureFromFile("state_border.png");
-
-	// Load and play the intro music 
-	this->menuMusic = AudioSystem::GetInstance().LoadAudioFromFile("main_menu.wav");
-	this->menuMusic->Play();
+	this->borderTexture = ResourceRegistry::GetInstance().LoadTexture("state_border.png");
+
+	// Load and play the menu music, the first part of the track plays once as an intro and the rest of it loops seamlessly
+	this->menuMusic = AudioSystem::GetInstance().LoadAudioFromFile("main_menu.wav", AudioLoadMode::STREAM);
+	const uint32_t musicSampleRate = this->menuMusic->GetSampleRate();
+	this->menuMusic->SetLoopRegion((uint32_t)(MainMenuGlobals::musicLoopStart * musicSampleRate / 1000),
+		(uint32_t)(MainMenuGlobals::musicLoopEnd * musicSampleRate / 1000));
+	this->menuMusic->Play(true);
 	this->menuMusic->SetVolume(1.0f);
 
 	// Set background color
@@ -42,25 +46,18 @@ void MainMenu::Init()
 
 void MainMenu::Destroy()
 {
-	this->borderTexture.reset();
+	TweenSystem::GetInstance().Kill(this->borderFade);
+
+	ResourceRegistry::GetInstance().GetTextures().Destroy(this->borderTexture);
 	this->menuMusic.reset();
+
+	this->effects.Clear();
+	this->effectSystems.Clear();
 }
 
 void MainMenu::Update(const double& deltaTime)
 {
-	this->UpdateEffects(deltaTime);
-
-	// Update the opacity of the border
-	if (this->borderOpacity < 255.0f)
-	{
-		this->borderOpacity = std::min(this->borderOpacity + (150 * (float)deltaTime), 255.0f);
-	}
-
-	// Change music play position to create a perfect music track loop
-	if (this->menuMusic->GetPlayPosition() >= 56855)
-	{
-		this->menuMusic->SetPlayPosition(28876);
-	}
+	this->effectSystems.Run(this->effects, deltaTime);
 }
 
 void MainMenu::Render() const
@@ -70,10 +67,7 @@ void MainMenu::Render() const
 		this->camera.GetSize(), 0, { 0, 255, 0, this->borderOpacity });
 
 	// Render the effects
-	Renderer::GetInstance().RenderRect(this->camera, { 255, 0, 0, 255 }, this->effectPositions[0], { 1000, 10 });
-	Renderer::GetInstance().RenderRect(this->camera, { 255, 0, 255, 255 }, this->effectPositions[2], { 10, 1000 });
-	Renderer::GetInstance().RenderRect(this->camera, { 0, 0, 255, 255 }, this->effectPositions[1], { 1000, 10 });
-	Renderer::GetInstance().RenderRect(this->camera, { 255, 255, 0, 255 }, this->effectPositions[3], { 10, 1000 });
+	Renderer::GetInstance().RenderRectEntities(this->camera, this->effects);
 }
 
 MainMenu* MainMenu::GetGameState()
@@ -84,27 +78,39 @@ MainMenu* MainMenu::GetGameState()
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void MainMenu::UpdateEffects(const double& deltaTime)
+void MainMenu::CreateEffects()
 {
-	// Update the effect positions
-	float effectSpeed = 200.0f;
+	// A pair of horizontal and a pair of vertical effects slide across the screen in opposite directions, each pair restarting once 
+	// its first effect has slid offscreen. The effects are created in the order they're rendered in.
+	const float effectSpeed = 200.0f;
+	const float horizontalLoopDuration = (2670 + 750) / effectSpeed, verticalLoopDuration = (1830 + 750) / effectSpeed;
 
-	this->effectPositions[0].x += effectSpeed * (float)deltaTime;
-	this->effectPositions[1].x -= effectSpeed * (float)deltaTime;
-	this->effectPositions[2].y += effectSpeed * (float)deltaTime;
-	this->effectPositions[3].y -= effectSpeed * (float)deltaTime;
-
-	// Restart effect positions if they are offscreen
-	if (this->effectPositions[0].x >= 2670)
+	struct EffectDesc
 	{
-		this->effectPositions[0] = { -750, (this->camera.GetSize().y / 2.0f) - 10 };
-		this->effectPositions[1] = { 2670, (this->camera.GetSize().y / 2.0f) + 10 };
-	}
+		glm::vec2 startPosition, size, velocity;
+		glm::vec4 color;
+		float loopDuration;
+	};
 
-	if (this->effectPositions[2].y >= 1830)
+	const EffectDesc effectDescs[4] =
+	{
+		{ { -750, (this->camera.GetSize().y / 2.0f) - 10 }, { 1000, 10 }, { effectSpeed, 0 }, { 255, 0, 0, 255 }, 
+			horizontalLoopDuration },
+		{ { (this->camera.GetSize().x / 2.0f) - 10, -750 }, { 10, 1000 }, { 0, effectSpeed }, { 255, 0, 255, 255 }, 
+			verticalLoopDuration },
+		{ { 2670, (this->camera.GetSize().y / 2.0f) + 10 }, { 1000, 10 }, { -effectSpeed, 0 }, { 0, 0, 255, 255 }, 
+			horizontalLoopDuration },
+		{ { (this->camera.GetSize().x / 2.0f) + 10, 1830 }, { 10, 1000 }, { 0, -effectSpeed }, { 255, 255, 0, 255 }, 
+			verticalLoopDuration }
+	};
+
+	for (const EffectDesc& effectDesc : effectDescs)
 	{
-		this->effectPositions[2] = { (this->camera.GetSize().x / 2.0f) - 10, -750 };
-		this->effectPositions[3] = { (this->camera.GetSize().x / 2.0f) + 10, 1830 };
+		const Entity effect = this->effects.CreateEntity();
+		this->effects.AddComponent(effect, TransformComponent{ effectDesc.startPosition, effectDesc.size });
+		this->effects.AddComponent(effect, VelocityComponent{ effectDesc.velocity });
+		this->effects.AddComponent(effect, LoopingMotionComponent{ effectDesc.startPosition, effectDesc.loopDuration });
+		this->effects.AddComponent(effect, RectRenderComponent{ effectDesc.color });
 	}
 }
 
@@ -3,19 +3,33 @@
 
 #include <core/game_state.h>
 #include <core/audio_system.h>
+#include <core/entity_systems.h>
+#include <core/tween_system.h>
+
+namespace MainMenuGlobals
+{
+	// The loop body of the menu music, in milliseconds into the track
+	constexpr uint64_t musicLoopStart = 28876;
+	constexpr uint64_t musicLoopEnd = 56855;
+}
 
 class MainMenu : public GameState
 {
 private:
-	void UpdateEffects(const double& deltaTime);
+	// Creates the entities of the effects sliding across the screen.
+	void CreateEffects();
 private:
 	// Assets
-	TextureBufferPtr borderTexture;
+	TextureHandle borderTexture;
 	GlobalAudioPtr menuMusic;
 
+	// Effects
+	EntityRegistry effects;
+	SystemScheduler effectSystems;
+
 	// Logic variables
-	glm::vec2 effectPositions[4];
 	float borderOpacity;
+	TweenHandle borderFade;
 protected:
 	void Init() override;
 	void Destroy() override;
@@ -0,0 +1,82 @@
+#include <util/allocation_counter.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _COUNT_ALLOCATIONS
+namespace AllocationCounter
+{
+	static std::atomic<uint64_t> allocationCount = 0;
+	static std::atomic<uint64_t> allocatedBytes = 0;
+
+	// Allocates the memory requested and counts the allocation.
+	static void* CountedAllocate(size_t size)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+		void* memory = std::malloc(size ? size : 1);
+		if (!memory)
+			throw std::bad_alloc();
+
+		return memory;
+	}
+}
+
+void* operator new(size_t size)
+{
+	return AllocationCounter::CountedAllocate(size);
+}
+
+void* operator new[](size_t size)
+{
+	return AllocationCounter::CountedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+namespace Util
+{
+	uint64_t GetAllocationCount()
+	{
+		return AllocationCounter::allocationCount.load(std::memory_order_relaxed);
+	}
+
+	uint64_t GetAllocatedBytes()
+	{
+		return AllocationCounter::allocatedBytes.load(std::memory_order_relaxed);
+	}
+}
+#else
+namespace Util
+{
+	uint64_t GetAllocationCount()
+	{
+		return 0;
+	}
+
+	uint64_t GetAllocatedBytes()
+	{
+		return 0;
+	}
+}
+#endif
@@ -0,0 +1,17 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// The global operator new is only replaced to count the allocations in builds defining _COUNT_ALLOCATIONS (the benchmarks and the 
+// debug builds of the game), so the shipping game doesn't pay for counting. In other builds the counts are always zero.
+namespace Util
+{
+	// Returns the total number of heap allocations made through the global operator new since the program started.
+	extern uint64_t GetAllocationCount();
+
+	// Returns the total number of bytes requested through the global operator new since the program started.
+	extern uint64_t GetAllocatedBytes();
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include <util/linear_allocator.h>
+#include <util/logging_system.h>
+
+#include <algorithm>
+
+LinearArena::LinearArena(const std::string_view& name, size_t blockSize) :
+	name(name), blockSize(blockSize), currentBlock(0), blockOffset(0), bytesUsed(0), highWaterMark(0), reportedHighWaterMark(0)
+{}
+
+void LinearArena::AddBlock(size_t minSize)
+{
+	const size_t newBlockSize = std::max(this->blockSize, minSize);
+	this->blocks.push_back({ std::make_unique<uint8_t[]>(newBlockSize), newBlockSize });
+
+	this->currentBlock = this->blocks.size() - 1;
+	this->blockOffset = 0;
+}
+
+void LinearArena::ReportHighWaterMark()
+{
+#ifdef _DEBUG
+	if (this->highWaterMark > this->reportedHighWaterMark)
+	{
+		LogSystem::GetInstance().OutputLog("The " + this->name + " arena's high-water mark rose to " +
+			std::to_string(this->highWaterMark) + " bytes (capacity of " + std::to_string(this->GetCapacity()) + " bytes)",
+			Severity::INFO);
+
+		this->reportedHighWaterMark = this->highWaterMark;
+	}
+#endif
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment)
+{
+	while (this->currentBlock < this->blocks.size())
+	{
+		const ArenaBlock& block = this->blocks[this->currentBlock];
+		const uintptr_t blockAddress = reinterpret_cast<uintptr_t>(block.memory.get());
+		const uintptr_t alignedAddress = (blockAddress + this->blockOffset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+		const size_t newOffset = (size_t)(alignedAddress - blockAddress) + size;
+
+		if (newOffset <= block.size)
+		{
+			this->bytesUsed += newOffset - this->blockOffset;
+			this->highWaterMark = std::max(this->highWaterMark, this->bytesUsed);
+			this->blockOffset = newOffset;
+
+			return reinterpret_cast<void*>(alignedAddress);
+		}
+
+		// The rest of this block is too small, so move onto the next block (if any)
+		this->currentBlock++;
+		this->blockOffset = 0;
+	}
+
+	// Every block is full, the new block is given room for the worst case alignment padding
+	this->AddBlock(size + alignment);
+	return this->Allocate(size, alignment);
+}
+
+void LinearArena::Reset()
+{
+	this->ReportHighWaterMark();
+
+	// Merge the blocks into one, so the arena doesn't have to chain blocks on the next time it's this busy
+	if (this->blocks.size() > 1)
+	{
+		const size_t totalCapacity = this->GetCapacity();
+		this->blocks.clear();
+		this->AddBlock(totalCapacity);
+	}
+
+	this->currentBlock = 0;
+	this->blockOffset = 0;
+	this->bytesUsed = 0;
+}
+
+void LinearArena::Release()
+{
+	this->ReportHighWaterMark();
+
+	this->blocks.clear();
+	this->currentBlock = 0;
+	this->blockOffset = 0;
+	this->bytesUsed = 0;
+}
+
+size_t LinearArena::GetBytesUsed() const
+{
+	return this->bytesUsed;
+}
+
+size_t LinearArena::GetHighWaterMark() const
+{
+	return this->highWaterMark;
+}
+
+size_t LinearArena::GetCapacity() const
+{
+	size_t capacity = 0;
+	for (const ArenaBlock& block : this->blocks)
+		capacity += block.size;
+
+	return capacity;
+}
+
+const std::string& LinearArena::GetName() const
+{
+	return this->name;
+}
+
+LinearArena& LinearArena::GetFrameArena()
+{
+	static LinearArena instance("frame", ArenaGlobals::frameArenaBlockSize);
+	return instance;
+}
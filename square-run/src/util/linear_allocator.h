@@ -0,0 +1,106 @@
+#ifndef LINEAR_ALLOCATOR_H
+#define LINEAR_ALLOCATOR_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace ArenaGlobals
+{
+	constexpr size_t frameArenaBlockSize = 1024 * 1024;
+	constexpr size_t stateArenaBlockSize = 64 * 1024;
+}
+
+// A bump allocator, allocating is just moving an offset along a block of memory and nothing is freed until the arena is reset.
+// If a block runs out of space another block is chained on, then once the arena is reset the blocks are merged into a single block
+// big enough for all of them, so an arena which is reset regularly stops touching the heap once it has seen its busiest use.
+// Note that destructors of objects allocated in the arena are never called, so only trivially destructible data should be placed in
+// it (or containers using the ArenaAllocator adapter, which are destroyed as normal before the arena is reset).
+class LinearArena
+{
+private:
+	struct ArenaBlock
+	{
+		std::unique_ptr<uint8_t[]> memory;
+		size_t size;
+	};
+private:
+	std::string name;
+	std::vector<ArenaBlock> blocks;
+	size_t blockSize, currentBlock, blockOffset;
+	size_t bytesUsed, highWaterMark, reportedHighWaterMark;
+private:
+	// Chains on a new block, big enough to hold at least the number of bytes given.
+	void AddBlock(size_t minSize);
+
+	// Outputs the high-water mark to the log if it has risen since it was last output (debug builds only).
+	void ReportHighWaterMark();
+public:
+	LinearArena(const std::string_view& name, size_t blockSize);
+	~LinearArena() = default;
+
+	LinearArena(const LinearArena& other) = delete;
+	LinearArena& operator=(const LinearArena& other) = delete;
+
+	// Returns a pointer to the number of bytes given, aligned to the alignment given (which must be a power of two).
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	// Returns a pointer to an uninitialized array of the number of elements given.
+	template<typename Ty> Ty* AllocateArray(size_t count);
+
+	// Marks every allocation as free, the memory is kept for reuse. Anything allocated before the reset must no longer be used.
+	void Reset();
+
+	// Frees every allocation and the memory backing them.
+	void Release();
+
+	// Returns the number of bytes allocated since the arena was last reset.
+	size_t GetBytesUsed() const;
+
+	// Returns the most bytes the arena has held at once.
+	size_t GetHighWaterMark() const;
+
+	// Returns the number of bytes the arena's blocks can hold in total.
+	size_t GetCapacity() const;
+
+	// Returns the name the arena is reported with.
+	const std::string& GetName() const;
+
+	// Returns the arena for data which only lives until the end of the current frame, it's reset once the frame has been rendered.
+	static LinearArena& GetFrameArena();
+};
+
+// An STL compatible allocator which allocates from the arena given, deallocating does nothing as the memory is reclaimed once the
+// arena is reset. The arena must outlive every container using it.
+template<typename Ty> class ArenaAllocator
+{
+	template<typename OtherTy> friend class ArenaAllocator;
+private:
+	LinearArena* arena;
+public:
+	using value_type = Ty;
+
+	ArenaAllocator(LinearArena& arena) noexcept;
+	template<typename OtherTy> ArenaAllocator(const ArenaAllocator<OtherTy>& other) noexcept;
+
+	// Returns a pointer to an uninitialized array of the number of elements given.
+	Ty* allocate(size_t count);
+
+	// Does nothing, the memory is reclaimed once the arena is reset.
+	void deallocate(Ty* memory, size_t count) noexcept;
+
+	// Returns the arena the allocator allocates from.
+	LinearArena& GetArena() const;
+
+	template<typename OtherTy> bool operator==(const ArenaAllocator<OtherTy>& other) const noexcept;
+	template<typename OtherTy> bool operator!=(const ArenaAllocator<OtherTy>& other) const noexcept;
+};
+
+template<typename Ty> using ArenaVector = std::vector<Ty, ArenaAllocator<Ty>>;
+
+#include <util/linear_allocator.inl>
+
+#endif
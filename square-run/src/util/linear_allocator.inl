@@ -0,0 +1,36 @@
+#include <util/linear_allocator.h>
+
+template<typename Ty> Ty* LinearArena::AllocateArray(size_t count)
+{
+	return static_cast<Ty*>(this->Allocate(count * sizeof(Ty), alignof(Ty)));
+}
+
+template<typename Ty> ArenaAllocator<Ty>::ArenaAllocator(LinearArena& arena) noexcept :
+	arena(&arena)
+{}
+
+template<typename Ty> template<typename OtherTy> ArenaAllocator<Ty>::ArenaAllocator(const ArenaAllocator<OtherTy>& other) noexcept :
+	arena(other.arena)
+{}
+
+template<typename Ty> Ty* ArenaAllocator<Ty>::allocate(size_t count)
+{
+	return this->arena->template AllocateArray<Ty>(count);
+}
+
+template<typename Ty> void ArenaAllocator<Ty>::deallocate(Ty* memory, size_t count) noexcept {}
+
+template<typename Ty> LinearArena& ArenaAllocator<Ty>::GetArena() const
+{
+	return *this->arena;
+}
+
+template<typename Ty> template<typename OtherTy> bool ArenaAllocator<Ty>::operator==(const ArenaAllocator<OtherTy>& other) const noexcept
+{
+	return this->arena == other.arena;
+}
+
+template<typename Ty> template<typename OtherTy> bool ArenaAllocator<Ty>::operator!=(const ArenaAllocator<OtherTy>& other) const noexcept
+{
+	return this->arena != other.arena;
+}
@@ -0,0 +1,61 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <memory>
+
+// A lock-free single producer, single consumer ring buffer.
+// Only one thread may push into the ring buffer and only one (possibly other) thread may pop from it.
+template<typename Ty> class RingBuffer
+{
+private:
+	std::unique_ptr<Ty[]> slots;
+	size_t capacity, indexMask;
+
+	// The read and write indices are kept on separate cache lines so the producer and consumer don't contend over them
+	alignas(64) std::atomic<size_t> readIndex;
+	alignas(64) std::atomic<size_t> writeIndex;
+public:
+	// Note that the capacity given is rounded up to the nearest power of two.
+	RingBuffer(size_t capacity);
+	~RingBuffer() = default;
+
+	RingBuffer(const RingBuffer& other) = delete;
+	RingBuffer& operator=(const RingBuffer& other) = delete;
+
+	// Pushes the value given into the ring buffer (producer only).
+	// Returns TRUE if successful, else FALSE is returned if the ring buffer is full.
+	bool Push(const Ty& value);
+
+	// Pushes as many of the values given into the ring buffer as there is space for (producer only).
+	// Returns the number of values that were pushed.
+	size_t PushRange(const Ty* values, size_t count);
+
+	// Pops the oldest value in the ring buffer into the value given (consumer only).
+	// Returns TRUE if successful, else FALSE is returned if the ring buffer is empty.
+	bool Pop(Ty& value);
+
+	// Pops as many values, up to the count given, as are available into the values array given (consumer only).
+	// Returns the number of values that were popped.
+	size_t PopRange(Ty* values, size_t count);
+
+	// Returns a pointer to the oldest value in the ring buffer without popping it (consumer only).
+	// Note that if the ring buffer is empty, then nullptr is returned.
+	const Ty* Peek() const;
+
+	// Discards every value currently in the ring buffer (consumer only).
+	void Clear();
+
+	// Returns the number of values currently in the ring buffer.
+	size_t GetSize() const;
+
+	// Returns the maximum number of values the ring buffer can hold.
+	const size_t& GetCapacity() const;
+
+	// Returns TRUE if the ring buffer is empty, else FALSE is returned.
+	bool IsEmpty() const;
+};
+
+#include <util/ring_buffer.inl>
+
+#endif
@@ -0,0 +1,88 @@
+#include <util/ring_buffer.h>
+
+template<typename Ty> RingBuffer<Ty>::RingBuffer(size_t capacity) :
+	capacity(1), readIndex(0), writeIndex(0)
+{
+	while (this->capacity < capacity)
+		this->capacity <<= 1;
+
+	this->indexMask = this->capacity - 1;
+	this->slots = std::make_unique<Ty[]>(this->capacity);
+}
+
+template<typename Ty> bool RingBuffer<Ty>::Push(const Ty& value)
+{
+	const size_t writePosition = this->writeIndex.load(std::memory_order_relaxed);
+	if (writePosition - this->readIndex.load(std::memory_order_acquire) >= this->capacity)
+		return false;
+
+	this->slots[writePosition & this->indexMask] = value;
+	this->writeIndex.store(writePosition + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename Ty> size_t RingBuffer<Ty>::PushRange(const Ty* values, size_t count)
+{
+	const size_t writePosition = this->writeIndex.load(std::memory_order_relaxed);
+	const size_t freeSlots = this->capacity - (writePosition - this->readIndex.load(std::memory_order_acquire));
+	const size_t numPushed = count < freeSlots ? count : freeSlots;
+
+	for (size_t valueIndex = 0; valueIndex < numPushed; valueIndex++)
+		this->slots[(writePosition + valueIndex) & this->indexMask] = values[valueIndex];
+
+	this->writeIndex.store(writePosition + numPushed, std::memory_order_release);
+	return numPushed;
+}
+
+template<typename Ty> bool RingBuffer<Ty>::Pop(Ty& value)
+{
+	const size_t readPosition = this->readIndex.load(std::memory_order_relaxed);
+	if (readPosition == this->writeIndex.load(std::memory_order_acquire))
+		return false;
+
+	value = this->slots[readPosition & this->indexMask];
+	this->readIndex.store(readPosition + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename Ty> size_t RingBuffer<Ty>::PopRange(Ty* values, size_t count)
+{
+	const size_t readPosition = this->readIndex.load(std::memory_order_relaxed);
+	const size_t usedSlots = this->writeIndex.load(std::memory_order_acquire) - readPosition;
+	const size_t numPopped = count < usedSlots ? count : usedSlots;
+
+	for (size_t valueIndex = 0; valueIndex < numPopped; valueIndex++)
+		values[valueIndex] = this->slots[(readPosition + valueIndex) & this->indexMask];
+
+	this->readIndex.store(readPosition + numPopped, std::memory_order_release);
+	return numPopped;
+}
+
+template<typename Ty> const Ty* RingBuffer<Ty>::Peek() const
+{
+	const size_t readPosition = this->readIndex.load(std::memory_order_relaxed);
+	if (readPosition == this->writeIndex.load(std::memory_order_acquire))
+		return nullptr;
+
+	return &this->slots[readPosition & this->indexMask];
+}
+
+template<typename Ty> void RingBuffer<Ty>::Clear()
+{
+	this->readIndex.store(this->writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+template<typename Ty> size_t RingBuffer<Ty>::GetSize() const
+{
+	return this->writeIndex.load(std::memory_order_acquire) - this->readIndex.load(std::memory_order_acquire);
+}
+
+template<typename Ty> const size_t& RingBuffer<Ty>::GetCapacity() const
+{
+	return this->capacity;
+}
+
+template<typename Ty> bool RingBuffer<Ty>::IsEmpty() const
+{
+	return this->GetSize() == 0;
+}
@@ -0,0 +1,35 @@
+#include <util/simd.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace Util
+{
+	SimdLevel GetSupportedSimdLevel()
+	{
+		// SSE2 is always available on x86-64, AVX2 needs to be supported by both the CPU and the operating system (which has to save 
+		// the AVX registers on context switches)
+		static const SimdLevel supportedLevel = []()
+		{
+#if defined(_MSC_VER)
+			int cpuInfo[4] = {};
+			__cpuid(cpuInfo, 0);
+			if (cpuInfo[0] < 7)
+				return SimdLevel::SSE2;
+
+			__cpuid(cpuInfo, 1);
+			const bool osSavesAVX = (cpuInfo[2] & (1 << 27)) && (cpuInfo[2] & (1 << 28)) && ((_xgetbv(0) & 0x6) == 0x6);
+
+			__cpuidex(cpuInfo, 7, 0);
+			return osSavesAVX && (cpuInfo[1] & (1 << 5)) ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#endif
+		}();
+
+		return supportedLevel;
+	}
+}
@@ -0,0 +1,26 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+// The instruction sets the SIMD kernels can be ran with.
+enum class SimdLevel
+{
+	SCALAR,
+	SSE2,
+	AVX2
+};
+
+// Functions compiled with AVX2 instructions must be marked with this, so that the rest of the program can still run on CPUs without 
+// AVX2 (MSVC allows the intrinsics in any function, other compilers need the target attribute).
+#if defined(_MSC_VER)
+#define AVX2_FUNCTION
+#else
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+
+namespace Util
+{
+	// Returns the highest instruction set supported by the CPU (and operating system).
+	extern SimdLevel GetSupportedSimdLevel();
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include <util/thread_pool.h>
+
+ThreadPool::ThreadPool(size_t numThreads) :
+	numActiveJobs(0), stopping(false)
+{
+	for (size_t threadIndex = 0; threadIndex < numThreads; threadIndex++)
+		this->workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->jobMutex);
+		this->stopping = true;
+	}
+
+	this->jobAvailable.notify_all();
+	for (std::thread& worker : this->workers)
+		worker.join();
+}
+
+void ThreadPool::WorkerLoop()
+{
+	while (true)
+	{
+		std::function<void()> job;
+
+		{
+			std::unique_lock<std::mutex> lock(this->jobMutex);
+			this->jobAvailable.wait(lock, [this]() { return this->stopping || !this->jobs.empty(); });
+
+			// The queued jobs are still ran when stopping, so nothing waiting on them is left hanging
+			if (this->jobs.empty())
+				return;
+
+			job = std::move(this->jobs.front());
+			this->jobs.pop_front();
+		}
+
+		job();
+
+		{
+			std::lock_guard<std::mutex> lock(this->jobMutex);
+			this->numActiveJobs--;
+		}
+
+		this->jobsFinished.notify_all();
+	}
+}
+
+void ThreadPool::Submit(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(this->jobMutex);
+		this->jobs.emplace_back(std::move(job));
+		this->numActiveJobs++;
+	}
+
+	this->jobAvailable.notify_one();
+}
+
+void ThreadPool::WaitIdle()
+{
+	std::unique_lock<std::mutex> lock(this->jobMutex);
+	this->jobsFinished.wait(lock, [this]() { return this->numActiveJobs == 0; });
+}
+
+size_t ThreadPool::GetNumThreads() const
+{
+	return this->workers.size();
+}
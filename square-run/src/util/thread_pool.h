@@ -0,0 +1,42 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <functional>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <deque>
+
+// A fixed set of worker threads which run the jobs submitted to them in the order they were submitted.
+class ThreadPool
+{
+private:
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> jobs;
+	size_t numActiveJobs; // The number of jobs either queued or being ran
+
+	std::mutex jobMutex;
+	std::condition_variable jobAvailable, jobsFinished;
+	bool stopping;
+private:
+	// The loop ran by every worker thread, running jobs until the thread pool is destroyed.
+	void WorkerLoop();
+public:
+	ThreadPool(size_t numThreads);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool& other) = delete;
+	ThreadPool& operator=(const ThreadPool& other) = delete;
+
+	// Queues the job given to be ran by the next free worker thread.
+	void Submit(std::function<void()> job);
+
+	// Blocks until every job submitted so far has finished running.
+	void WaitIdle();
+
+	// Returns the number of worker threads.
+	size_t GetNumThreads() const;
+};
+
+#endif
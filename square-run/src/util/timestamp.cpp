@@ -6,6 +6,8 @@
 
 namespace Util
 {
+	static double simulationTime = 0.0;
+
 	std::string GetTimestampStr()
 	{
 		// Get the current date and time data
@@ -59,4 +61,14 @@ namespace Util
 	{
 		return glfwGetTime();
 	}
+
+	void SetSimulationTime(double seconds)
+	{
+		simulationTime = seconds;
+	}
+
+	double GetSimulationTime()
+	{
+		return simulationTime;
+	}
 }
\ No newline at end of file
@@ -11,6 +11,13 @@ namespace Util
 	// Returns the elapsed time, in seconds, since the GLFW initialization.
 	// It uses the highest-resolution monotonic time source on each operating system.
 	extern double GetSecondsSinceEpoch();
+
+	// Sets the time, in seconds, of the simulation step currently being updated.
+	extern void SetSimulationTime(double seconds);
+
+	// Returns the time, in seconds, sampled at the start of the simulation step currently being updated.
+	// Unlike GetSecondsSinceEpoch(), this stays constant for the whole step and is read back from the replay file when replaying.
+	extern double GetSimulationTime();
 }
 
 #endif